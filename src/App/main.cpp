@@ -14,6 +14,7 @@
 #include <QList>
 #include <QDebug>
 #include <QHostAddress>
+#include <QStringList>
 
 // Globe icnlude.
 #include <Core/mainwindow.hpp>
@@ -27,6 +28,8 @@
 #include <Core/utils.hpp>
 #include <Core/sounds.hpp>
 
+#include <Scheme/status_evaluator.hpp>
+
 // Como include.
 #include <Como/Source>
 
@@ -39,12 +42,25 @@ int main( int argc, char ** argv )
 	qRegisterMetaType< Como::Source > ( "Como::Source" );
 
 	QString cfgFile;
+	QString headlessDir;
+	QStringList schemes;
+	int interval = 5;
 
 	try{
 		Args::CmdLine cmd;
 
 		cmd.addArgWithFlagAndName( QChar( 'c' ), QLatin1String( "conf-file" ),
 			true, false, QLatin1String( "Configuration file of the application." ) )
+			.addArgWithFlagAndName( QChar( 'o' ), QLatin1String( "headless" ),
+				true, false, QLatin1String( "Run without windows, write PNG "
+					"snapshots of the schemes and status.json into the "
+					"given directory." ) )
+			.addArgWithFlagAndName( QChar( 's' ), QLatin1String( "schemes" ),
+				true, false, QLatin1String( "Comma separated scheme files "
+					"to evaluate in headless mode." ) )
+			.addArgWithFlagAndName( QChar( 'i' ), QLatin1String( "interval" ),
+				true, false, QLatin1String( "Interval of the snapshots in "
+					"seconds in headless mode, 5 by default." ) )
 			.addHelp( true, argv[ 0 ], QLatin1String( "Tool for viewieng sources "
 				"in the remote applications" ) );
 
@@ -52,6 +68,36 @@ int main( int argc, char ** argv )
 
 		if( cmd.isDefined( QLatin1String( "-c" ) ) )
 			cfgFile = cmd.value( QLatin1String( "-c" ) );
+
+		if( cmd.isDefined( QLatin1String( "-o" ) ) )
+		{
+			headlessDir = cmd.value( QLatin1String( "-o" ) );
+
+			if( cmd.isDefined( QLatin1String( "-s" ) ) )
+				schemes = cmd.value( QLatin1String( "-s" ) ).split(
+					QLatin1Char( ',' ), Qt::SkipEmptyParts );
+
+			if( schemes.isEmpty() )
+			{
+				qDebug() << "No schemes to evaluate in headless mode.\n";
+
+				return 1;
+			}
+
+			if( cmd.isDefined( QLatin1String( "-i" ) ) )
+			{
+				bool ok = false;
+
+				interval = cmd.value( QLatin1String( "-i" ) ).toInt( &ok );
+
+				if( !ok || interval <= 0 )
+				{
+					qDebug() << "Wrong interval of the snapshots.\n";
+
+					return 1;
+				}
+			}
+		}
 	}
 	catch( const Args::HelpHasBeenPrintedException & )
 	{
@@ -64,6 +110,10 @@ int main( int argc, char ** argv )
 		return 1;
 	}
 
+	// Headless mode doesn't need display.
+	if( !headlessDir.isEmpty() && qEnvironmentVariableIsEmpty( "QT_QPA_PLATFORM" ) )
+		qputenv( "QT_QPA_PLATFORM", "offscreen" );
+
 	QApplication app( argc, argv );
 
 	QIcon appIcon( ":/img/globe_256x256.png" );
@@ -95,6 +145,23 @@ int main( int argc, char ** argv )
 
 	Globe::MainWindow::instance().init( toolWindows );
 
+	if( !headlessDir.isEmpty() )
+	{
+		auto * evaluator = new Globe::Scheme::StatusEvaluator( headlessDir,
+			interval * 1000, &app );
+
+		Globe::Configuration::instance().setHeadless();
+
+		QTimer::singleShot( 0, evaluator, [evaluator, schemes] () {
+			Globe::Configuration::instance().loadHeadlessConfiguration();
+
+			for( const auto & fileName : std::as_const( schemes ) )
+				evaluator->addScheme( fileName );
+		} );
+
+		return app.exec();
+	}
+
 	QObject::connect( &app, &QApplication::commitDataRequest,
 		&Globe::MainWindow::instance(),
 		&Globe::MainWindow::sessionFinished );
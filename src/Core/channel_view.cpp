@@ -5,7 +5,6 @@
 */
 
 // Qt include.
-#include <QSortFilterProxyModel>
 #include <QHeaderView>
 #include <QPainter>
 #include <QAction>
@@ -19,6 +18,7 @@
 // Globe include.
 #include <Core/channel_view.hpp>
 #include <Core/channel_view_window_model.hpp>
+#include <Core/channel_view_sort_model.hpp>
 #include <Core/color_for_level.hpp>
 #include <Core/properties_manager.hpp>
 #include <Core/word_wrap_delegate.hpp>
@@ -51,7 +51,7 @@ public:
 	//! Model.
 	ChannelViewWindowModel * m_model;
 	//! Sort model.
-	QSortFilterProxyModel * m_sortModel;
+	ChannelViewSortModel * m_sortModel;
 	//! Copy action.
 	QAction * m_copyAction;
 	//! Select all action.
@@ -96,7 +96,7 @@ ChannelView::model()
 	return d->m_model;
 }
 
-QSortFilterProxyModel *
+ChannelViewSortModel *
 ChannelView::sortModel()
 {
 	return d->m_sortModel;
@@ -360,11 +360,7 @@ ChannelView::init()
 
 	d->m_model = new ChannelViewWindowModel( this );
 
-	d->m_sortModel = new QSortFilterProxyModel( this );
-	d->m_sortModel->setSourceModel( d->m_model );
-
-	connect( d->m_model, &ChannelViewWindowModel::priorityChanged,
-		this, &ChannelView::priorityChanged );
+	d->m_sortModel = new ChannelViewSortModel( d->m_model, this );
 
 	setModel( d->m_sortModel );
 
@@ -386,11 +382,4 @@ ChannelView::sectionResized( int section, int, int )
 		emit d->m_delegate->sizeHintChanged( d->m_model->index( i, section ) );
 }
 
-void
-ChannelView::priorityChanged()
-{
-	if( d->m_sortModel->sortColumn() == priorityColumn )
-		d->m_sortModel->invalidate();
-}
-
 } /* namespace Globe */
@@ -11,14 +11,11 @@
 #include <QTreeView>
 #include <QScopedPointer>
 
-QT_BEGIN_NAMESPACE
-class QSortFilterProxyModel;
-QT_END_NAMESPACE
-
 
 namespace Globe {
 
 class ChannelViewWindowModel;
+class ChannelViewSortModel;
 
 
 //
@@ -42,7 +39,7 @@ public:
 	ChannelViewWindowModel * model();
 
 	//! \return Sort model.
-	QSortFilterProxyModel * sortModel();
+	ChannelViewSortModel * sortModel();
 
 	//! \return Action for copy.
 	QAction * copyAction() const;
@@ -77,8 +74,6 @@ private slots:
 	void promoteProperties();
 	//! Section resized.
 	void sectionResized( int section, int, int );
-	//! Priority of the source has been changed.
-	void priorityChanged();
 
 protected:
 	void drawRow( QPainter * painter, const QStyleOptionViewItem & option,
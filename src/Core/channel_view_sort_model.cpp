@@ -0,0 +1,864 @@
+
+/*
+	SPDX-FileCopyrightText: 2012-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// Globe include.
+#include <Core/channel_view_sort_model.hpp>
+#include <Core/channel_view_window_model.hpp>
+
+// Qt include.
+#include <QVector>
+#include <QBitArray>
+#include <QDateTime>
+#include <QVariant>
+
+// C++ include.
+#include <algorithm>
+#include <utility>
+
+
+namespace Globe {
+
+//! \return Result of comparison of the values of the sources.
+static inline int compareValues( const QVariant & v1, const QVariant & v2 )
+{
+	const QPartialOrdering o = QVariant::compare( v1, v2 );
+
+	if( o == QPartialOrdering::Less )
+		return -1;
+	else if( o == QPartialOrdering::Greater )
+		return 1;
+	else if( o == QPartialOrdering::Equivalent )
+		return 0;
+	else
+		return QString::compare( v1.toString(), v2.toString() );
+}
+
+
+//
+// ChannelViewSortModelPrivate
+//
+
+class ChannelViewSortModelPrivate {
+public:
+	explicit ChannelViewSortModelPrivate( ChannelViewWindowModel * model )
+		:	m_model( model )
+		,	m_root( -1 )
+		,	m_column( -1 )
+		,	m_order( Qt::AscendingOrder )
+		,	m_levelFilter( None )
+		,	m_seed( 2463534242u )
+	{
+	}
+
+	//! \return Size of the subtree.
+	int size( int node ) const
+	{
+		return ( node < 0 ? 0 : m_size.at( node ) );
+	}
+
+	//! Update size of the node and parents of the children.
+	void update( int node );
+	//! Merge trees. \return Root.
+	int merge( int left, int right );
+	//! Split tree, first \a count nodes go to \a left.
+	void split( int node, int count, int & left, int & right );
+	//! \return Position of the node in the tree.
+	int rank( int node ) const;
+	//! \return Node at the given position.
+	int at( int pos ) const;
+	//! Insert node at the given position.
+	void insertAt( int node, int pos );
+	//! Remove node from the tree.
+	void erase( int node );
+	//! \return Position where node should be inserted, node must not be
+	//! in the tree.
+	int lowerBound( int node ) const;
+	//! \return Is node between its neighbours?
+	bool isInPlace( int node ) const;
+
+	//! \return Comparison of the rows by sort column.
+	int compare( int row1, int row2 ) const;
+	//! \return Should \a row1 be placed before \a row2?
+	bool lessThan( int row1, int row2 ) const;
+	//! \return Does level of the row pass the level filter?
+	bool isLevelAccepted( int row ) const
+	{
+		return ( m_model->level( m_model->index( row, 0 ) ) <= m_levelFilter );
+	}
+	//! \return Does row match the filter?
+	bool isAccepted( int row ) const;
+
+	//! Resize nodes for the count of rows in the source model.
+	void resize( int count );
+	//! Build tree of all accepted rows. With the level filter only rows
+	//! from the index of the levels of the model are checked.
+	void rebuild();
+
+	//! Source model.
+	ChannelViewWindowModel * m_model;
+	//! Root of the tree.
+	int m_root;
+	//! Left children, node is the row of the source model.
+	QVector< int > m_left;
+	//! Right children.
+	QVector< int > m_right;
+	//! Parents.
+	QVector< int > m_parent;
+	//! Sizes of the subtrees.
+	QVector< int > m_size;
+	//! Priorities of the nodes.
+	QVector< quint32 > m_priority;
+	//! Accepted rows.
+	QBitArray m_accepted;
+	//! Changed rows waiting for repositioning.
+	QVector< int > m_changed;
+	//! Is row waiting for repositioning?
+	QBitArray m_isChanged;
+	//! Sort column.
+	int m_column;
+	//! Sort order.
+	Qt::SortOrder m_order;
+	//! Filter text.
+	QString m_filter;
+	//! Least severe level to show, None shows all rows.
+	Level m_levelFilter;
+	//! Seed of the priorities.
+	quint32 m_seed;
+}; // class ChannelViewSortModelPrivate
+
+void
+ChannelViewSortModelPrivate::update( int node )
+{
+	const int l = m_left.at( node );
+	const int r = m_right.at( node );
+
+	m_size[ node ] = 1 + size( l ) + size( r );
+
+	if( l >= 0 )
+		m_parent[ l ] = node;
+
+	if( r >= 0 )
+		m_parent[ r ] = node;
+}
+
+int
+ChannelViewSortModelPrivate::merge( int left, int right )
+{
+	if( left < 0 )
+		return right;
+
+	if( right < 0 )
+		return left;
+
+	if( m_priority.at( left ) > m_priority.at( right ) )
+	{
+		m_right[ left ] = merge( m_right.at( left ), right );
+		update( left );
+
+		return left;
+	}
+	else
+	{
+		m_left[ right ] = merge( left, m_left.at( right ) );
+		update( right );
+
+		return right;
+	}
+}
+
+void
+ChannelViewSortModelPrivate::split( int node, int count, int & left,
+	int & right )
+{
+	if( node < 0 )
+	{
+		left = right = -1;
+
+		return;
+	}
+
+	const int leftSize = size( m_left.at( node ) );
+
+	if( leftSize < count )
+	{
+		int l = -1;
+
+		split( m_right.at( node ), count - leftSize - 1, l, right );
+		m_right[ node ] = l;
+		update( node );
+
+		left = node;
+	}
+	else
+	{
+		int r = -1;
+
+		split( m_left.at( node ), count, left, r );
+		m_left[ node ] = r;
+		update( node );
+
+		right = node;
+	}
+}
+
+int
+ChannelViewSortModelPrivate::rank( int node ) const
+{
+	int pos = size( m_left.at( node ) );
+
+	for( int p = m_parent.at( node ); p >= 0; node = p, p = m_parent.at( p ) )
+	{
+		if( m_right.at( p ) == node )
+			pos += size( m_left.at( p ) ) + 1;
+	}
+
+	return pos;
+}
+
+int
+ChannelViewSortModelPrivate::at( int pos ) const
+{
+	int node = m_root;
+
+	while( node >= 0 )
+	{
+		const int leftSize = size( m_left.at( node ) );
+
+		if( pos < leftSize )
+			node = m_left.at( node );
+		else if( pos == leftSize )
+			return node;
+		else
+		{
+			pos -= leftSize + 1;
+			node = m_right.at( node );
+		}
+	}
+
+	return -1;
+}
+
+void
+ChannelViewSortModelPrivate::insertAt( int node, int pos )
+{
+	m_left[ node ] = -1;
+	m_right[ node ] = -1;
+	m_parent[ node ] = -1;
+	m_size[ node ] = 1;
+
+	int left = -1, right = -1;
+
+	split( m_root, pos, left, right );
+
+	m_root = merge( merge( left, node ), right );
+	m_parent[ m_root ] = -1;
+}
+
+void
+ChannelViewSortModelPrivate::erase( int node )
+{
+	int left = -1, middle = -1, right = -1;
+
+	split( m_root, rank( node ), left, right );
+	split( right, 1, middle, right );
+
+	m_root = merge( left, right );
+
+	if( m_root >= 0 )
+		m_parent[ m_root ] = -1;
+}
+
+int
+ChannelViewSortModelPrivate::lowerBound( int node ) const
+{
+	int pos = 0;
+	int n = m_root;
+
+	while( n >= 0 )
+	{
+		if( lessThan( node, n ) )
+			n = m_left.at( n );
+		else
+		{
+			pos += size( m_left.at( n ) ) + 1;
+			n = m_right.at( n );
+		}
+	}
+
+	return pos;
+}
+
+bool
+ChannelViewSortModelPrivate::isInPlace( int node ) const
+{
+	const int pos = rank( node );
+
+	if( pos > 0 && !lessThan( at( pos - 1 ), node ) )
+		return false;
+
+	if( pos + 1 < size( m_root ) && !lessThan( node, at( pos + 1 ) ) )
+		return false;
+
+	return true;
+}
+
+int
+ChannelViewSortModelPrivate::compare( int row1, int row2 ) const
+{
+	const QModelIndex i1 = m_model->index( row1, 0 );
+	const QModelIndex i2 = m_model->index( row2, 0 );
+
+	switch( m_column )
+	{
+		case priorityColumn :
+		{
+			const int p1 = m_model->priority( i1 );
+			const int p2 = m_model->priority( i2 );
+
+			return ( p1 < p2 ? -1 : ( p2 < p1 ? 1 : 0 ) );
+		}
+
+		case dateTimeColumn :
+		{
+			const QDateTime & t1 = m_model->source( i1 ).dateTime();
+			const QDateTime & t2 = m_model->source( i2 ).dateTime();
+
+			return ( t1 < t2 ? -1 : ( t2 < t1 ? 1 : 0 ) );
+		}
+
+		case sourceTypeNameColumn :
+			return QString::compare( m_model->source( i1 ).typeName(),
+				m_model->source( i2 ).typeName() );
+
+		case sourceNameColumn :
+			return QString::compare( m_model->source( i1 ).name(),
+				m_model->source( i2 ).name() );
+
+		case valueColumn :
+			return compareValues( m_model->source( i1 ).value(),
+				m_model->source( i2 ).value() );
+
+		default :
+			return 0;
+	}
+}
+
+bool
+ChannelViewSortModelPrivate::lessThan( int row1, int row2 ) const
+{
+	const int c = compare( row1, row2 );
+
+	// Equal rows keep order of the source model.
+	if( c != 0 )
+		return ( m_order == Qt::AscendingOrder ? c < 0 : c > 0 );
+	else
+		return ( row1 < row2 );
+}
+
+bool
+ChannelViewSortModelPrivate::isAccepted( int row ) const
+{
+	if( !isLevelAccepted( row ) )
+		return false;
+
+	if( m_filter.isEmpty() )
+		return true;
+
+	const Como::Source & s = m_model->source( m_model->index( row, 0 ) );
+
+	return ( s.name().contains( m_filter, Qt::CaseInsensitive ) ||
+		s.typeName().contains( m_filter, Qt::CaseInsensitive ) );
+}
+
+void
+ChannelViewSortModelPrivate::resize( int count )
+{
+	const int old = m_left.size();
+
+	m_left.resize( count );
+	m_right.resize( count );
+	m_parent.resize( count );
+	m_size.resize( count );
+	m_priority.resize( count );
+	m_accepted.resize( count );
+	m_isChanged.resize( count );
+
+	for( int i = old; i < count; ++i )
+	{
+		// xorshift32.
+		m_seed ^= m_seed << 13;
+		m_seed ^= m_seed >> 17;
+		m_seed ^= m_seed << 5;
+
+		m_priority[ i ] = m_seed;
+		m_accepted.clearBit( i );
+		m_isChanged.clearBit( i );
+	}
+}
+
+void
+ChannelViewSortModelPrivate::rebuild()
+{
+	const int count = m_model->rowCount();
+
+	m_root = -1;
+	m_changed.clear();
+
+	resize( count );
+
+	m_accepted.fill( false );
+	m_isChanged.fill( false );
+
+	QVector< int > rows;
+
+	if( m_levelFilter == None )
+	{
+		rows.reserve( count );
+
+		for( int row = 0; row < count; ++row )
+		{
+			if( isAccepted( row ) )
+				rows.append( row );
+		}
+	}
+	else
+	{
+		static const Level levels[] = { Critical, Error, Warning, Debug, Info };
+
+		for( const Level level : levels )
+		{
+			if( level > m_levelFilter )
+				break;
+
+			const QSet< int > levelRows = m_model->rowsWithLevel( level );
+
+			rows.reserve( rows.size() + levelRows.size() );
+
+			for( const int row : levelRows )
+			{
+				if( isAccepted( row ) )
+					rows.append( row );
+			}
+		}
+	}
+
+	std::sort( rows.begin(), rows.end(),
+		[this] ( int r1, int r2 ) { return lessThan( r1, r2 ); } );
+
+	for( const int row : std::as_const( rows ) )
+	{
+		m_left[ row ] = -1;
+		m_right[ row ] = -1;
+		m_parent[ row ] = -1;
+		m_size[ row ] = 1;
+		m_accepted.setBit( row );
+
+		m_root = merge( m_root, row );
+		m_parent[ m_root ] = -1;
+	}
+}
+
+
+//
+// ChannelViewSortModel
+//
+
+ChannelViewSortModel::ChannelViewSortModel( ChannelViewWindowModel * model,
+	QObject * parent )
+	:	QAbstractProxyModel( parent )
+	,	d( new ChannelViewSortModelPrivate( model ) )
+{
+	setSourceModel( model );
+
+	d->rebuild();
+
+	connect( model, &ChannelViewWindowModel::dataChanged,
+		this, &ChannelViewSortModel::sourceDataChanged );
+	connect( model, &ChannelViewWindowModel::changesFlushed,
+		this, &ChannelViewSortModel::applyChanges );
+	connect( model, &ChannelViewWindowModel::rowsInserted,
+		this, &ChannelViewSortModel::sourceRowsInserted );
+	connect( model, &ChannelViewWindowModel::rowsAboutToBeRemoved,
+		this, &ChannelViewSortModel::sourceAboutToBeReset );
+	connect( model, &ChannelViewWindowModel::rowsRemoved,
+		this, &ChannelViewSortModel::sourceReset );
+	connect( model, &ChannelViewWindowModel::modelAboutToBeReset,
+		this, &ChannelViewSortModel::sourceAboutToBeReset );
+	connect( model, &ChannelViewWindowModel::modelReset,
+		this, &ChannelViewSortModel::sourceReset );
+	connect( model, &ChannelViewWindowModel::layoutAboutToBeChanged,
+		this, &ChannelViewSortModel::sourceAboutToBeReset );
+	connect( model, &ChannelViewWindowModel::layoutChanged,
+		this, &ChannelViewSortModel::sourceReset );
+}
+
+ChannelViewSortModel::~ChannelViewSortModel()
+{
+}
+
+int
+ChannelViewSortModel::sortColumn() const
+{
+	return d->m_column;
+}
+
+Qt::SortOrder
+ChannelViewSortModel::sortOrder() const
+{
+	return d->m_order;
+}
+
+const QString &
+ChannelViewSortModel::filterText() const
+{
+	return d->m_filter;
+}
+
+Level
+ChannelViewSortModel::levelFilter() const
+{
+	return d->m_levelFilter;
+}
+
+QModelIndex
+ChannelViewSortModel::mapToSource( const QModelIndex & proxyIndex ) const
+{
+	if( !proxyIndex.isValid() )
+		return QModelIndex();
+
+	const int row = d->at( proxyIndex.row() );
+
+	if( row < 0 )
+		return QModelIndex();
+
+	return d->m_model->index( row, proxyIndex.column() );
+}
+
+QModelIndex
+ChannelViewSortModel::mapFromSource( const QModelIndex & sourceIndex ) const
+{
+	if( !sourceIndex.isValid() || sourceIndex.row() >= d->m_accepted.size() ||
+		!d->m_accepted.testBit( sourceIndex.row() ) )
+			return QModelIndex();
+
+	return createIndex( d->rank( sourceIndex.row() ), sourceIndex.column() );
+}
+
+QModelIndex
+ChannelViewSortModel::index( int row, int column,
+	const QModelIndex & parent ) const
+{
+	if( parent.isValid() || row < 0 || row >= rowCount() ||
+		column < 0 || column >= columnCount() )
+			return QModelIndex();
+
+	return createIndex( row, column );
+}
+
+QModelIndex
+ChannelViewSortModel::parent( const QModelIndex & child ) const
+{
+	Q_UNUSED( child )
+
+	return QModelIndex();
+}
+
+int
+ChannelViewSortModel::rowCount( const QModelIndex & parent ) const
+{
+	return ( parent.isValid() ? 0 : d->size( d->m_root ) );
+}
+
+int
+ChannelViewSortModel::columnCount( const QModelIndex & parent ) const
+{
+	return ( parent.isValid() ? 0 : d->m_model->columnCount() );
+}
+
+QVariant
+ChannelViewSortModel::headerData( int section, Qt::Orientation orientation,
+	int role ) const
+{
+	// Columns aren't mapped, so header doesn't depend on rows in the proxy.
+	if( orientation == Qt::Horizontal )
+		return d->m_model->headerData( section, orientation, role );
+	else
+		return QAbstractProxyModel::headerData( section, orientation, role );
+}
+
+void
+ChannelViewSortModel::sort( int column, Qt::SortOrder order )
+{
+	emit layoutAboutToBeChanged( {}, QAbstractItemModel::VerticalSortHint );
+
+	const QModelIndexList sourceIndexes = persistentSourceIndexes();
+
+	d->m_column = column;
+	d->m_order = order;
+
+	d->rebuild();
+
+	restorePersistentIndexes( sourceIndexes );
+
+	emit layoutChanged( {}, QAbstractItemModel::VerticalSortHint );
+}
+
+void
+ChannelViewSortModel::setFilterText( const QString & text )
+{
+	if( text == d->m_filter )
+		return;
+
+	// Longer text can only reject accepted rows, shorter one can only
+	// accept rejected rows.
+	const bool narrowing = text.contains( d->m_filter, Qt::CaseInsensitive );
+	const bool widening = d->m_filter.contains( text, Qt::CaseInsensitive );
+
+	// Binary search needs keys of all rows in the tree to be actual.
+	applyChanges();
+
+	beginResetModel();
+
+	d->m_filter = text;
+
+	const int count = d->m_accepted.size();
+
+	for( int row = 0; row < count; ++row )
+	{
+		const bool was = d->m_accepted.testBit( row );
+
+		if( ( was && widening ) || ( !was && narrowing ) )
+			continue;
+
+		const bool accepted = d->isAccepted( row );
+
+		if( was && !accepted )
+		{
+			d->erase( row );
+			d->m_accepted.clearBit( row );
+		}
+		else if( !was && accepted )
+		{
+			d->insertAt( row, d->lowerBound( row ) );
+			d->m_accepted.setBit( row );
+		}
+	}
+
+	endResetModel();
+}
+
+void
+ChannelViewSortModel::setLevelFilter( Level level )
+{
+	if( level == d->m_levelFilter )
+		return;
+
+	beginResetModel();
+
+	d->m_levelFilter = level;
+
+	d->rebuild();
+
+	endResetModel();
+}
+
+void
+ChannelViewSortModel::sourceDataChanged( const QModelIndex & topLeft,
+	const QModelIndex & bottomRight )
+{
+	const int last = qMin( bottomRight.row(), int( d->m_isChanged.size() ) - 1 );
+	const bool scheduled = !d->m_changed.isEmpty();
+
+	for( int row = topLeft.row(); row <= last; ++row )
+	{
+		// Rows filtered out by the level that stay there cost nothing.
+		if( !d->m_accepted.testBit( row ) && !d->isLevelAccepted( row ) )
+			continue;
+
+		if( !d->m_isChanged.testBit( row ) )
+		{
+			d->m_isChanged.setBit( row );
+			d->m_changed.append( row );
+		}
+	}
+
+	// Flush of the model applies changes, this is for other changes.
+	if( !scheduled && !d->m_changed.isEmpty() )
+		QMetaObject::invokeMethod( this, &ChannelViewSortModel::applyChanges,
+			Qt::QueuedConnection );
+}
+
+void
+ChannelViewSortModel::applyChanges()
+{
+	if( d->m_changed.isEmpty() )
+		return;
+
+	const QVector< int > rows = std::move( d->m_changed );
+
+	d->m_changed.clear();
+
+	QVector< int > moved;
+	moved.reserve( rows.size() );
+
+	// Renamed rows could pass or fail the filter.
+	for( const int row : rows )
+	{
+		d->m_isChanged.clearBit( row );
+
+		const bool was = d->m_accepted.testBit( row );
+		const bool accepted = d->isAccepted( row );
+
+		if( was && !accepted )
+		{
+			const int pos = d->rank( row );
+
+			beginRemoveRows( QModelIndex(), pos, pos );
+			d->erase( row );
+			d->m_accepted.clearBit( row );
+			endRemoveRows();
+		}
+		else if( !was && accepted )
+		{
+			const int pos = d->lowerBound( row );
+
+			beginInsertRows( QModelIndex(), pos, pos );
+			d->insertAt( row, pos );
+			d->m_accepted.setBit( row );
+			endInsertRows();
+
+			moved.append( row );
+		}
+		else if( accepted )
+			moved.append( row );
+	}
+
+	if( moved.size() == 1 && !d->isInPlace( moved.first() ) )
+	{
+		const int row = moved.first();
+		const int pos = d->rank( row );
+
+		d->erase( row );
+
+		const int newPos = d->lowerBound( row );
+
+		// Views should see the old order before the move.
+		d->insertAt( row, pos );
+
+		if( newPos != pos )
+		{
+			beginMoveRows( QModelIndex(), pos, pos, QModelIndex(),
+				newPos > pos ? newPos + 1 : newPos );
+			d->erase( row );
+			d->insertAt( row, newPos );
+			endMoveRows();
+		}
+	}
+	else if( moved.size() > 1 )
+	{
+		// Keys of all moved rows are stale in the tree, so they are taken
+		// out first and the rest of the tree is sorted.
+		emit layoutAboutToBeChanged( {}, QAbstractItemModel::VerticalSortHint );
+
+		const QModelIndexList sourceIndexes = persistentSourceIndexes();
+
+		for( const int row : std::as_const( moved ) )
+			d->erase( row );
+
+		for( const int row : std::as_const( moved ) )
+			d->insertAt( row, d->lowerBound( row ) );
+
+		restorePersistentIndexes( sourceIndexes );
+
+		emit layoutChanged( {}, QAbstractItemModel::VerticalSortHint );
+	}
+
+	const int lastColumn = columnCount() - 1;
+
+	for( const int row : rows )
+	{
+		if( d->m_accepted.testBit( row ) )
+		{
+			const int pos = d->rank( row );
+
+			emit dataChanged( index( pos, 0 ), index( pos, lastColumn ) );
+		}
+	}
+}
+
+void
+ChannelViewSortModel::sourceRowsInserted( const QModelIndex & parent,
+	int first, int last )
+{
+	if( parent.isValid() )
+		return;
+
+	if( first != d->m_accepted.size() || first != last )
+	{
+		beginResetModel();
+		d->rebuild();
+		endResetModel();
+
+		return;
+	}
+
+	applyChanges();
+
+	d->resize( last + 1 );
+
+	if( d->isAccepted( first ) )
+	{
+		const int pos = d->lowerBound( first );
+
+		beginInsertRows( QModelIndex(), pos, pos );
+		d->insertAt( first, pos );
+		d->m_accepted.setBit( first );
+		endInsertRows();
+	}
+}
+
+void
+ChannelViewSortModel::sourceAboutToBeReset()
+{
+	beginResetModel();
+}
+
+void
+ChannelViewSortModel::sourceReset()
+{
+	d->rebuild();
+
+	endResetModel();
+}
+
+QModelIndexList
+ChannelViewSortModel::persistentSourceIndexes() const
+{
+	const QModelIndexList indexes = persistentIndexList();
+
+	QModelIndexList sourceIndexes;
+	sourceIndexes.reserve( indexes.size() );
+
+	for( const auto & index : indexes )
+		sourceIndexes.append( mapToSource( index ) );
+
+	return sourceIndexes;
+}
+
+void
+ChannelViewSortModel::restorePersistentIndexes(
+	const QModelIndexList & sourceIndexes )
+{
+	QModelIndexList indexes;
+	indexes.reserve( sourceIndexes.size() );
+
+	for( const auto & index : sourceIndexes )
+		indexes.append( mapFromSource( index ) );
+
+	changePersistentIndexList( persistentIndexList(), indexes );
+}
+
+} /* namespace Globe */
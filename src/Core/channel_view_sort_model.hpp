@@ -0,0 +1,120 @@
+
+/*
+	SPDX-FileCopyrightText: 2012-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#ifndef GLOBE__CHANNEL_VIEW_SORT_MODEL_HPP__INCLUDED
+#define GLOBE__CHANNEL_VIEW_SORT_MODEL_HPP__INCLUDED
+
+// Qt include.
+#include <QAbstractProxyModel>
+#include <QScopedPointer>
+
+// Globe include.
+#include <Core/condition.hpp>
+#include <Core/export.hpp>
+
+
+namespace Globe {
+
+class ChannelViewWindowModel;
+
+
+//
+// ChannelViewSortModel
+//
+
+class ChannelViewSortModelPrivate;
+
+/*!
+	Sort and filter proxy of the channel view.
+
+	Accepted rows are kept in the order statistics tree (treap with
+	sizes of the subtrees) ordered by the sort column, so mapping of the
+	rows costs O(log n). Changed rows are repositioned when the model
+	flushes its changes: single changed row is moved to its new place in
+	O(log n) with one rowsMoved(), k changed rows are placed again in
+	O(k log n) with one layoutChanged(), rows are never sorted again.
+
+	Quick filter matches the text with source and type names. When the
+	filter text is extended only accepted rows are checked again, when
+	it's shortened only rejected ones, accepted rows stay sorted.
+
+	Level filter shows only rows with the given or more severe level.
+	Tree is built from the index of the levels of the model, so showing
+	a few abnormal sources of the big channel doesn't touch healthy
+	ones, and changes of the healthy rows are dropped at once.
+*/
+class CORE_EXPORT ChannelViewSortModel
+	:	public QAbstractProxyModel
+{
+	Q_OBJECT
+
+public:
+	ChannelViewSortModel( ChannelViewWindowModel * model,
+		QObject * parent = 0 );
+
+	~ChannelViewSortModel();
+
+	//! \return Sort column, -1 if rows aren't sorted.
+	int sortColumn() const;
+	//! \return Sort order.
+	Qt::SortOrder sortOrder() const;
+
+	//! \return Filter text.
+	const QString & filterText() const;
+
+	//! \return Least severe level to show, None if all rows are shown.
+	Level levelFilter() const;
+
+	QModelIndex mapToSource( const QModelIndex & proxyIndex ) const override;
+	QModelIndex mapFromSource( const QModelIndex & sourceIndex ) const override;
+
+	QModelIndex index( int row, int column,
+		const QModelIndex & parent = QModelIndex() ) const override;
+	QModelIndex parent( const QModelIndex & child ) const override;
+
+	int rowCount( const QModelIndex & parent = QModelIndex() ) const override;
+	int columnCount( const QModelIndex & parent = QModelIndex() ) const override;
+
+	QVariant headerData( int section, Qt::Orientation orientation,
+		int role = Qt::DisplayRole ) const override;
+
+	void sort( int column, Qt::SortOrder order = Qt::AscendingOrder ) override;
+
+public slots:
+	//! Set filter text.
+	void setFilterText( const QString & text );
+	//! Show only rows with the given or more severe level, None shows
+	//! all rows.
+	void setLevelFilter( Globe::Level level );
+
+private slots:
+	//! Data of the source model changed.
+	void sourceDataChanged( const QModelIndex & topLeft,
+		const QModelIndex & bottomRight );
+	//! Reposition changed rows.
+	void applyChanges();
+	//! Rows inserted into the source model.
+	void sourceRowsInserted( const QModelIndex & parent, int first, int last );
+	//! Source model is about to be reset or rows are about to be removed.
+	void sourceAboutToBeReset();
+	//! Source model reset or rows removed.
+	void sourceReset();
+
+private:
+	//! \return Source indexes of the persistent indexes.
+	QModelIndexList persistentSourceIndexes() const;
+	//! Update persistent indexes from the source indexes.
+	void restorePersistentIndexes( const QModelIndexList & sourceIndexes );
+
+private:
+	Q_DISABLE_COPY( ChannelViewSortModel )
+
+	QScopedPointer< ChannelViewSortModelPrivate > d;
+}; // class ChannelViewSortModel
+
+} /* namespace Globe */
+
+#endif // GLOBE__CHANNEL_VIEW_SORT_MODEL_HPP__INCLUDED
@@ -8,10 +8,12 @@
 #include <Core/channel_view_window.hpp>
 #include <Core/channel_view.hpp>
 #include <Core/channel_view_window_model.hpp>
+#include <Core/channel_view_sort_model.hpp>
 #include <Core/tool_window_object.hpp>
 #include <Core/channels.hpp>
 #include <Core/mainwindow.hpp>
 #include <Core/globe_menu.hpp>
+#include <Core/hidden_window_watcher.hpp>
 
 // Qt include.
 #include <QMenuBar>
@@ -20,6 +22,8 @@
 #include <QCloseEvent>
 #include <QHeaderView>
 #include <QToolBar>
+#include <QLineEdit>
+#include <QComboBox>
 
 
 namespace Globe {
@@ -32,12 +36,15 @@ class ChannelViewWindowPrivate {
 public:
 	ChannelViewWindowPrivate()
 		:	m_view( 0 )
+		,	m_levelFilter( 0 )
 		,	m_winMenu( Q_NULLPTR )
 	{
 	}
 
 	//! View.
 	ChannelView * m_view;
+	//! Level filter.
+	QComboBox * m_levelFilter;
 	//! Channel's name.
 	QString m_channelName;
 	//! Windows menu.
@@ -221,6 +228,9 @@ ChannelViewWindow::init()
 
 	setCentralWidget( d->m_view );
 
+	connect( new HiddenWindowWatcher( this ), &HiddenWindowWatcher::hiddenChanged,
+		d->m_view->model(), &ChannelViewWindowModel::setPaused );
+
 	QToolBar * toolBar = new QToolBar( this );
 	addToolBar( Qt::TopToolBarArea, toolBar );
 
@@ -228,6 +238,29 @@ ChannelViewWindow::init()
 	toolBar->addAction( d->m_view->selectAllAction() );
 	toolBar->addSeparator();
 	toolBar->addAction( d->m_view->fillColorAction() );
+	toolBar->addSeparator();
+
+	QLineEdit * filter = new QLineEdit( toolBar );
+	filter->setPlaceholderText( tr( "Filter" ) );
+	filter->setClearButtonEnabled( true );
+	toolBar->addWidget( filter );
+
+	connect( filter, &QLineEdit::textChanged,
+		d->m_view->sortModel(), &ChannelViewSortModel::setFilterText );
+
+	d->m_levelFilter = new QComboBox( toolBar );
+	d->m_levelFilter->addItem( tr( "All Sources" ), int( None ) );
+	d->m_levelFilter->addItem( tr( "Only Abnormal" ), int( Debug ) );
+	d->m_levelFilter->addItem( tr( "Warning and Worse" ), int( Warning ) );
+	d->m_levelFilter->addItem( tr( "Error and Worse" ), int( Error ) );
+	d->m_levelFilter->addItem( tr( "Only Critical" ), int( Critical ) );
+	toolBar->addWidget( d->m_levelFilter );
+
+	void ( QComboBox::*signal ) ( int ) =
+		&QComboBox::currentIndexChanged;
+
+	connect( d->m_levelFilter, signal,
+		this, &ChannelViewWindow::levelFilterChanged );
 
 	connect( &MainWindow::instance(), &MainWindow::windowCreated,
 		this, &ChannelViewWindow::updateWindowsMenu );
@@ -235,6 +268,13 @@ ChannelViewWindow::init()
 		this, &ChannelViewWindow::updateWindowsMenu );
 }
 
+void
+ChannelViewWindow::levelFilterChanged( int index )
+{
+	d->m_view->sortModel()->setLevelFilter(
+		static_cast< Level > ( d->m_levelFilter->itemData( index ).toInt() ) );
+}
+
 void
 ChannelViewWindow::initMenu( const Menu & menu )
 {
@@ -63,6 +63,8 @@ private:
 private slots:
 	//! Update windows menu.
 	void updateWindowsMenu( QWidget * );
+	//! Level filter changed.
+	void levelFilterChanged( int index );
 
 private:
 	Q_DISABLE_COPY( ChannelViewWindow )
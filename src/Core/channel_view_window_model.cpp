@@ -12,6 +12,11 @@
 
 // Qt include.
 #include <QList>
+#include <QHash>
+#include <QBitArray>
+#include <QMap>
+#include <QSet>
+#include <QTimer>
 #include <QByteArray>
 #include <QDataStream>
 #include <QMimeData>
@@ -19,6 +24,10 @@
 
 namespace Globe {
 
+//! Max count of flushes of changed rows to the views per second.
+static const int maxFlushesPerSecond = 10;
+
+
 //
 // ChannelViewWindowModelData
 //
@@ -52,6 +61,37 @@ public:
 }; // class ChannelViewWindowModelData
 
 
+//
+// ChannelViewWindowModelKey
+//
+
+//! Key of the source in the model.
+struct ChannelViewWindowModelKey {
+	explicit ChannelViewWindowModelKey( const Como::Source & source )
+		:	m_name( source.name() )
+		,	m_typeName( source.typeName() )
+	{
+	}
+
+	//! Source name.
+	QString m_name;
+	//! Type name.
+	QString m_typeName;
+}; // struct ChannelViewWindowModelKey
+
+static inline bool operator == ( const ChannelViewWindowModelKey & k1,
+	const ChannelViewWindowModelKey & k2 )
+{
+	return ( k1.m_name == k2.m_name && k1.m_typeName == k2.m_typeName );
+}
+
+static inline size_t qHash( const ChannelViewWindowModelKey & key,
+	size_t seed = 0 )
+{
+	return qHashMulti( seed, key.m_name, key.m_typeName );
+}
+
+
 //
 // ChannelViewWindowModelPrivate
 //
@@ -60,23 +100,100 @@ class ChannelViewWindowModelPrivate {
 public:
 	ChannelViewWindowModelPrivate()
 		:	m_isConnected( false )
+		,	m_firstChanged( -1 )
+		,	m_lastChanged( -1 )
+		,	m_flushTimer( 0 )
 	{
 	}
 
 	//! \return Index of the data with the given source.
-	int findData( const Como::Source & source )
+	int findData( const Como::Source & source ) const
+	{
+		return m_rows.value( ChannelViewWindowModelKey( source ), -1 );
+	}
+
+	//! Append data.
+	void append( const ChannelViewWindowModelData & data )
 	{
-		const int size = m_data.size();
+		m_rows.insert( ChannelViewWindowModelKey( data.m_source ),
+			m_data.size() );
+
+		if( data.m_level != None )
+			m_levelRows[ data.m_level ].insert( m_data.size() );
+
+		m_data.append( data );
+	}
+
+	//! Set level of the row. Index of the levels is touched only when
+	//! level really changes.
+	void setLevel( int row, Level level )
+	{
+		Level & current = m_data[ row ].m_level;
+
+		if( current == level )
+			return;
+
+		if( current != None )
+		{
+			const auto it = m_levelRows.find( current );
+
+			it.value().remove( row );
+
+			if( it.value().isEmpty() )
+				m_levelRows.erase( it );
+		}
+
+		if( level != None )
+			m_levelRows[ level ].insert( row );
+
+		current = level;
+	}
+
+	//! Mark row as changed, it will be flushed to the views by timer.
+	void markChanged( int row )
+	{
+		if( m_changed.size() < m_data.size() )
+			m_changed.resize( m_data.size() );
+
+		m_changed.setBit( row );
+
+		if( m_firstChanged == -1 || row < m_firstChanged )
+			m_firstChanged = row;
 
-		for( int i = 0; i < size; ++i )
-			if( m_data.at( i ).m_source == source )
-				return i;
+		if( row > m_lastChanged )
+			m_lastChanged = row;
 
-		return -1;
+		if( !m_flushTimer->isActive() )
+			m_flushTimer->start();
+	}
+
+	//! Clear data.
+	void clear()
+	{
+		m_data.clear();
+		m_rows.clear();
+		m_levelRows.clear();
+		m_changed.clear();
+		m_firstChanged = -1;
+		m_lastChanged = -1;
+		m_flushTimer->stop();
 	}
 
 	//! Data.
 	QList< ChannelViewWindowModelData > m_data;
+	//! Rows of the sources. Rows are only appended or cleared all
+	//! together, so indexes stay valid.
+	QHash< ChannelViewWindowModelKey, int > m_rows;
+	//! Rows by levels, rows with None level aren't indexed.
+	QMap< Level, QSet< int > > m_levelRows;
+	//! Changed rows not flushed yet to the views.
+	QBitArray m_changed;
+	//! First changed row.
+	int m_firstChanged;
+	//! Last changed row.
+	int m_lastChanged;
+	//! Timer of the flushes.
+	QTimer * m_flushTimer;
 	//! Channel name.
 	QString m_channelName;
 	//! Is channel connected?
@@ -92,8 +209,12 @@ ChannelViewWindowModel::ChannelViewWindowModel( QObject * parent )
 	:	QAbstractTableModel( parent )
 	,	d( new ChannelViewWindowModelPrivate )
 {
-	connect( &SourcesManager::instance(), &SourcesManager::newSource,
-		this, &ChannelViewWindowModel::newSource );
+	d->m_flushTimer = new QTimer( this );
+	d->m_flushTimer->setSingleShot( true );
+	d->m_flushTimer->setInterval( 1000 / maxFlushesPerSecond );
+
+	connect( d->m_flushTimer, &QTimer::timeout,
+		this, &ChannelViewWindowModel::flushChanges );
 
 	connect( &PropertiesManager::instance(),
 		&PropertiesManager::propertiesChanged,
@@ -106,6 +227,7 @@ ChannelViewWindowModel::ChannelViewWindowModel( QObject * parent )
 
 ChannelViewWindowModel::~ChannelViewWindowModel()
 {
+	SourcesBus::instance().unsubscribe( this );
 }
 
 const QString &
@@ -134,10 +256,8 @@ ChannelViewWindowModel::initModel( const QString & channelName )
 				this, &ChannelViewWindowModel::connected );
 			connect( channel, &Channel::disconnected,
 				this, &ChannelViewWindowModel::disconnected );
-			connect( channel, &Channel::sourceDeregistered,
-				this, &ChannelViewWindowModel::sourceDeregistered );
-			connect( channel, &Channel::sourceUpdated,
-				this, &ChannelViewWindowModel::sourceUpdated );
+
+			SourcesBus::instance().subscribe( this, d->m_channelName );
 
 			const QList< Como::Source > registered = SourcesManager::instance()
 				.registeredSources( d->m_channelName );
@@ -153,6 +273,9 @@ ChannelViewWindowModel::initModel( const QString & channelName )
 			{
 				beginInsertRows( QModelIndex(), 0, rows - 1 );
 
+				d->m_data.reserve( rows );
+				d->m_rows.reserve( rows );
+
 				for( int i = 0; i < registeredCount; ++i )
 				{
 					const Como::Source & source = registered.at( i );
@@ -171,7 +294,7 @@ ChannelViewWindowModel::initModel( const QString & channelName )
 							source.type() ).level();
 					}
 
-					d->m_data.insert( i, ChannelViewWindowModelData( source, priority,
+					d->append( ChannelViewWindowModelData( source, priority,
 						true, level ) );
 				}
 
@@ -193,9 +316,8 @@ ChannelViewWindowModel::initModel( const QString & channelName )
 							source.type() ).level();
 					}
 
-					d->m_data.insert( registeredCount + i,
-						ChannelViewWindowModelData( source, priority,
-							false, level ) );
+					d->append( ChannelViewWindowModelData( source, priority,
+						false, level ) );
 				}
 
 				endInsertRows();
@@ -209,7 +331,7 @@ ChannelViewWindowModel::clear()
 {
 	beginResetModel();
 
-	d->m_data.clear();
+	d->clear();
 
 	d->m_isConnected = false;
 
@@ -220,11 +342,19 @@ ChannelViewWindowModel::clear()
 
 		if( oldChannel )
 			disconnect( oldChannel, 0, this, 0 );
+
+		SourcesBus::instance().unsubscribe( this, d->m_channelName );
 	}
 
 	endResetModel();
 }
 
+void
+ChannelViewWindowModel::setPaused( bool on )
+{
+	SourcesBus::instance().setPaused( this, on );
+}
+
 void
 ChannelViewWindowModel::addItem( const Como::Source & source, bool isRegistered )
 {
@@ -246,10 +376,13 @@ ChannelViewWindowModel::addItem( const Como::Source & source, bool isRegistered
 			source.type() ).level();
 	}
 
-	d->m_data.insert( size, ChannelViewWindowModelData( source, priority,
+	d->append( ChannelViewWindowModelData( source, priority,
 		isRegistered, level ) );
 
 	endInsertRows();
+
+	// Position of the new row in sorted views is updated with the flush.
+	d->markChanged( size );
 }
 
 const Como::Source &
@@ -276,6 +409,12 @@ ChannelViewWindowModel::priority( const QModelIndex & index ) const
 	return d->m_data.at( index.row() ).m_priority;
 }
 
+QSet< int >
+ChannelViewWindowModel::rowsWithLevel( Level level ) const
+{
+	return d->m_levelRows.value( level );
+}
+
 bool
 ChannelViewWindowModel::isConnected() const
 {
@@ -308,11 +447,10 @@ ChannelViewWindowModel::sourceUpdated( const Como::Source & source )
 		}
 
 		data.m_priority = priority;
-		data.m_level = level;
 		data.m_isRegistered = true;
+		d->setLevel( index, level );
 
-		emit dataChanged( QAbstractTableModel::index( index, valueColumn ),
-			QAbstractTableModel::index( index, priorityColumn ) );
+		d->markChanged( index );
 	}
 	else
 		addItem( source, true );
@@ -341,8 +479,7 @@ ChannelViewWindowModel::sourceDeregistered( const Como::Source & source )
 
 		data.m_isRegistered = false;
 
-		emit dataChanged( QAbstractTableModel::index( index, valueColumn ),
-			QAbstractTableModel::index( index, priorityColumn ) );
+		d->markChanged( index );
 	}
 	else
 		addItem( source, false );
@@ -354,7 +491,7 @@ ChannelViewWindowModel::connected()
 	d->m_isConnected = true;
 
 	beginResetModel();
-	d->m_data.clear();
+	d->clear();
 	endResetModel();
 }
 
@@ -368,11 +505,19 @@ ChannelViewWindowModel::disconnected()
 }
 
 void
-ChannelViewWindowModel::newSource( const Como::Source & source,
-	const QString & channelName )
+ChannelViewWindowModel::sourcesChanged( const QString & channelName,
+	const QList< SourceChange > & changes )
 {
-	if( channelName == d->m_channelName )
-		sourceUpdated( source );
+	if( channelName != d->m_channelName )
+		return;
+
+	for( const auto & c : changes )
+	{
+		if( c.m_registered )
+			sourceUpdated( c.m_source );
+		else
+			sourceDeregistered( c.m_source );
+	}
 }
 
 void
@@ -380,8 +525,6 @@ ChannelViewWindowModel::propertiesChanged()
 {
 	const int size = d->m_data.size();
 
-	bool prChanged = false;
-
 	for( int i = 0; i < size; ++i )
 	{
 		ChannelViewWindowModelData & data = d->m_data[ i ];
@@ -400,21 +543,48 @@ ChannelViewWindowModel::propertiesChanged()
 				data.m_source.type() ).level();
 		}
 
-		if( priority != data.m_priority )
-			prChanged = true;
-
 		if( priority != data.m_priority || level != data.m_level )
 		{
 			data.m_priority = priority;
-			data.m_level = level;
+			d->setLevel( i, level );
+
+			d->markChanged( i );
+		}
+	}
+}
+
+void
+ChannelViewWindowModel::flushChanges()
+{
+	if( d->m_firstChanged == -1 )
+		return;
+
+	const int last = qMin( d->m_lastChanged, int( d->m_data.size() ) - 1 );
+	const int lastColumn = columnCount() - 1;
 
-			emit dataChanged( QAbstractTableModel::index( i, valueColumn ),
-				QAbstractTableModel::index( i, priorityColumn ) );
+	// Contiguous changed rows go to the views as one range.
+	for( int row = d->m_firstChanged; row <= last; )
+	{
+		if( !d->m_changed.testBit( row ) )
+		{
+			++row;
+
+			continue;
 		}
+
+		const int first = row;
+
+		while( row <= last && d->m_changed.testBit( row ) )
+			d->m_changed.clearBit( row++ );
+
+		emit dataChanged( QAbstractTableModel::index( first, 0 ),
+			QAbstractTableModel::index( row - 1, lastColumn ) );
 	}
 
-	if( prChanged )
-		emit priorityChanged();
+	d->m_firstChanged = -1;
+	d->m_lastChanged = -1;
+
+	emit changesFlushed();
 }
 
 void
@@ -478,6 +648,10 @@ ChannelViewWindowModel::setData( const QModelIndex & index, const QVariant & val
 
 	if( role == Qt::DisplayRole )
 	{
+		if( column == sourceNameColumn || column == sourceTypeNameColumn )
+			d->m_rows.remove( ChannelViewWindowModelKey(
+				d->m_data.at( row ).m_source ) );
+
 		switch( column )
 		{
 			case sourceNameColumn :
@@ -491,6 +665,10 @@ ChannelViewWindowModel::setData( const QModelIndex & index, const QVariant & val
 			case priorityColumn :
 				d->m_data[ row ].m_priority = value.toInt(); break;
 		}
+
+		if( column == sourceNameColumn || column == sourceTypeNameColumn )
+			d->m_rows.insert( ChannelViewWindowModelKey(
+				d->m_data.at( row ).m_source ), row );
 	}
 
 	emit dataChanged( QAbstractTableModel::index( row, column ),
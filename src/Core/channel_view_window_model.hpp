@@ -10,12 +10,14 @@
 // Qt include.
 #include <QAbstractTableModel>
 #include <QScopedPointer>
+#include <QSet>
 
 // Como include.
 #include <Como/Source>
 
 // Globe include.
 #include <Core/condition.hpp>
+#include <Core/sources_bus.hpp>
 
 
 namespace Globe {
@@ -36,15 +38,24 @@ class Channel;
 
 class ChannelViewWindowModelPrivate;
 
-//! Model with Como::Source sources.
-class ChannelViewWindowModel
+/*!
+	Model with Como::Source sources.
+
+	Updates of the sources don't emit dataChanged() immediately, changed
+	rows are marked in the bitmap and flushed to the views by timer not
+	more often than 10 times per second, as ranges of contiguous rows.
+	Updates come from the sources bus in batches. Rows are indexed by
+	levels, the index is updated only when level of the row changes.
+*/
+class CORE_EXPORT ChannelViewWindowModel
 	:	public QAbstractTableModel
+	,	public SourcesSubscriber
 {
 	Q_OBJECT
 
 signals:
-	//! Priority of the source has been changed.
-	void priorityChanged();
+	//! Changed rows were flushed to the views.
+	void changesFlushed();
 
 public:
 	ChannelViewWindowModel( QObject * parent = 0 );
@@ -60,6 +71,10 @@ public:
 	//! Clear model.
 	void clear();
 
+	//! Pause updates of the sources while model isn't visible, on
+	//! resume model catches up with changed sources in one batch.
+	void setPaused( bool on = true );
+
 	//! Add new item.
 	void addItem( const Como::Source & source, bool isRegistered );
 
@@ -71,6 +86,9 @@ public:
 	Level level( const QModelIndex & index ) const;
 	//! \return Priority.
 	int priority( const QModelIndex & index ) const;
+	//! \return Rows with the given level. Rows with None level aren't
+	//! indexed, so for None empty set is returned.
+	QSet< int > rowsWithLevel( Level level ) const;
 
 	//! \return Is channel connected?
 	bool isConnected() const;
@@ -94,21 +112,27 @@ public:
 	QStringList mimeTypes() const;
 	QMimeData * mimeData( const QModelIndexList & indexes ) const;
 
-private slots:
+	//! Sources of the channel changed.
+	void sourcesChanged( const QString & channelName,
+		const QList< SourceChange > & changes ) override;
+
+private:
 	//! Source updated.
 	void sourceUpdated( const Como::Source & source );
 	//! Source deregistered.
 	void sourceDeregistered( const Como::Source & source );
+
+private slots:
 	//! Channel connected.
 	void connected();
 	//! Channel disconnected.
 	void disconnected();
-	//! New source available.
-	void newSource( const Como::Source & source, const QString & channelName );
 	//! Properties changed.
 	void propertiesChanged();
 	//! Channel removed.
 	void channelRemoved( Globe::Channel * ch );
+	//! Flush changed rows to the views.
+	void flushChanges();
 
 private:
 	Q_DISABLE_COPY( ChannelViewWindowModel )
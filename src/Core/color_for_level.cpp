@@ -8,6 +8,7 @@
 #include <Core/color_for_level.hpp>
 #include <Core/color_for_level_cfg.hpp>
 #include <Core/log.hpp>
+#include <Core/configuration.hpp>
 
 // cfgfile include.
 #include <cfgfile/all.hpp>
@@ -221,7 +222,7 @@ ColorForLevel::readCfg( const QString & fileName )
 					"%2" )
 						.arg( fileName, x.desc() ) );
 
-			QMessageBox::critical( 0,
+			Configuration::instance().critical(
 				tr( "Unable to read colors correspondence configuration..." ),
 				x.desc() );
 
@@ -237,7 +238,7 @@ ColorForLevel::readCfg( const QString & fileName )
 				"\"%1\"" )
 					.arg( fileName ) );
 
-		QMessageBox::critical( 0,
+		Configuration::instance().critical(
 			tr( "Unable to read colors correspondence configuration..." ),
 			tr( "Unable to open file \"%1\"." )
 				.arg( fileName ) );
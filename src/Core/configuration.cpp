@@ -75,6 +75,7 @@ class ConfigurationPrivate {
 public:
 	ConfigurationPrivate()
 		:	m_appCfgWasLoaded( false )
+		,	m_headless( false )
 	{
 	}
 
@@ -84,6 +85,10 @@ public:
 	ApplicationCfg m_appCfg;
 	//! Was application's configuration loaded?
 	bool m_appCfgWasLoaded;
+	//! Is configuration used without windows?
+	bool m_headless;
+	//! Errors collected in headless mode.
+	QStringList m_errors;
 }; // class ConfigurationPrivate
 
 
@@ -174,6 +179,25 @@ Configuration::loadConfiguration()
 				"Use the default configuration." ) );
 }
 
+void
+Configuration::loadHeadlessConfiguration()
+{
+	Log::instance().writeMsgToEventLog( LogLevelInfo,
+		QLatin1String( "Loading headless configuration..." ) );
+
+	readAppCfg( d->m_cfgFileName );
+
+	readDbCfg( d->m_appCfg.dbCfgFile() );
+
+	readLogCfg( d->m_appCfg.logCfgFile() );
+
+	readPropertiesCfg( d->m_appCfg.propertiesCfgFile() );
+
+	readColorsCfg( d->m_appCfg.colorsCfgFile() );
+
+	readChannelsCfg( d->m_appCfg.channelsCfgFile() );
+}
+
 void
 Configuration::saveConfiguration()
 {
@@ -218,6 +242,42 @@ Configuration::setCfgFile( const QString & fileName )
 	d->m_cfgFileName = fileName;
 }
 
+bool
+Configuration::isHeadless() const
+{
+	return d->m_headless;
+}
+
+void
+Configuration::setHeadless( bool on )
+{
+	d->m_headless = on;
+}
+
+const QStringList &
+Configuration::errors() const
+{
+	return d->m_errors;
+}
+
+void
+Configuration::critical( const QString & title, const QString & text )
+{
+	if( d->m_headless )
+		d->m_errors.append( title + QLatin1Char( '\n' ) + text );
+	else
+		QMessageBox::critical( 0, title, text );
+}
+
+void
+Configuration::warning( const QString & title, const QString & text )
+{
+	if( d->m_headless )
+		d->m_errors.append( title + QLatin1Char( '\n' ) + text );
+	else
+		QMessageBox::warning( 0, title, text );
+}
+
 void
 Configuration::readAppCfg( const QString & cfgFileName )
 {
@@ -257,8 +317,7 @@ Configuration::readAppCfg( const QString & cfgFileName )
 				"%2" )
 					.arg( d->m_cfgFileName, x.desc() ) );
 
-			QMessageBox::critical( 0,
-				tr( "Unable to load Globe's configuration file..." ),
+			critical( tr( "Unable to load Globe's configuration file..." ),
 				x.desc() );
 		}
 	}
@@ -270,8 +329,7 @@ Configuration::readAppCfg( const QString & cfgFileName )
 			"Unable to open file." )
 				.arg( d->m_cfgFileName ) );
 
-		QMessageBox::critical( 0,
-			tr( "Unable to load Globe's configuration file..." ),
+		critical( tr( "Unable to load Globe's configuration file..." ),
 			tr( "Unable to open file. Does file \"%1\" exist?\n"
 				"Globe will start with empty default configuration.\n"
 				"You can configure application and save configuration." )
@@ -319,8 +377,7 @@ Configuration::readMainWindowCfg( const QString & cfgFileName )
 					"Unable to open file." )
 						.arg( p ) );
 
-				QMessageBox::critical( 0,
-					tr( "Unable to load main window's configuration..." ),
+				critical( tr( "Unable to load main window's configuration..." ),
 					tr( "Unable to open file \"%1\"." ).arg( p ) );
 
 				return;
@@ -336,8 +393,7 @@ Configuration::readMainWindowCfg( const QString & cfgFileName )
 				"%2" )
 					.arg( p, x.desc() ) );
 
-			QMessageBox::critical( 0,
-				tr( "Unable to load main window's configuration..." ),
+			critical( tr( "Unable to load main window's configuration..." ),
 				x.desc() );
 
 			return;
@@ -357,8 +413,7 @@ Configuration::readMainWindowCfg( const QString & cfgFileName )
 				"in \"%1\" file." )
 					.arg( path() + defaultMainWindowCfgFileName ) );
 
-			QMessageBox::warning( 0,
-				tr( "Error in application's configuration..." ),
+			warning( tr( "Error in application's configuration..." ),
 				tr( "Not specified main window's configuration file.\n"
 					"Main window's configuration will not be loaded.\n"
 					"At exit configuration of the main window will be saved\n"
@@ -409,8 +464,7 @@ Configuration::readChannelsCfg( const QString & cfgFileName )
 					"%2" )
 						.arg( p, x.desc() ) );
 
-				QMessageBox::critical( 0,
-					tr( "Unable to load channels configuration..." ),
+				critical( tr( "Unable to load channels configuration..." ),
 					x.desc() );
 
 				return;
@@ -424,8 +478,7 @@ Configuration::readChannelsCfg( const QString & cfgFileName )
 				"Unable to open file." )
 					.arg( p ) );
 
-			QMessageBox::critical( 0,
-				tr( "Unable to load channels configuration..." ),
+			critical( tr( "Unable to load channels configuration..." ),
 				tr( "Unable to open file \"%1\"." ).arg( p ) );
 
 			return;
@@ -445,8 +498,7 @@ Configuration::readChannelsCfg( const QString & cfgFileName )
 				"in \"%1\" file." )
 					.arg( path() + defaultChannelsCfgFileName ) );
 
-			QMessageBox::warning( 0,
-				tr( "Error in application's configuration..." ),
+			warning( tr( "Error in application's configuration..." ),
 				tr( "Not specified channel's configuration file.\n"
 					"Channel's configuration will not be loaded.\n"
 					"At exit channels configuration will be saved\n"
@@ -475,8 +527,7 @@ Configuration::readChannelsCfg( const QString & cfgFileName )
 				"Channel with name \"%1\" already exists." )
 					.arg( channelCfg.name() ) );
 
-			QMessageBox::critical( 0,
-				tr( "Unable to create new channel..." ),
+			critical( tr( "Unable to create new channel..." ),
 				tr( "Channel with name \"%1\" already exists." )
 					.arg( channelCfg.name() ) );
 		}
@@ -488,8 +539,7 @@ Configuration::readChannelsCfg( const QString & cfgFileName )
 				"Channel with address \"%1\" and port %2 already exists." )
 					.arg( channelCfg.address(), QString::number( channelCfg.port() ) ) );
 
-			QMessageBox::critical( 0,
-				tr( "Unable to create new channel..." ),
+			critical( tr( "Unable to create new channel..." ),
 				tr( "Channel with address \"%1\" and port %2 already exists." )
 					.arg( channelCfg.address(), QString::number( channelCfg.port() ) ) );
 		}
@@ -517,8 +567,7 @@ Configuration::readPropertiesCfg( const QString & cfgFileName )
 				"in \"%1\" file." )
 					.arg( path() + defaultPropertiesCfgFileName ) );
 
-			QMessageBox::warning( 0,
-				tr( "Error in application's configuration..." ),
+			warning( tr( "Error in application's configuration..." ),
 				tr( "Not specified properties configuration file.\n"
 					"Properties configuration will not be loaded.\n"
 					"At exit properties configuration will be saved\n"
@@ -548,8 +597,7 @@ Configuration::readSourcesMainWindowCfg( const QString & cfgFileName )
 				"in \"%1\" file." )
 					.arg( path() + defaultSourcesMainWindowCfgFileName ) );
 
-			QMessageBox::warning( 0,
-				tr( "Error in application's configuration..." ),
+			warning( tr( "Error in application's configuration..." ),
 				tr( "Not specified sources main window configuration file.\n"
 					"Sources main window configuration will not be loaded.\n"
 					"At exit sources main window configuration will be saved\n"
@@ -597,8 +645,7 @@ Configuration::readWindowsCfg( const QString & cfgFileName )
 					"%2" )
 						.arg( p, x.desc() ) );
 
-				QMessageBox::critical( 0,
-					tr( "Unable to load windows configuration..." ),
+				critical( tr( "Unable to load windows configuration..." ),
 					x.desc() );
 
 				return;
@@ -612,8 +659,7 @@ Configuration::readWindowsCfg( const QString & cfgFileName )
 				"Unable to open file." )
 					.arg( p ) );
 
-			QMessageBox::critical( 0,
-				tr( "Unable to load windows configuration..." ),
+			critical( tr( "Unable to load windows configuration..." ),
 				tr( "Unable to open file \"%1\"." ).arg( p ) );
 
 			return;
@@ -633,8 +679,7 @@ Configuration::readWindowsCfg( const QString & cfgFileName )
 				"in \"%1\" file." )
 					.arg( path() + defaultWindowsCfgFileName ) );
 
-			QMessageBox::warning( 0,
-				tr( "Error in application's configuration..." ),
+			warning( tr( "Error in application's configuration..." ),
 				tr( "Not specified windows configuration file.\n"
 					"Windows configuration will not be loaded.\n"
 					"At exit configuration of the windows will be saved\n"
@@ -665,8 +710,7 @@ Configuration::readColorsCfg( const QString & cfgFileName )
 				"in \"%1\" file." )
 					.arg( path() + defaultColorsCfgFilename ) );
 
-			QMessageBox::warning( 0,
-				tr( "Error in application's configuration..." ),
+			warning( tr( "Error in application's configuration..." ),
 				tr( "Not specified colors configuration file.\n"
 					"Colors configuration will not be loaded.\n"
 					"At exit colors configuration will be saved\n"
@@ -697,8 +741,7 @@ Configuration::readDbCfg( const QString & cfgFileName )
 				"in \"%1\" file." )
 					.arg( path() + defaultDbCfgFileName ) );
 
-			QMessageBox::warning( 0,
-				tr( "Error in application's configuration..." ),
+			warning( tr( "Error in application's configuration..." ),
 				tr( "Not specified DB configuration file.\n"
 					"DB configuration will not be loaded.\n"
 					"At exit DB configuration will be saved\n"
@@ -729,8 +772,7 @@ Configuration::readLogCfg( const QString & cfgFileName )
 				"in \"%1\" file." )
 					.arg( path() + defaultLogCfgFileName ) );
 
-			QMessageBox::warning( 0,
-				tr( "Error in application's configuration..." ),
+			warning( tr( "Error in application's configuration..." ),
 				tr( "Not specified log configuration file.\n"
 					"Log configuration will not be loaded.\n"
 					"At exit log configuration will be saved\n"
@@ -759,8 +801,7 @@ Configuration::readLogEventWindowCfg( const QString & cfgFileName )
 				"in \"%1\" file." )
 					.arg( path() + defaultLogEventWindowCfgFileName ) );
 
-			QMessageBox::warning( 0,
-				tr( "Error in application's configuration..." ),
+			warning( tr( "Error in application's configuration..." ),
 				tr( "Not specified event's log window configuration file.\n"
 					"Event's log window configuration will not be loaded.\n"
 					"At exit event's log window configuration will be saved\n"
@@ -789,8 +830,7 @@ Configuration::readSoundsCfg( const QString & cfgFileName )
 				"in \"%1\" file." )
 					.arg( path() + defaultSoundsCfgFileName ) );
 
-			QMessageBox::warning( 0,
-				tr( "Error in application's configuration..." ),
+			warning( tr( "Error in application's configuration..." ),
 				tr( "Not specified sounds configuration file.\n"
 					"Sounds configuration will not be loaded.\n"
 					"At exit sounds configuration will be saved\n"
@@ -819,8 +859,7 @@ Configuration::readDisabledSoundsCfg( const QString & cfgFileName )
 				"in \"%1\" file." )
 					.arg( path() + defaultDisabledSoundsCfgFileName ) );
 
-			QMessageBox::warning( 0,
-				tr( "Error in application's configuration..." ),
+			warning( tr( "Error in application's configuration..." ),
 				tr( "Not specified disabled sounds configuration file.\n"
 					"Disabled sounds configuration will not be loaded.\n"
 					"At exit disabled sounds configuration will be saved\n"
@@ -849,8 +888,7 @@ Configuration::readSourcesLogWindowCfg( const QString & cfgFileName )
 				"in \"%1\" file." )
 					.arg( path() + defaultSourcesLogWindowCfgFileName ) );
 
-			QMessageBox::warning( 0,
-				tr( "Error in application's configuration..." ),
+			warning( tr( "Error in application's configuration..." ),
 				tr( "Not specified sources log window's configuration file.\n"
 					"Sources log window's configuration will not be loaded.\n"
 					"At exit sources log window's configuration will be saved\n"
@@ -890,8 +928,7 @@ Configuration::saveAppCfg( const QString & cfgFileName )
 				"%2" )
 					.arg( cfgFileName, x.desc() ) );
 
-			QMessageBox::critical( 0,
-				tr( "Unable to save application's configuration..." ),
+			critical( tr( "Unable to save application's configuration..." ),
 				x.desc() );
 		}
 	}
@@ -903,8 +940,7 @@ Configuration::saveAppCfg( const QString & cfgFileName )
 			"Unable to open file." )
 				.arg( cfgFileName ) );
 
-		QMessageBox::critical( 0,
-			tr( "Unable to save application's configuration..." ),
+		critical( tr( "Unable to save application's configuration..." ),
 			tr( "Unable to open file \"%1\"." ).arg( cfgFileName ) );
 	}
 }
@@ -945,8 +981,7 @@ Configuration::saveMainWindowCfg( const QString & cfgFileName )
 				"%2" )
 					.arg( cfgFileName, x.desc() ) );
 
-			QMessageBox::critical( 0,
-				tr( "Unable to save main window's configuration..." ),
+			critical( tr( "Unable to save main window's configuration..." ),
 				x.desc() );
 		}
 	}
@@ -958,8 +993,7 @@ Configuration::saveMainWindowCfg( const QString & cfgFileName )
 			"Unable to open file." )
 				.arg( cfgFileName ) );
 
-		QMessageBox::critical( 0,
-			tr( "Unable to save main window's configuration..." ),
+		critical( tr( "Unable to save main window's configuration..." ),
 			tr( "Unable to open file \"%1\"." ).arg( cfgFileName ) );
 	}
 }
@@ -1011,8 +1045,7 @@ Configuration::saveChannelsCfg( const QString & cfgFileName )
 				"%2" )
 					.arg( cfgFileName, x.desc() ) );
 
-			QMessageBox::critical( 0,
-				tr( "Unable to save channels configuration..." ),
+			critical( tr( "Unable to save channels configuration..." ),
 				x.desc() );
 		}
 	}
@@ -1024,8 +1057,7 @@ Configuration::saveChannelsCfg( const QString & cfgFileName )
 			"Unable to open file." )
 				.arg( cfgFileName ) );
 
-		QMessageBox::critical( 0,
-			tr( "Unable to save channels configuration..." ),
+		critical( tr( "Unable to save channels configuration..." ),
 			tr( "Unable to open file \"%1\"." ).arg( cfgFileName ) );
 	}
 }
@@ -1074,8 +1106,7 @@ Configuration::saveWindowsCfg( const QString & cfgFileName )
 				"%2" )
 					.arg( cfgFileName, x.desc() ) );
 
-			QMessageBox::critical( 0,
-				tr( "Unable to save windows configuration..." ),
+			critical( tr( "Unable to save windows configuration..." ),
 				x.desc() );
 		}
 	}
@@ -1087,8 +1118,7 @@ Configuration::saveWindowsCfg( const QString & cfgFileName )
 			"Unable to open file." )
 				.arg( cfgFileName ) );
 
-		QMessageBox::critical( 0,
-			tr( "Unable to save windows configuration..." ),
+		critical( tr( "Unable to save windows configuration..." ),
 			tr( "Unable to open file \"%1\"." ).arg( cfgFileName ) );
 	}
 }
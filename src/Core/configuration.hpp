@@ -10,6 +10,7 @@
 // Qt include.
 #include <QObject>
 #include <QScopedPointer>
+#include <QStringList>
 
 // Globe include.
 #include <Core/export.hpp>
@@ -46,6 +47,10 @@ public:
 	//! Load configuration.
 	void loadConfiguration();
 
+	//! Load configuration needed to evaluate schemes without windows:
+	//! application, DB, log, properties, colors and channels.
+	void loadHeadlessConfiguration();
+
 	//! Save configuration.
 	void saveConfiguration();
 
@@ -55,6 +60,20 @@ public:
 	//! \return Relative path for configuration files.
 	QString path() const;
 
+	//! \return Is configuration used without windows?
+	bool isHeadless() const;
+	//! Set headless mode. In this mode errors of the configuration
+	//! are not shown to the user but collected.
+	void setHeadless( bool on = true );
+
+	//! \return Errors and warnings collected in headless mode.
+	const QStringList & errors() const;
+
+	//! Show critical message, in headless mode collect it.
+	void critical( const QString & title, const QString & text );
+	//! Show warning message, in headless mode collect it.
+	void warning( const QString & title, const QString & text );
+
 private:
 	//! Read application's configuration.
 	void readAppCfg( const QString & cfgFileName );
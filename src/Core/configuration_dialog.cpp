@@ -210,27 +210,37 @@ ConfigurationDialog::newSettingsAccepted()
 		Log::instance().setSourcesLogDays(
 			d->m_ui.m_sourcesLogDays->value() );
 
-	SoundsCfg soundsCfg;
+	SoundsCfg soundsCfg = Sounds::instance().cfg();
+
+	soundsCfg.setCriticalSoundEnabled( d->m_ui.m_enableCriticalSound->isChecked() &&
+		!d->m_ui.m_criticalSoundLine->text().isEmpty() );
+
+	if( soundsCfg.isCriticalSoundEnabled() )
+		soundsCfg.setCriticalSoundFile( d->m_ui.m_criticalSoundLine->text() );
 
-	if( d->m_ui.m_enableCriticalSound->isChecked() &&
-		!d->m_ui.m_criticalSoundLine->text().isEmpty() )
-			soundsCfg.setCriticalSoundFile( d->m_ui.m_criticalSoundLine->text() );
+	soundsCfg.setErrorSoundEnabled( d->m_ui.m_enableErrorSound->isChecked() &&
+		!d->m_ui.m_errorSoundLine->text().isEmpty() );
 
-	if( d->m_ui.m_enableErrorSound->isChecked() &&
-		!d->m_ui.m_errorSoundLine->text().isEmpty() )
-			soundsCfg.setErrorSoundFile( d->m_ui.m_errorSoundLine->text() );
+	if( soundsCfg.isErrorSoundEnabled() )
+		soundsCfg.setErrorSoundFile( d->m_ui.m_errorSoundLine->text() );
 
-	if( d->m_ui.m_enableWarningSound->isChecked() &&
-		!d->m_ui.m_warningSoundLine->text().isEmpty() )
-			soundsCfg.setWarningSoundFile( d->m_ui.m_warningSoundLine->text() );
+	soundsCfg.setWarningSoundEnabled( d->m_ui.m_enableWarningSound->isChecked() &&
+		!d->m_ui.m_warningSoundLine->text().isEmpty() );
 
-	if( d->m_ui.m_enableDebugSound->isChecked() &&
-		!d->m_ui.m_debugSoundLine->text().isEmpty() )
-			soundsCfg.setDebugSoundFile( d->m_ui.m_debugSoundLine->text() );
+	if( soundsCfg.isWarningSoundEnabled() )
+		soundsCfg.setWarningSoundFile( d->m_ui.m_warningSoundLine->text() );
 
-	if( d->m_ui.m_enableInfoSound->isChecked() &&
-		!d->m_ui.m_infoSoundLine->text().isEmpty() )
-			soundsCfg.setInfoSoundFile( d->m_ui.m_infoSoundLine->text() );
+	soundsCfg.setDebugSoundEnabled( d->m_ui.m_enableDebugSound->isChecked() &&
+		!d->m_ui.m_debugSoundLine->text().isEmpty() );
+
+	if( soundsCfg.isDebugSoundEnabled() )
+		soundsCfg.setDebugSoundFile( d->m_ui.m_debugSoundLine->text() );
+
+	soundsCfg.setInfoSoundEnabled( d->m_ui.m_enableInfoSound->isChecked() &&
+		!d->m_ui.m_infoSoundLine->text().isEmpty() );
+
+	if( soundsCfg.isInfoSoundEnabled() )
+		soundsCfg.setInfoSoundFile( d->m_ui.m_infoSoundLine->text() );
 
 	Sounds::instance().setCfg( soundsCfg );
 
@@ -17,6 +17,7 @@
 // Qt include.
 #include <QMessageBox>
 #include <QFileInfo>
+#include <QSqlQuery>
 #include <QCoreApplication>
 
 
@@ -43,6 +44,8 @@ public:
 	QSqlDatabase m_connection;
 	//! File name of the DB file.
 	QString m_dbFileName;
+	//! Configuration.
+	DBCfg m_cfg;
 }; // class DBPrivate
 
 
@@ -96,9 +99,24 @@ DB::connection() const
 	return d->m_connection;
 }
 
+const DBCfg &
+DB::cfg() const
+{
+	return d->m_cfg;
+}
+
+QString
+DB::dbDirPath() const
+{
+	return QFileInfo( Configuration::instance().path() + d->m_dbFileName )
+		.absolutePath();
+}
+
 void
 DB::setCfg( const DBCfg & cfg )
 {
+	d->m_cfg = cfg;
+
 	if( !cfg.dbFileName().isEmpty() )
 		init( cfg.dbFileName() );
 	else
@@ -137,7 +155,7 @@ DB::readCfg( const QString & fileName )
 					"%2" )
 						.arg( fileName, x.desc() ) );
 
-			QMessageBox::critical( 0,
+			Configuration::instance().critical(
 				tr( "Unable to read DB configuration..." ),
 				tr( "%1\n\nDefault database will be used: \"%2\"." )
 					.arg( x.desc(), Configuration::instance().path() + defaultDbFile )
@@ -158,7 +176,7 @@ DB::readCfg( const QString & fileName )
 				"Unable to open file." )
 					.arg( fileName ) );
 
-		QMessageBox::critical( 0,
+		Configuration::instance().critical(
 			tr( "Unable to read DB configuration..." ),
 			tr( "Unable to open file \"%1\".\n\n"
 				"Default database will be used: \"%2\"." )
@@ -181,7 +199,7 @@ DB::saveCfg( const QString & fileName )
 	if( file.open( QIODevice::WriteOnly ) )
 	{
 		try {
-			DBCfg cfg;
+			DBCfg cfg = d->m_cfg;
 			cfg.setDbFileName( d->m_dbFileName );
 
 			DBTag tag( cfg );
@@ -252,6 +270,12 @@ DB::init( const QString & dbFileName )
 	}
 	else
 	{
+		// In WAL mode readers, LogViewer for example, never block
+		// writing to the logs.
+		QSqlQuery pragma( d->m_connection );
+		pragma.exec( QLatin1String( "PRAGMA journal_mode = WAL" ) );
+		pragma.exec( QLatin1String( "PRAGMA synchronous = NORMAL" ) );
+
 		d->m_isReady = true;
 
 		Log::instance().writeMsgToEventLog( LogLevelInfo,
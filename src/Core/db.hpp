@@ -53,9 +53,14 @@ public:
 	//! \return Connection.
 	const QSqlDatabase & connection() const;
 
+	//! \return Configuration of the DB.
+	const DBCfg & cfg() const;
 	//! Set configuration of the DB.
 	void setCfg( const DBCfg & cfg );
 
+	//! \return Full path of the directory with the DB file.
+	QString dbDirPath() const;
+
 	//! Read configuration.
 	void readCfg( const QString & fileName );
 	//! Write configuration.
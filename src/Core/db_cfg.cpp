@@ -15,11 +15,13 @@ namespace Globe {
 //
 
 DBCfg::DBCfg()
+	:	m_sourcesLogBackend( SqliteSourcesLogBackendType )
 {
 }
 
 DBCfg::DBCfg( const DBCfg & other )
 	:	m_dbFileName( other.dbFileName() )
+	,	m_sourcesLogBackend( other.sourcesLogBackend() )
 {
 }
 
@@ -29,6 +31,7 @@ DBCfg::operator =( const DBCfg & other )
 	if( this != &other )
 	{
 		m_dbFileName = other.dbFileName();
+		m_sourcesLogBackend = other.sourcesLogBackend();
 	}
 
 	return *this;
@@ -46,25 +49,56 @@ DBCfg::setDbFileName( const QString & fileName )
 	m_dbFileName = fileName;
 }
 
+SourcesLogBackendType
+DBCfg::sourcesLogBackend() const
+{
+	return m_sourcesLogBackend;
+}
+
+void
+DBCfg::setSourcesLogBackend( SourcesLogBackendType type )
+{
+	m_sourcesLogBackend = type;
+}
+
 
 //
 // DBTag
 //
 
+static const QString sqliteSourcesLogBackend = QLatin1String( "sqlite" );
+static const QString segmentsSourcesLogBackend = QLatin1String( "segments" );
+
 DBTag::DBTag()
 	:	cfgfile::tag_no_value_t< cfgfile::qstring_trait_t > (
 			QLatin1String( "dbCfg" ), true )
 	,	m_dbFileName( *this, QLatin1String( "dbFileName" ), true )
+	,	m_sourcesLogBackend( *this, QLatin1String( "sourcesLogBackend" ),
+			false )
 {
+	m_sourcesLogBackendConstraint.add_value( sqliteSourcesLogBackend );
+	m_sourcesLogBackendConstraint.add_value( segmentsSourcesLogBackend );
+
+	m_sourcesLogBackend.set_constraint( &m_sourcesLogBackendConstraint );
 }
 
 DBTag::DBTag( const DBCfg & cfg )
 	:	cfgfile::tag_no_value_t< cfgfile::qstring_trait_t > (
 			QLatin1String( "dbCfg" ), true )
 	,	m_dbFileName( *this, QLatin1String( "dbFileName" ), true )
+	,	m_sourcesLogBackend( *this, QLatin1String( "sourcesLogBackend" ),
+			false )
 {
+	m_sourcesLogBackendConstraint.add_value( sqliteSourcesLogBackend );
+	m_sourcesLogBackendConstraint.add_value( segmentsSourcesLogBackend );
+
+	m_sourcesLogBackend.set_constraint( &m_sourcesLogBackendConstraint );
+
 	m_dbFileName.set_value( cfg.dbFileName() );
 
+	if( cfg.sourcesLogBackend() == SegmentsSourcesLogBackendType )
+		m_sourcesLogBackend.set_value( segmentsSourcesLogBackend );
+
 	set_defined();
 }
 
@@ -75,6 +109,10 @@ DBTag::cfg() const
 
 	cfg.setDbFileName( m_dbFileName.value() );
 
+	if( m_sourcesLogBackend.is_defined() &&
+		m_sourcesLogBackend.value() == segmentsSourcesLogBackend )
+			cfg.setSourcesLogBackend( SegmentsSourcesLogBackendType );
+
 	return cfg;
 }
 
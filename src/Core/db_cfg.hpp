@@ -16,6 +16,19 @@
 
 namespace Globe {
 
+//
+// SourcesLogBackendType
+//
+
+//! Type of the storage of the source's log.
+enum SourcesLogBackendType {
+	//! Tables in the SQLite DB.
+	SqliteSourcesLogBackendType = 0,
+	//! Compressed append-only segment files near the DB.
+	SegmentsSourcesLogBackendType = 1
+}; // enum SourcesLogBackendType
+
+
 //
 // DBCfg
 //
@@ -34,9 +47,16 @@ public:
 	//! Set name of the DB file.
 	void setDbFileName( const QString & fileName );
 
+	//! \return Type of the storage of the source's log.
+	SourcesLogBackendType sourcesLogBackend() const;
+	//! Set type of the storage of the source's log.
+	void setSourcesLogBackend( SourcesLogBackendType type );
+
 private:
 	//! Name of the DB file.
 	QString m_dbFileName;
+	//! Type of the storage of the source's log.
+	SourcesLogBackendType m_sourcesLogBackend;
 }; // class DBCfg
 
 
@@ -59,6 +79,10 @@ public:
 private:
 	//! Name of the DB file.
 	cfgfile::tag_scalar_t< QString, cfgfile::qstring_trait_t > m_dbFileName;
+	//! Type of the storage of the source's log.
+	cfgfile::tag_scalar_t< QString, cfgfile::qstring_trait_t > m_sourcesLogBackend;
+	//! Constraint for the type of the storage of the source's log.
+	cfgfile::constraint_one_of_t< QString > m_sourcesLogBackendConstraint;
 }; // class DBTag
 
 } /* namespace Globe */
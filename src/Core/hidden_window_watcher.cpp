@@ -0,0 +1,50 @@
+
+/*
+	SPDX-FileCopyrightText: 2012-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// Globe include.
+#include <Core/hidden_window_watcher.hpp>
+#include <Core/utils.hpp>
+
+// Qt include.
+#include <QWidget>
+#include <QEvent>
+
+
+namespace Globe {
+
+//
+// HiddenWindowWatcher
+//
+
+HiddenWindowWatcher::HiddenWindowWatcher( QWidget * window )
+	:	QObject( window )
+	,	m_window( window )
+{
+	window->installEventFilter( this );
+}
+
+bool
+HiddenWindowWatcher::eventFilter( QObject * obj, QEvent * event )
+{
+	if( obj == m_window )
+	{
+		switch( event->type() )
+		{
+			case QEvent::Show :
+			case QEvent::Hide :
+			case QEvent::WindowStateChange :
+				emit hiddenChanged( isWindowHidden( m_window ) );
+				break;
+
+			default :
+				break;
+		}
+	}
+
+	return QObject::eventFilter( obj, event );
+}
+
+} /* namespace Globe */
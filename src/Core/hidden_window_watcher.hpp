@@ -0,0 +1,54 @@
+
+/*
+	SPDX-FileCopyrightText: 2012-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#ifndef GLOBE__HIDDEN_WINDOW_WATCHER_HPP__INCLUDED
+#define GLOBE__HIDDEN_WINDOW_WATCHER_HPP__INCLUDED
+
+// Qt include.
+#include <QObject>
+
+QT_BEGIN_NAMESPACE
+class QWidget;
+QT_END_NAMESPACE
+
+// Globe include.
+#include <Core/export.hpp>
+
+
+namespace Globe {
+
+//
+// HiddenWindowWatcher
+//
+
+/*!
+	Watches show, hide and state changes of the window and notifies
+	when window becomes hidden or minimized and when it's shown again,
+	so content of the window can pause updates while nobody sees it.
+*/
+class CORE_EXPORT HiddenWindowWatcher
+	:	public QObject
+{
+	Q_OBJECT
+
+signals:
+	//! Window was hidden or minimized (true) or shown (false).
+	void hiddenChanged( bool hidden );
+
+public:
+	explicit HiddenWindowWatcher( QWidget * window );
+
+protected:
+	bool eventFilter( QObject * obj, QEvent * event ) override;
+
+private:
+	//! Window.
+	QWidget * m_window;
+}; // class HiddenWindowWatcher
+
+} /* namespace Globe */
+
+#endif // GLOBE__HIDDEN_WINDOW_WATCHER_HPP__INCLUDED
@@ -14,11 +14,21 @@
 #include <QTimer>
 #include <QCoreApplication>
 #include <QFile>
+#include <QHash>
+#include <QTime>
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QVariantList>
 
 // Globe include.
 #include <Core/log.hpp>
 #include <Core/db.hpp>
 #include <Core/log_cfg.hpp>
+#include <Core/db_cfg.hpp>
+#include <Core/sources_log_sqlite_backend.hpp>
+#include <Core/sources_log_segments_backend.hpp>
+#include <Core/log_event_search.hpp>
+#include <Core/configuration.hpp>
 
 // cfgfile include.
 #include <cfgfile/all.hpp>
@@ -107,16 +117,181 @@ public:
 }; // struct EventLogRecord
 
 
+//! Max count of event's log messages waiting for writing to the DB.
+static const int maxQueuedEventMessages = 10000;
+
+//! Count of event's log messages that are written without waiting
+//! for the timer.
+static const int eventLogBatchSize = 256;
+
+//! Interval of writing of the queued event's log messages in msecs.
+static const int eventLogFlushInterval = 500;
+
+
 //
-// dateTimeToString
+// Source's log rollups.
 //
 
-static inline QString dateTimeToString( const QDateTime & dt )
+//! Table with one minute rollups of the source's log.
+static const QString sourcesLogMinuteRollupTable =
+	QLatin1String( "sourcesLogRollup1m" );
+
+//! Table with one hour rollups of the source's log.
+static const QString sourcesLogHourRollupTable =
+	QLatin1String( "sourcesLogRollup1h" );
+
+//! Columns of the rollup of the source's log in the order of the raw log.
+static const QString sourcesLogRollupColumns = QLatin1String(
+	"dateTime, channelName, type, sourceName, typeName, "
+	"sumValue / count AS value, desc, minValue, maxValue, count, lastValue" );
+
+//! \return Start of the rollup's bucket with the given size in seconds.
+static inline QDateTime sourcesLogRollupBucket( const QDateTime & dt,
+	int secs )
+{
+	const int start = ( dt.time().msecsSinceStartOfDay() / 1000 / secs ) *
+		secs;
+
+	return QDateTime( dt.date(), QTime( 0, 0 ).addSecs( start ) );
+}
+
+//! \return Is source with the given type a numeric one?
+static inline bool isNumericSource( Como::Source::Type type )
+{
+	return ( type >= Como::Source::Int && type <= Como::Source::Double );
+}
+
+
+//
+// SourcesLogKey
+//
+
+//! Key of the source in the source's log.
+struct SourcesLogKey {
+	SourcesLogKey()
+	{
+	}
+
+	SourcesLogKey( const QString & channelName,
+		const QString & sourceName,
+		const QString & typeName )
+		:	m_channelName( channelName )
+		,	m_sourceName( sourceName )
+		,	m_typeName( typeName )
+	{
+	}
+
+	//! Channel name.
+	QString m_channelName;
+	//! Source name.
+	QString m_sourceName;
+	//! Type name.
+	QString m_typeName;
+}; // struct SourcesLogKey
+
+static inline bool operator == ( const SourcesLogKey & k1,
+	const SourcesLogKey & k2 )
+{
+	return ( k1.m_channelName == k2.m_channelName &&
+		k1.m_sourceName == k2.m_sourceName &&
+		k1.m_typeName == k2.m_typeName );
+}
+
+static inline size_t qHash( const SourcesLogKey & key, size_t seed = 0 )
 {
-	return dt.toString( QLatin1String( "yyyy-MM-dd hh:mm:ss.zzz" ) );
+	return qHashMulti( seed, key.m_channelName, key.m_sourceName,
+		key.m_typeName );
 }
 
 
+//
+// SourcesLogLastRecord
+//
+
+//! Last value of the source written to the source's log.
+struct SourcesLogLastRecord {
+	SourcesLogLastRecord()
+		:	m_policy( -1 )
+		,	m_number( 0.0 )
+		,	m_isNumber( false )
+	{
+	}
+
+	//! Index of the policy of the source's log.
+	int m_policy;
+	//! Value.
+	QString m_value;
+	//! Numeric value.
+	double m_number;
+	//! Is value numeric?
+	bool m_isNumber;
+	//! Date and time of the value.
+	QDateTime m_dateTime;
+}; // struct SourcesLogLastRecord
+
+
+//
+// SourcesLogRollup
+//
+
+//! Not yet flushed part of the rollup's bucket of one source.
+struct SourcesLogRollup {
+	SourcesLogRollup()
+		:	m_type( Como::Source::Int )
+		,	m_min( 0.0 )
+		,	m_max( 0.0 )
+		,	m_sum( 0.0 )
+		,	m_count( 0 )
+	{
+	}
+
+	//! Start of the bucket.
+	QDateTime m_bucket;
+	//! Type of the source.
+	Como::Source::Type m_type;
+	//! Min value.
+	double m_min;
+	//! Max value.
+	double m_max;
+	//! Sum of values.
+	double m_sum;
+	//! Count of values.
+	qint64 m_count;
+	//! Last value.
+	QString m_last;
+	//! Last description.
+	QString m_desc;
+}; // struct SourcesLogRollup
+
+
+//
+// SourcesLogFinishedRollup
+//
+
+//! Finished bucket of the rollup waiting for writing to the DB.
+struct SourcesLogFinishedRollup {
+	SourcesLogFinishedRollup()
+		:	m_resolution( SourcesLogMinuteResolution )
+	{
+	}
+
+	SourcesLogFinishedRollup( SourcesLogResolution resolution,
+		const SourcesLogKey & key, const SourcesLogRollup & rollup )
+		:	m_resolution( resolution )
+		,	m_key( key )
+		,	m_rollup( rollup )
+	{
+	}
+
+	//! Resolution.
+	SourcesLogResolution m_resolution;
+	//! Key of the source.
+	SourcesLogKey m_key;
+	//! Rollup.
+	SourcesLogRollup m_rollup;
+}; // struct SourcesLogFinishedRollup
+
+
 //
 // LogPrivate
 //
@@ -127,6 +302,10 @@ public:
 		:	m_dbState( UnknownDBState )
 		,	m_logState( UninitializedLogState )
 		,	m_timer( 0 )
+		,	m_rollupTimer( 0 )
+		,	m_eventLogTimer( 0 )
+		,	m_droppedEventMessages( 0 )
+		,	m_hasEventLogSearchIndex( false )
 	{
 	}
 
@@ -134,18 +313,466 @@ public:
 	{
 	}
 
+	//! Prepare statement to insert into the event's log.
+	void prepareEventLogInsert();
+	//! Queue message for writing to the event's log.
+	void queueEventMessage( const EventLogRecord & record );
+	//! Write queued messages to the event's log in one transaction.
+	void flushEventLog();
+	//! Create backend of the source's log and tables of rollups.
+	void initSourcesLog();
+	//! Select records from the source's log. Invalid \a from or \a to
+	//! means no limit.
+	SourcesLogCursor selectFromSourcesLog( const QDateTime & from,
+		const QDateTime & to,
+		const QString & channelName,
+		const QString & sourceName,
+		const QString & typeName,
+		SourcesLogResolution resolution );
+	//! Add value to the rollups of the source's log.
+	void addToSourcesLogRollups( const QDateTime & dateTime,
+		const QString & channelName,
+		Como::Source::Type type,
+		const QString & sourceName,
+		const QString & typeName,
+		double value,
+		const QString & valueString,
+		const QString & desc );
+	//! Add value to the rollups of the given resolution.
+	void addToSourcesLogRollup( QHash< SourcesLogKey, SourcesLogRollup > & rollups,
+		SourcesLogResolution resolution,
+		const SourcesLogKey & key,
+		const QDateTime & dateTime,
+		Como::Source::Type type,
+		double value,
+		const QString & valueString,
+		const QString & desc );
+	//! Prepare statement to merge the rollup into the table of the
+	//! given resolution.
+	static void prepareSourcesLogRollupUpsert( QSqlQuery & upsert,
+		SourcesLogResolution resolution );
+	//! Write not flushed part of the bucket to the DB.
+	//! \return Was it written?
+	static bool writeSourcesLogRollup( QSqlQuery & upsert,
+		const SourcesLogKey & key, const SourcesLogRollup & rollup );
+	//! Write finished buckets and not flushed parts of the current ones
+	//! to the DB in one transaction.
+	void flushSourcesLogRollups();
+	//! \return Should the value be written to the source's log
+	//! according to the policy?
+	bool isWritingToSourcesLogNeeded( const SourcesLogKey & key,
+		const QDateTime & dateTime,
+		bool isNumber,
+		double number,
+		const QString & value );
+
 	//! State of the DB.
 	DBState m_dbState;
 	//! Configuration.
 	LogCfg m_cfg;
 	//! State of  the log.
 	LogState m_logState;
-	//! Deferred event's log messages.
+	//! Event's log messages not yet written to the DB.
 	QVector< EventLogRecord > m_deferredEventMessages;
 	//! Timer.
 	QTimer * m_timer;
+	//! Storage of the raw records of the source's log.
+	QScopedPointer< SourcesLogBackend > m_sourcesLogBackend;
+	//! Not flushed one minute rollups.
+	QHash< SourcesLogKey, SourcesLogRollup > m_minuteRollups;
+	//! Not flushed one hour rollups.
+	QHash< SourcesLogKey, SourcesLogRollup > m_hourRollups;
+	//! Finished buckets not yet written to the DB.
+	QVector< SourcesLogFinishedRollup > m_finishedRollups;
+	//! Timer to flush rollups.
+	QTimer * m_rollupTimer;
+	//! Last values written to the source's log.
+	QHash< SourcesLogKey, SourcesLogLastRecord > m_lastSourcesLogRecords;
+	//! Statement to insert into the event's log.
+	QSqlQuery m_eventLogInsert;
+	//! Timer to write queued event's log messages.
+	QTimer * m_eventLogTimer;
+	//! Count of event's log messages dropped because of full queue.
+	qint64 m_droppedEventMessages;
+	//! Is there full-text index of the event's log?
+	bool m_hasEventLogSearchIndex;
 }; // class LogPrivate
 
+void
+LogPrivate::prepareEventLogInsert()
+{
+	m_eventLogInsert = QSqlQuery();
+
+	m_eventLogInsert.prepare( QLatin1String(
+		"INSERT INTO eventLog ( level, dateTime, msg ) "
+		"VALUES ( ?, ?, ? )" ) );
+}
+
+void
+LogPrivate::queueEventMessage( const EventLogRecord & record )
+{
+	if( m_deferredEventMessages.size() < maxQueuedEventMessages )
+		m_deferredEventMessages.push_back( record );
+	else
+		++m_droppedEventMessages;
+}
+
+void
+LogPrivate::flushEventLog()
+{
+	m_eventLogTimer->stop();
+
+	if( m_dbState != AllIsOkDBState || m_logState != ReadyLogState )
+		return;
+
+	if( m_droppedEventMessages > 0 )
+	{
+		m_deferredEventMessages.push_back( EventLogRecord( LogLevelWarning,
+			QDateTime::currentDateTime(),
+			QString( "%1 event's log messages were dropped because "
+				"the queue of the event's log was full." )
+					.arg( m_droppedEventMessages ) ) );
+
+		m_droppedEventMessages = 0;
+	}
+
+	if( m_deferredEventMessages.isEmpty() )
+		return;
+
+	QVariantList levels, dateTimes, messages;
+
+	for( const auto & r : std::as_const( m_deferredEventMessages ) )
+	{
+		levels.append( (int) r.m_level );
+		dateTimes.append( sourcesLogDateTimeToString( r.m_dateTime ) );
+		messages.append( r.m_message );
+	}
+
+	m_deferredEventMessages.clear();
+
+	QSqlDatabase db = QSqlDatabase::database();
+
+	const bool inTransaction = db.transaction();
+
+	m_eventLogInsert.addBindValue( levels );
+	m_eventLogInsert.addBindValue( dateTimes );
+	m_eventLogInsert.addBindValue( messages );
+
+	m_eventLogInsert.execBatch();
+
+	if( inTransaction )
+		db.commit();
+}
+
+void
+LogPrivate::initSourcesLog()
+{
+	if( m_sourcesLogBackend )
+		m_sourcesLogBackend->flush();
+
+	if( DB::instance().cfg().sourcesLogBackend() ==
+		SegmentsSourcesLogBackendType )
+			m_sourcesLogBackend.reset( new SegmentsSourcesLogBackend(
+				DB::instance().dbDirPath() + QLatin1String( "/sourcesLog" ) ) );
+	else
+		m_sourcesLogBackend.reset( new SqliteSourcesLogBackend );
+
+	m_sourcesLogBackend->init();
+
+	for( const auto & table : { sourcesLogMinuteRollupTable,
+		sourcesLogHourRollupTable } )
+	{
+		QSqlQuery create;
+
+		create.exec( QString( "CREATE TABLE IF NOT EXISTS %1 ( "
+			"dateTime TEXT, channelName TEXT, type INTEGER, sourceName TEXT, "
+			"typeName TEXT, minValue REAL, maxValue REAL, sumValue REAL, "
+			"count INTEGER, lastValue TEXT, desc TEXT, "
+			"PRIMARY KEY ( dateTime, channelName, sourceName, typeName ) )" )
+				.arg( table ) );
+	}
+}
+
+SourcesLogCursor
+LogPrivate::selectFromSourcesLog( const QDateTime & from,
+	const QDateTime & to,
+	const QString & channelName,
+	const QString & sourceName,
+	const QString & typeName,
+	SourcesLogResolution resolution )
+{
+	if( channelName.isEmpty() && sourceName.isEmpty() && typeName.isEmpty() )
+		return SourcesLogCursor();
+
+	if( !m_sourcesLogBackend )
+		return SourcesLogCursor();
+
+	if( resolution == SourcesLogRawResolution )
+		return m_sourcesLogBackend->select( from, to,
+			channelName, sourceName, typeName );
+
+	flushSourcesLogRollups();
+
+	QVariantList values;
+
+	// Bucket that contains the start of the period.
+	const QString where = sourcesLogCondition(
+		( from.isValid() ? sourcesLogRollupBucket( from, resolution ) :
+			QDateTime() ),
+		to, channelName, sourceName, typeName, values );
+
+	QSqlQuery select;
+	select.setForwardOnly( true );
+
+	select.prepare( QString( "SELECT %1 FROM %2 WHERE %3 ORDER BY dateTime" )
+		.arg( sourcesLogRollupColumns,
+			( resolution == SourcesLogHourResolution ?
+				sourcesLogHourRollupTable : sourcesLogMinuteRollupTable ),
+			where ) );
+
+	for( const auto & v : std::as_const( values ) )
+		select.addBindValue( v );
+
+	select.exec();
+
+	return SourcesLogCursor( select );
+}
+
+bool
+LogPrivate::isWritingToSourcesLogNeeded( const SourcesLogKey & key,
+	const QDateTime & dateTime,
+	bool isNumber,
+	double number,
+	const QString & value )
+{
+	if( m_cfg.sourcesLogPolicies().isEmpty() )
+		return true;
+
+	QHash< SourcesLogKey, SourcesLogLastRecord >::Iterator it =
+		m_lastSourcesLogRecords.find( key );
+
+	if( it == m_lastSourcesLogRecords.end() )
+	{
+		it = m_lastSourcesLogRecords.insert( key, SourcesLogLastRecord() );
+
+		it.value().m_policy = m_cfg.sourcesLogPolicyIndex(
+			key.m_channelName, key.m_typeName, key.m_sourceName );
+	}
+
+	SourcesLogLastRecord & last = it.value();
+
+	if( last.m_policy < 0 )
+		return true;
+
+	const SourcesLogPolicy & policy =
+		m_cfg.sourcesLogPolicies().at( last.m_policy );
+
+	bool needed = true;
+
+	if( last.m_dateTime.isValid() )
+	{
+		const bool hasDeadband = ( policy.absoluteDeadband() > 0.0 ||
+			policy.relativeDeadband() > 0.0 );
+
+		if( policy.maxInterval() > 0 &&
+			last.m_dateTime.secsTo( dateTime ) >= policy.maxInterval() )
+				needed = true;
+		else if( hasDeadband && isNumber && last.m_isNumber )
+			needed = ( qAbs( number - last.m_number ) >
+				qMax( policy.absoluteDeadband(),
+					policy.relativeDeadband() * qAbs( last.m_number ) ) );
+		else if( hasDeadband || policy.isOnChangeOnly() )
+			needed = ( value != last.m_value );
+	}
+
+	if( needed )
+	{
+		last.m_value = value;
+		last.m_number = number;
+		last.m_isNumber = isNumber;
+		last.m_dateTime = dateTime;
+	}
+
+	return needed;
+}
+
+void
+LogPrivate::addToSourcesLogRollups( const QDateTime & dateTime,
+	const QString & channelName,
+	Como::Source::Type type,
+	const QString & sourceName,
+	const QString & typeName,
+	double value,
+	const QString & valueString,
+	const QString & desc )
+{
+	const SourcesLogKey key( channelName, sourceName, typeName );
+
+	addToSourcesLogRollup( m_minuteRollups, SourcesLogMinuteResolution,
+		key, dateTime, type, value, valueString, desc );
+	addToSourcesLogRollup( m_hourRollups, SourcesLogHourResolution,
+		key, dateTime, type, value, valueString, desc );
+}
+
+void
+LogPrivate::addToSourcesLogRollup(
+	QHash< SourcesLogKey, SourcesLogRollup > & rollups,
+	SourcesLogResolution resolution,
+	const SourcesLogKey & key,
+	const QDateTime & dateTime,
+	Como::Source::Type type,
+	double value,
+	const QString & valueString,
+	const QString & desc )
+{
+	const QDateTime bucket = sourcesLogRollupBucket( dateTime, resolution );
+
+	QHash< SourcesLogKey, SourcesLogRollup >::Iterator it = rollups.find( key );
+
+	if( it == rollups.end() )
+		it = rollups.insert( key, SourcesLogRollup() );
+	else if( it.value().m_bucket != bucket && it.value().m_count > 0 )
+		m_finishedRollups.append( SourcesLogFinishedRollup( resolution,
+			key, it.value() ) );
+
+	SourcesLogRollup & r = it.value();
+
+	if( r.m_bucket != bucket )
+	{
+		r.m_bucket = bucket;
+		r.m_count = 0;
+	}
+
+	if( r.m_count == 0 )
+	{
+		r.m_min = value;
+		r.m_max = value;
+		r.m_sum = 0.0;
+	}
+
+	r.m_min = qMin( r.m_min, value );
+	r.m_max = qMax( r.m_max, value );
+	r.m_sum += value;
+	++r.m_count;
+	r.m_type = type;
+	r.m_last = valueString;
+	r.m_desc = desc;
+}
+
+void
+LogPrivate::prepareSourcesLogRollupUpsert( QSqlQuery & upsert,
+	SourcesLogResolution resolution )
+{
+	// Buckets are flushed by parts, so merge with already written part.
+	upsert.prepare( QString( "INSERT INTO %1 ( dateTime, channelName, type, "
+		"sourceName, typeName, minValue, maxValue, sumValue, count, "
+		"lastValue, desc ) VALUES ( ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ? ) "
+		"ON CONFLICT ( dateTime, channelName, sourceName, typeName ) "
+		"DO UPDATE SET type = excluded.type, "
+		"minValue = min( minValue, excluded.minValue ), "
+		"maxValue = max( maxValue, excluded.maxValue ), "
+		"sumValue = sumValue + excluded.sumValue, "
+		"count = count + excluded.count, "
+		"lastValue = excluded.lastValue, desc = excluded.desc" )
+			.arg( resolution == SourcesLogHourResolution ?
+				sourcesLogHourRollupTable : sourcesLogMinuteRollupTable ) );
+}
+
+bool
+LogPrivate::writeSourcesLogRollup( QSqlQuery & upsert,
+	const SourcesLogKey & key, const SourcesLogRollup & rollup )
+{
+	upsert.bindValue( 0, sourcesLogDateTimeToString( rollup.m_bucket ) );
+	upsert.bindValue( 1, key.m_channelName );
+	upsert.bindValue( 2, (int) rollup.m_type );
+	upsert.bindValue( 3, key.m_sourceName );
+	upsert.bindValue( 4, key.m_typeName );
+	upsert.bindValue( 5, rollup.m_min );
+	upsert.bindValue( 6, rollup.m_max );
+	upsert.bindValue( 7, rollup.m_sum );
+	upsert.bindValue( 8, rollup.m_count );
+	upsert.bindValue( 9, rollup.m_last );
+	upsert.bindValue( 10, rollup.m_desc );
+
+	return upsert.exec();
+}
+
+void
+LogPrivate::flushSourcesLogRollups()
+{
+	if( m_dbState != AllIsOkDBState || m_logState != ReadyLogState )
+		return;
+
+	m_sourcesLogBackend->flush();
+
+	if( m_finishedRollups.isEmpty() && m_minuteRollups.isEmpty() &&
+		m_hourRollups.isEmpty() )
+			return;
+
+	QSqlDatabase db = QSqlDatabase::database();
+
+	const bool inTransaction = db.transaction();
+
+	QSqlQuery minuteUpsert;
+	prepareSourcesLogRollupUpsert( minuteUpsert, SourcesLogMinuteResolution );
+
+	QSqlQuery hourUpsert;
+	prepareSourcesLogRollupUpsert( hourUpsert, SourcesLogHourResolution );
+
+	QString error;
+
+	// Not written buckets stay for the next flush.
+	QVector< SourcesLogFinishedRollup > failed;
+
+	for( const auto & r : std::as_const( m_finishedRollups ) )
+	{
+		QSqlQuery & upsert = ( r.m_resolution == SourcesLogHourResolution ?
+			hourUpsert : minuteUpsert );
+
+		if( !writeSourcesLogRollup( upsert, r.m_key, r.m_rollup ) )
+		{
+			error = upsert.lastError().text();
+
+			failed.append( r );
+		}
+	}
+
+	m_finishedRollups = failed;
+
+	for( auto it = m_minuteRollups.begin(), last = m_minuteRollups.end();
+		it != last; ++it )
+	{
+		if( it.value().m_count > 0 )
+		{
+			if( writeSourcesLogRollup( minuteUpsert, it.key(), it.value() ) )
+				it.value().m_count = 0;
+			else
+				error = minuteUpsert.lastError().text();
+		}
+	}
+
+	for( auto it = m_hourRollups.begin(), last = m_hourRollups.end();
+		it != last; ++it )
+	{
+		if( it.value().m_count > 0 )
+		{
+			if( writeSourcesLogRollup( hourUpsert, it.key(), it.value() ) )
+				it.value().m_count = 0;
+			else
+				error = hourUpsert.lastError().text();
+		}
+	}
+
+	if( inTransaction )
+		db.commit();
+
+	if( !error.isEmpty() )
+		Log::instance().writeMsgToEventLog( LogLevelError, QString(
+			"Unable to write rollups of the source's log, "
+			"they will be written later.\n"
+			"%1" )
+				.arg( error ) );
+}
 
 //
 // Log
@@ -183,58 +810,29 @@ Log::init()
 
 //	eventLogTableLevelIndexQuery.exec();
 
-	QSqlQuery sourcesLogTableQuery( QLatin1String(
-		"CREATE TABLE IF NOT EXISTS sourcesLog( dateTime TEXT, "
-		"channelName TEXT, type INTEGER, sourceName TEXT, "
-		"typeName TEXT, value TEXT, desc TEXT ) " ) );
-
-	sourcesLogTableQuery.exec();
-
-	QSqlQuery dateTimeIndexQuery( QLatin1String(
-		"CREATE INDEX IF NOT EXISTS sourcesLogDateTimeIdx "
-		"ON sourcesLog( dateTime )" ) );
-
-	dateTimeIndexQuery.exec();
-
-//	QSqlQuery channelNameIndexQuery( QLatin1String(
-//		"CREATE INDEX IF NOT EXISTS sourcesLogChannelNameIdx "
-//		"ON sourcesLog( channelName )" ) );
+	d->m_hasEventLogSearchIndex = createEventLogSearchIndex();
 
-//	channelNameIndexQuery.exec();
+	if( !d->m_hasEventLogSearchIndex )
+		writeMsgToEventLog( LogLevelWarning, QString(
+			"Full-text search in the event's log is not available, "
+			"SQLite is built without FTS5." ) );
 
-//	QSqlQuery typeIndexQuery( QLatin1String(
-//		"CREATE INDEX IF NOT EXISTS sourcesLogTypeIdx "
-//		"ON sourcesLog( type )" ) );
+	d->prepareEventLogInsert();
 
-//	typeIndexQuery.exec();
+	d->initSourcesLog();
 
-//	QSqlQuery sourceNameIndexQuery( QLatin1String(
-//		"CREATE INDEX IF NOT EXISTS sourcesLogSourceNameIdx "
-//		"ON sourcesLog( sourceName )" ) );
-
-//	sourceNameIndexQuery.exec();
-
-//	QSqlQuery typeNameIndexQuery( QLatin1String(
-//		"CREATE INDEX IF NOT EXISTS sourcesLogTypeNameIdx "
-//		"ON sourcesLog( typeName )" ) );
-
-//	typeNameIndexQuery.exec();
-
-	if( d->m_cfg.isEventLogEnabled() )
+	if( !d->m_cfg.isEventLogEnabled() )
 	{
-		for( int i = 0; i < d->m_deferredEventMessages.size(); ++i )
-		{
-			insertMsgIntoEventLog(
-				d->m_deferredEventMessages.at( i ).m_level,
-				d->m_deferredEventMessages.at( i ).m_dateTime,
-				d->m_deferredEventMessages.at( i ).m_message );
-		}
+		d->m_deferredEventMessages.clear();
+		d->m_droppedEventMessages = 0;
 	}
 
-	d->m_deferredEventMessages.clear();
-
 	d->m_logState = ReadyLogState;
 
+	d->flushEventLog();
+
+	d->m_rollupTimer->start( SourcesLogMinuteResolution * 1000 );
+
 	eraseSourcesLog();
 }
 
@@ -246,6 +844,23 @@ Log::privateInit()
 	connect( d->m_timer, &QTimer::timeout,
 		this, &Log::eraseSourcesLog );
 
+	d->m_rollupTimer = new QTimer( this );
+
+	connect( d->m_rollupTimer, &QTimer::timeout,
+		this, &Log::flushSourcesLog );
+
+	connect( qApp, &QCoreApplication::aboutToQuit,
+		this, &Log::flushSourcesLog );
+
+	d->m_eventLogTimer = new QTimer( this );
+	d->m_eventLogTimer->setSingleShot( true );
+
+	connect( d->m_eventLogTimer, &QTimer::timeout,
+		this, &Log::flushEventLog );
+
+	connect( qApp, &QCoreApplication::aboutToQuit,
+		this, &Log::flushEventLog );
+
 	connect( &DB::instance(), &DB::ready,
 		this, &Log::dbReady );
 
@@ -285,13 +900,17 @@ Log::writeMsgToEventLog( LogLevel level, const QDateTime & dateTime,
 		if( d->m_logState != ReadyLogState &&
 			d->m_dbState != ErrorInDBState )
 		{
-			d->m_deferredEventMessages.push_back(
-				EventLogRecord( level, dateTime, msg ) );
+			d->queueEventMessage( EventLogRecord( level, dateTime, msg ) );
 		}
 		else if( d->m_logState == ReadyLogState &&
 			d->m_dbState == AllIsOkDBState )
 		{
-			insertMsgIntoEventLog( level, dateTime, msg );
+			d->queueEventMessage( EventLogRecord( level, dateTime, msg ) );
+
+			if( d->m_deferredEventMessages.size() >= eventLogBatchSize )
+				d->flushEventLog();
+			else if( !d->m_eventLogTimer->isActive() )
+				d->m_eventLogTimer->start( eventLogFlushInterval );
 		}
 	}
 }
@@ -316,20 +935,25 @@ Log::writeMsgToSourcesLog( const QDateTime & dateTime,
 		if( d->m_logState == ReadyLogState &&
 			d->m_dbState == AllIsOkDBState )
 		{
-			QSqlQuery insert( QLatin1String(
-				"INSERT INTO sourcesLog ( dateTime, channelName, type, "
-				"sourceName, typeName, value, desc ) "
-				"VALUES ( ?, ?, ?, ?, ?, ?, ? )" ) );
-
-			insert.addBindValue( dateTimeToString( dateTime ) );
-			insert.addBindValue( channelName );
-			insert.addBindValue( (int) type );
-			insert.addBindValue( sourceName );
-			insert.addBindValue( typeName );
-			insert.addBindValue( value.toString() );
-			insert.addBindValue( desc );
-
-			insert.exec();
+			const QString valueString = value.toString();
+
+			bool isNumber = false;
+			const double number = value.toDouble( &isNumber );
+
+			isNumber = ( isNumber && isNumericSource( type ) );
+
+			// Rollups see every value, the policy thins raw records only.
+			if( isNumber )
+				d->addToSourcesLogRollups( dateTime, channelName, type,
+					sourceName, typeName, number, valueString, desc );
+
+			if( !d->isWritingToSourcesLogNeeded(
+				SourcesLogKey( channelName, sourceName, typeName ),
+				dateTime, isNumber, number, valueString ) )
+					return;
+
+			d->m_sourcesLogBackend->write( dateTime, channelName, type,
+				sourceName, typeName, valueString, desc );
 		}
 	}
 }
@@ -337,7 +961,11 @@ Log::writeMsgToSourcesLog( const QDateTime & dateTime,
 QSqlQuery
 Log::readAllEventLog()
 {
-	QSqlQuery select( QLatin1String(
+	d->flushEventLog();
+
+	QSqlQuery select;
+	select.setForwardOnly( true );
+	select.prepare( QLatin1String(
 		"SELECT * FROM eventLog ORDER BY dateTime" ) );
 
 	if( d->m_dbState == AllIsOkDBState )
@@ -350,14 +978,18 @@ QSqlQuery
 Log::readEventLog( const QDateTime & from,
 	const QDateTime & to )
 {
-	QSqlQuery select( QLatin1String(
+	d->flushEventLog();
+
+	QSqlQuery select;
+	select.setForwardOnly( true );
+	select.prepare( QLatin1String(
 		"SELECT * FROM eventLog WHERE dateTime BETWEEN "
 		"? AND ? ORDER BY dateTime" ) );
 
 	if( d->m_dbState == AllIsOkDBState )
 	{
-		select.addBindValue( dateTimeToString( from ) );
-		select.addBindValue( dateTimeToString( to ) );
+		select.addBindValue( sourcesLogDateTimeToString( from ) );
+		select.addBindValue( sourcesLogDateTimeToString( to ) );
 
 		select.exec();
 	}
@@ -368,13 +1000,17 @@ Log::readEventLog( const QDateTime & from,
 QSqlQuery
 Log::readEventLogTo( const QDateTime & to )
 {
-	QSqlQuery select( QLatin1String(
+	d->flushEventLog();
+
+	QSqlQuery select;
+	select.setForwardOnly( true );
+	select.prepare( QLatin1String(
 		"SELECT * FROM eventLog WHERE dateTime <= ? "
 		"ORDER BY dateTime" ) );
 
 	if( d->m_dbState == AllIsOkDBState )
 	{
-		select.addBindValue( dateTimeToString( to ) );
+		select.addBindValue( sourcesLogDateTimeToString( to ) );
 
 		select.exec();
 	}
@@ -385,13 +1021,17 @@ Log::readEventLogTo( const QDateTime & to )
 QSqlQuery
 Log::readEventLogFrom( const QDateTime & from )
 {
-	QSqlQuery select( QLatin1String(
+	d->flushEventLog();
+
+	QSqlQuery select;
+	select.setForwardOnly( true );
+	select.prepare( QLatin1String(
 		"SELECT * FROM eventLog WHERE dateTime >= ? "
 		"ORDER BY dateTime" ) );
 
 	if( d->m_dbState == AllIsOkDBState )
 	{
-		select.addBindValue( dateTimeToString( from ) );
+		select.addBindValue( sourcesLogDateTimeToString( from ) );
 
 		select.exec();
 	}
@@ -400,489 +1040,91 @@ Log::readEventLogFrom( const QDateTime & from )
 }
 
 QSqlQuery
+Log::searchEventLog( const QDateTime & from,
+	const QDateTime & to,
+	const QString & text,
+	LogLevel minLevel )
+{
+	d->flushEventLog();
+
+	if( d->m_dbState == AllIsOkDBState )
+		return Globe::searchEventLog( from, to, text, minLevel,
+			d->m_hasEventLogSearchIndex );
+	else
+		return QSqlQuery();
+}
+
+SourcesLogCursor
 Log::readSourcesLog( const QDateTime & from,
 	const QDateTime & to,
 	const QString & channelName,
 	const QString & sourceName,
-	const QString & typeName )
+	const QString & typeName,
+	SourcesLogResolution resolution )
 {
 	if( d->m_dbState == AllIsOkDBState )
-	{
-		if( !channelName.isEmpty() && !sourceName.isEmpty()
-			&& !typeName.isEmpty() )
-		{
-			QSqlQuery select( QLatin1String(
-				"SELECT * FROM sourcesLog WHERE dateTime BETWEEN "
-				"? AND ? AND channelName = ? AND sourceName = ? "
-				"AND typeName = ? ORDER BY dateTime" ) );
-
-			select.addBindValue( dateTimeToString( from ) );
-			select.addBindValue( dateTimeToString( to ) );
-			select.addBindValue( channelName );
-			select.addBindValue( sourceName );
-			select.addBindValue( typeName );
-
-			select.exec();
-
-			return select;
-		}
-		else if( channelName.isEmpty() && !sourceName.isEmpty()
-			&& !typeName.isEmpty() )
-		{
-			QSqlQuery select( QLatin1String(
-				"SELECT * FROM sourcesLog WHERE dateTime BETWEEN "
-				"? AND ? AND sourceName = ? AND typeName = ? "
-				"ORDER BY dateTime" ) );
-
-			select.addBindValue( dateTimeToString( from ) );
-			select.addBindValue( dateTimeToString( to ) );
-			select.addBindValue( sourceName );
-			select.addBindValue( typeName );
-
-			select.exec();
-
-			return select;
-		}
-		else if( !channelName.isEmpty() && sourceName.isEmpty()
-			&& !typeName.isEmpty() )
-		{
-			QSqlQuery select( QLatin1String(
-				"SELECT * FROM sourcesLog WHERE dateTime BETWEEN "
-				"? AND ? AND channelName = ? AND typeName = ? "
-				"ORDER BY dateTime" ) );
-
-			select.addBindValue( dateTimeToString( from ) );
-			select.addBindValue( dateTimeToString( to ) );
-			select.addBindValue( channelName );
-			select.addBindValue( typeName );
-
-			select.exec();
-
-			return select;
-		}
-		else if( !channelName.isEmpty() && !sourceName.isEmpty()
-			&& typeName.isEmpty() )
-		{
-			QSqlQuery select( QLatin1String(
-				"SELECT * FROM sourcesLog WHERE dateTime BETWEEN "
-				"? AND ? AND channelName = ? AND sourceName = ? "
-				"ORDER BY dateTime" ) );
-
-			select.addBindValue( dateTimeToString( from ) );
-			select.addBindValue( dateTimeToString( to ) );
-			select.addBindValue( channelName );
-			select.addBindValue( sourceName );
-
-			select.exec();
-
-			return select;
-		}
-		else if( channelName.isEmpty() && sourceName.isEmpty()
-			&& !typeName.isEmpty() )
-		{
-			QSqlQuery select( QLatin1String(
-				"SELECT * FROM sourcesLog WHERE dateTime BETWEEN "
-				"? AND ? AND typeName = ? ORDER BY dateTime" ) );
-
-			select.addBindValue( dateTimeToString( from ) );
-			select.addBindValue( dateTimeToString( to ) );
-			select.addBindValue( typeName );
-
-			select.exec();
-
-			return select;
-		}
-		else if( !channelName.isEmpty() && sourceName.isEmpty()
-			&& typeName.isEmpty() )
-		{
-			QSqlQuery select( QLatin1String(
-				"SELECT * FROM sourcesLog WHERE dateTime BETWEEN "
-				"? AND ? AND channelName = ? ORDER BY dateTime" ) );
-
-			select.addBindValue( dateTimeToString( from ) );
-			select.addBindValue( dateTimeToString( to ) );
-			select.addBindValue( channelName );
-
-			select.exec();
-
-			return select;
-		}
-		else if( channelName.isEmpty() && !sourceName.isEmpty()
-			&& typeName.isEmpty() )
-		{
-			QSqlQuery select( QLatin1String(
-				"SELECT * FROM sourcesLog WHERE dateTime BETWEEN "
-				"? AND ? AND sourceName = ? ORDER BY dateTime" ) );
-
-			select.addBindValue( dateTimeToString( from ) );
-			select.addBindValue( dateTimeToString( to ) );
-			select.addBindValue( sourceName );
-
-			select.exec();
-
-			return select;
-		}
-		else
-			return QSqlQuery();
-	}
+		return d->selectFromSourcesLog( from, to,
+			channelName, sourceName, typeName, resolution );
 	else
-		return QSqlQuery();
+		return SourcesLogCursor();
 }
 
-QSqlQuery
+SourcesLogCursor
 Log::readSourcesLogTo( const QDateTime & to,
 	const QString & channelName,
 	const QString & sourceName,
-	const QString & typeName )
+	const QString & typeName,
+	SourcesLogResolution resolution )
 {
 	if( d->m_dbState == AllIsOkDBState )
-	{
-		if( !channelName.isEmpty() && !sourceName.isEmpty()
-			&& !typeName.isEmpty() )
-		{
-			QSqlQuery select( QLatin1String(
-				"SELECT * FROM sourcesLog WHERE dateTime <= ? "
-				"AND channelName = ? AND sourceName = ? "
-				"AND typeName = ? ORDER BY dateTime" ) );
-
-			select.addBindValue( dateTimeToString( to ) );
-			select.addBindValue( channelName );
-			select.addBindValue( sourceName );
-			select.addBindValue( typeName );
-
-			select.exec();
-
-			return select;
-		}
-		else if( channelName.isEmpty() && !sourceName.isEmpty()
-			&& !typeName.isEmpty() )
-		{
-			QSqlQuery select( QLatin1String(
-				"SELECT * FROM sourcesLog WHERE dateTime <= ? "
-				"AND sourceName = ? AND typeName = ? "
-				"ORDER BY dateTime" ) );
-
-			select.addBindValue( dateTimeToString( to ) );
-			select.addBindValue( sourceName );
-			select.addBindValue( typeName );
-
-			select.exec();
-
-			return select;
-		}
-		else if( !channelName.isEmpty() && sourceName.isEmpty()
-			&& !typeName.isEmpty() )
-		{
-			QSqlQuery select( QLatin1String(
-				"SELECT * FROM sourcesLog WHERE dateTime <= ? "
-				"AND channelName = ? AND typeName = ? "
-				"ORDER BY dateTime" ) );
-
-			select.addBindValue( dateTimeToString( to ) );
-			select.addBindValue( channelName );
-			select.addBindValue( typeName );
-
-			select.exec();
-
-			return select;
-		}
-		else if( !channelName.isEmpty() && !sourceName.isEmpty()
-			&& typeName.isEmpty() )
-		{
-			QSqlQuery select( QLatin1String(
-				"SELECT * FROM sourcesLog WHERE dateTime <= ? "
-				"AND channelName = ? AND sourceName = ? "
-				"ORDER BY dateTime" ) );
-
-			select.addBindValue( dateTimeToString( to ) );
-			select.addBindValue( channelName );
-			select.addBindValue( sourceName );
-
-			select.exec();
-
-			return select;
-		}
-		else if( channelName.isEmpty() && sourceName.isEmpty()
-			&& !typeName.isEmpty() )
-		{
-			QSqlQuery select( QLatin1String(
-				"SELECT * FROM sourcesLog WHERE dateTime <= ? "
-				"AND typeName = ? ORDER BY dateTime" ) );
-
-			select.addBindValue( dateTimeToString( to ) );
-			select.addBindValue( typeName );
-
-			select.exec();
-
-			return select;
-		}
-		else if( !channelName.isEmpty() && sourceName.isEmpty()
-			&& typeName.isEmpty() )
-		{
-			QSqlQuery select( QLatin1String(
-				"SELECT * FROM sourcesLog WHERE dateTime <= ? "
-				"AND channelName = ? ORDER BY dateTime" ) );
-
-			select.addBindValue( dateTimeToString( to ) );
-			select.addBindValue( channelName );
-
-			select.exec();
-
-			return select;
-		}
-		else if( channelName.isEmpty() && !sourceName.isEmpty()
-			&& typeName.isEmpty() )
-		{
-			QSqlQuery select( QLatin1String(
-				"SELECT * FROM sourcesLog WHERE dateTime <= ? "
-				"AND sourceName = ? ORDER BY dateTime" ) );
-
-			select.addBindValue( dateTimeToString( to ) );
-			select.addBindValue( sourceName );
-
-			select.exec();
-
-			return select;
-		}
-		else
-			return QSqlQuery();
-	}
+		return d->selectFromSourcesLog( QDateTime(), to,
+			channelName, sourceName, typeName, resolution );
 	else
-		return QSqlQuery();
+		return SourcesLogCursor();
 }
 
-QSqlQuery
+SourcesLogCursor
 Log::readSourcesLogFrom( const QDateTime & from,
 	const QString & channelName,
 	const QString & sourceName,
-	const QString & typeName )
+	const QString & typeName,
+	SourcesLogResolution resolution )
 {
 	if( d->m_dbState == AllIsOkDBState )
-	{
-		if( !channelName.isEmpty() && !sourceName.isEmpty()
-			&& !typeName.isEmpty() )
-		{
-			QSqlQuery select( QLatin1String(
-				"SELECT * FROM sourcesLog WHERE dateTime >= ? "
-				"AND channelName = ? AND sourceName = ? "
-				"AND typeName = ? ORDER BY dateTime" ) );
-
-			select.addBindValue( dateTimeToString( from ) );
-			select.addBindValue( channelName );
-			select.addBindValue( sourceName );
-			select.addBindValue( typeName );
-
-			select.exec();
-
-			return select;
-		}
-		else if( channelName.isEmpty() && !sourceName.isEmpty()
-			&& !typeName.isEmpty() )
-		{
-			QSqlQuery select( QLatin1String(
-				"SELECT * FROM sourcesLog WHERE dateTime >= ? "
-				"AND sourceName = ? AND typeName = ? "
-				"ORDER BY dateTime" ) );
-
-			select.addBindValue( dateTimeToString( from ) );
-			select.addBindValue( sourceName );
-			select.addBindValue( typeName );
-
-			select.exec();
-
-			return select;
-		}
-		else if( !channelName.isEmpty() && sourceName.isEmpty()
-			&& !typeName.isEmpty() )
-		{
-			QSqlQuery select( QLatin1String(
-				"SELECT * FROM sourcesLog WHERE dateTime >= ? "
-				"AND channelName = ? AND typeName = ? "
-				"ORDER BY dateTime" ) );
-
-			select.addBindValue( dateTimeToString( from ) );
-			select.addBindValue( channelName );
-			select.addBindValue( typeName );
-
-			select.exec();
-
-			return select;
-		}
-		else if( !channelName.isEmpty() && !sourceName.isEmpty()
-			&& typeName.isEmpty() )
-		{
-			QSqlQuery select( QLatin1String(
-				"SELECT * FROM sourcesLog WHERE dateTime >= ? "
-				"AND channelName = ? AND sourceName = ? "
-				"ORDER BY dateTime" ) );
-
-			select.addBindValue( dateTimeToString( from ) );
-			select.addBindValue( channelName );
-			select.addBindValue( sourceName );
-
-			select.exec();
-
-			return select;
-		}
-		else if( channelName.isEmpty() && sourceName.isEmpty()
-			&& !typeName.isEmpty() )
-		{
-			QSqlQuery select( QLatin1String(
-				"SELECT * FROM sourcesLog WHERE dateTime >= ? "
-				"AND typeName = ? ORDER BY dateTime" ) );
-
-			select.addBindValue( dateTimeToString( from ) );
-			select.addBindValue( typeName );
-
-			select.exec();
-
-			return select;
-		}
-		else if( !channelName.isEmpty() && sourceName.isEmpty()
-			&& typeName.isEmpty() )
-		{
-			QSqlQuery select( QLatin1String(
-				"SELECT * FROM sourcesLog WHERE dateTime >= ? "
-				"AND channelName = ? ORDER BY dateTime" ) );
-
-			select.addBindValue( dateTimeToString( from ) );
-			select.addBindValue( channelName );
-
-			select.exec();
-
-			return select;
-		}
-		else if( channelName.isEmpty() && !sourceName.isEmpty()
-			&& typeName.isEmpty() )
-		{
-			QSqlQuery select( QLatin1String(
-				"SELECT * FROM sourcesLog WHERE dateTime >= ? "
-				"AND sourceName = ? ORDER BY dateTime" ) );
-
-			select.addBindValue( dateTimeToString( from ) );
-			select.addBindValue( sourceName );
-
-			select.exec();
-
-			return select;
-		}
-		else
-			return QSqlQuery();
-	}
+		return d->selectFromSourcesLog( from, QDateTime(),
+			channelName, sourceName, typeName, resolution );
 	else
-		return QSqlQuery();
+		return SourcesLogCursor();
 }
 
-QSqlQuery
+SourcesLogCursor
 Log::readAllSourcesLog( const QString & channelName,
 	const QString & sourceName,
-	const QString & typeName )
+	const QString & typeName,
+	SourcesLogResolution resolution )
 {
 	if( d->m_dbState == AllIsOkDBState )
-	{
-		if( !channelName.isEmpty() && !sourceName.isEmpty()
-			&& !typeName.isEmpty() )
-		{
-			QSqlQuery select( QLatin1String(
-				"SELECT * FROM sourcesLog WHERE channelName = ? "
-				"AND sourceName = ? AND typeName = ? "
-				"ORDER BY dateTime" ) );
-
-			select.addBindValue( channelName );
-			select.addBindValue( sourceName );
-			select.addBindValue( typeName );
-
-			select.exec();
-
-			return select;
-		}
-		else if( channelName.isEmpty() && !sourceName.isEmpty()
-			&& !typeName.isEmpty() )
-		{
-			QSqlQuery select( QLatin1String(
-				"SELECT * FROM sourcesLog WHERE "
-				"AND sourceName = ? AND typeName = ? "
-				"ORDER BY dateTime" ) );
-
-			select.addBindValue( sourceName );
-			select.addBindValue( typeName );
-
-			select.exec();
-
-			return select;
-		}
-		else if( !channelName.isEmpty() && sourceName.isEmpty()
-			&& !typeName.isEmpty() )
-		{
-			QSqlQuery select( QLatin1String(
-				"SELECT * FROM sourcesLog WHERE channelName = ? "
-				"AND typeName = ? ORDER BY dateTime" ) );
-
-			select.addBindValue( channelName );
-			select.addBindValue( typeName );
-
-			select.exec();
-
-			return select;
-		}
-		else if( !channelName.isEmpty() && !sourceName.isEmpty()
-			&& typeName.isEmpty() )
-		{
-			QSqlQuery select( QLatin1String(
-				"SELECT * FROM sourcesLog WHERE channelName = ? "
-				"AND sourceName = ? ORDER BY dateTime" ) );
-
-			select.addBindValue( channelName );
-			select.addBindValue( sourceName );
-
-			select.exec();
-
-			return select;
-		}
-		else if( channelName.isEmpty() && sourceName.isEmpty()
-			&& !typeName.isEmpty() )
-		{
-			QSqlQuery select( QLatin1String(
-				"SELECT * FROM sourcesLog WHERE "
-				"AND typeName = ? ORDER BY dateTime" ) );
-
-			select.addBindValue( typeName );
-
-			select.exec();
-
-			return select;
-		}
-		else if( !channelName.isEmpty() && sourceName.isEmpty()
-			&& typeName.isEmpty() )
-		{
-			QSqlQuery select( QLatin1String(
-				"SELECT * FROM sourcesLog WHERE channelName = ? "
-				"ORDER BY dateTime" ) );
-
-			select.addBindValue( channelName );
-
-			select.exec();
-
-			return select;
-		}
-		else if( channelName.isEmpty() && !sourceName.isEmpty()
-			&& typeName.isEmpty() )
-		{
-			QSqlQuery select( QLatin1String(
-				"SELECT * FROM sourcesLog WHERE "
-				"AND sourceName = ? ORDER BY dateTime" ) );
-
-			select.addBindValue( sourceName );
-
-			select.exec();
+		return d->selectFromSourcesLog( QDateTime(), QDateTime(),
+			channelName, sourceName, typeName, resolution );
+	else
+		return SourcesLogCursor();
+}
 
-			return select;
-		}
-		else
-			return QSqlQuery();
-	}
+SourcesLogResolution
+Log::sourcesLogResolution( qint64 secs )
+{
+	if( secs >= SourcesLogHourResolution )
+		return SourcesLogHourResolution;
+	else if( secs >= SourcesLogMinuteResolution )
+		return SourcesLogMinuteResolution;
 	else
-		return QSqlQuery();
+		return SourcesLogRawResolution;
+}
+
+bool
+Log::hasSourcesLogRollups( Como::Source::Type type )
+{
+	return isNumericSource( type );
 }
 
 const LogCfg &
@@ -929,7 +1171,7 @@ Log::readCfg( const QString & fileName )
 				"%2" )
 					.arg( fileName, x.desc() ) );
 
-			QMessageBox::critical( 0,
+			Configuration::instance().critical(
 				tr( "Unable to read log configuration..." ),
 				x.desc() );
 
@@ -945,7 +1187,7 @@ Log::readCfg( const QString & fileName )
 			"Unable to open file." )
 				.arg( fileName ) );
 
-		QMessageBox::critical( 0,
+		Configuration::instance().critical(
 			tr( "Unable to read log configuration..." ),
 			tr( "Unable to open file \"%1\"." ).arg( fileName ) );
 
@@ -955,6 +1197,7 @@ Log::readCfg( const QString & fileName )
 	}
 
 	d->m_cfg = tag.cfg();
+	d->m_lastSourcesLogRecords.clear();
 
 	d->m_logState = ConfigurationLoadedLogState;
 
@@ -1032,10 +1275,15 @@ Log::clearEventsLog()
 {
 	if( d->m_dbState == AllIsOkDBState )
 	{
+		d->m_deferredEventMessages.clear();
+		d->m_droppedEventMessages = 0;
+
 		QSqlQuery deleteQuery( QLatin1String(
 			"DELETE FROM eventLog" ) )	;
 
 		deleteQuery.exec();
+
+		clearEventLogSearchIndex();
 	}
 }
 
@@ -1044,10 +1292,20 @@ Log::clearSourcesLog()
 {
 	if( d->m_dbState == AllIsOkDBState )
 	{
-		QSqlQuery deleteQuery( QLatin1String(
-			"DELETE FROM sourcesLog" ) )	;
+		if( d->m_sourcesLogBackend )
+			d->m_sourcesLogBackend->clear();
 
-		deleteQuery.exec();
+		d->m_minuteRollups.clear();
+		d->m_hourRollups.clear();
+		d->m_finishedRollups.clear();
+
+		for( const auto & table : { sourcesLogMinuteRollupTable,
+			sourcesLogHourRollupTable } )
+		{
+			QSqlQuery deleteQuery;
+
+			deleteQuery.exec( QString( "DELETE FROM %1" ).arg( table ) );
+		}
 	}
 }
 
@@ -1055,37 +1313,50 @@ void
 Log::eraseSourcesLog()
 {
 	static const int msecsInDay = 24 * 60 * 60 * 1000;
+	// Partitions held by the open log windows are dropped by retries.
+	static const int msecsToRetry = 60 * 1000;
 
 	d->m_timer->stop();
 
-	QDateTime from = QDateTime::currentDateTime();
+	bool done = true;
 
-	if( d->m_cfg.sourcesLogDays() > 0 )
-		from = from.addDays( -d->m_cfg.sourcesLogDays() );
+	const QDateTime from = ( d->m_cfg.sourcesLogDays() > 0 ?
+		QDateTime::currentDateTime().addDays( -d->m_cfg.sourcesLogDays() ) :
+		QDateTime::currentDateTime() );
 
-	QSqlQuery eraseQuery( QLatin1String(
-		"DELETE FROM sourcesLog WHERE dateTime < ?" ) );
+	// Whole days are dropped, the oldest day stays till the next pass.
+	// Ongoing log keeps only records since the start, so erase the
+	// beginning of the current day too.
+	if( d->m_sourcesLogBackend )
+		done = d->m_sourcesLogBackend->erase( from,
+			d->m_cfg.sourcesLogDays() > 0 );
 
-	eraseQuery.addBindValue( dateTimeToString( from ) );
+	for( const auto & table : { sourcesLogMinuteRollupTable,
+		sourcesLogHourRollupTable } )
+	{
+		QSqlQuery eraseQuery;
+		eraseQuery.prepare( QString( "DELETE FROM %1 WHERE dateTime < ?" )
+			.arg( table ) );
 
-	eraseQuery.exec();
+		eraseQuery.addBindValue( sourcesLogDateTimeToString(
+			sourcesLogRollupBucket( from, SourcesLogHourResolution ) ) );
 
-	d->m_timer->start( msecsInDay );
+		eraseQuery.exec();
+	}
+
+	d->m_timer->start( done ? msecsInDay : msecsToRetry );
 }
 
 void
-Log::insertMsgIntoEventLog( LogLevel level, const QDateTime & dateTime,
-	const QString & msg )
+Log::flushEventLog()
 {
-	QSqlQuery insert( QLatin1String(
-		"INSERT INTO eventLog ( level, dateTime, msg ) "
-		"VALUES ( ?, ?, ? )" ) );
-
-	insert.addBindValue( (int) level );
-	insert.addBindValue( dateTimeToString( dateTime ) );
-	insert.addBindValue( msg );
+	d->flushEventLog();
+}
 
-	insert.exec();
+void
+Log::flushSourcesLog()
+{
+	d->flushSourcesLogRollups();
 }
 
 void
@@ -1095,6 +1366,8 @@ Log::dbReady()
 
 	if( d->m_logState == ConfigurationLoadedLogState )
 		init();
+	else if( d->m_logState == ReadyLogState )
+		d->prepareEventLogInsert();
 }
 
 void
@@ -17,6 +17,7 @@
 
 // Globe include.
 #include <Core/export.hpp>
+#include <Core/sources_log_backend.hpp>
 
 
 QT_BEGIN_NAMESPACE
@@ -47,13 +48,29 @@ enum LogLevel {
 }; // enum LogLevel
 
 
+//
+// SourcesLogResolution
+//
+
+//! Resolution of the source's log. Records of rollups have
+//! additional columns: min, max, count and last value.
+enum SourcesLogResolution {
+	//! Raw records.
+	SourcesLogRawResolution = 0,
+	//! One minute buckets with min/max/avg/count/last per source.
+	SourcesLogMinuteResolution = 60,
+	//! One hour buckets with min/max/avg/count/last per source.
+	SourcesLogHourResolution = 3600
+}; // enum SourcesLogResolution
+
+
 //
 // Log
 //
 
 class LogPrivate;
 
-//! Log.
+//! Log. Selects from the logs are forward only.
 class CORE_EXPORT Log
 	:	public QObject
 {
@@ -86,26 +103,43 @@ public:
 	QSqlQuery readEventLogTo( const QDateTime & to );
 	//! Read event's log from the given time to the end.
 	QSqlQuery readEventLogFrom( const QDateTime & from );
+	//! Search in the event's log for the given period of time.
+	//! Records with the \a text are ordered by relevance.
+	QSqlQuery searchEventLog( const QDateTime & from,
+		const QDateTime & to,
+		const QString & text,
+		LogLevel minLevel = LogLevelInfo );
 	//! Read source's log for the given period of time.
-	QSqlQuery readSourcesLog( const QDateTime & from,
+	SourcesLogCursor readSourcesLog( const QDateTime & from,
 		const QDateTime & to,
 		const QString & channelName = QString(),
 		const QString & sourceName = QString(),
-		const QString & typeName = QString() );
+		const QString & typeName = QString(),
+		SourcesLogResolution resolution = SourcesLogRawResolution );
 	//! Read source's log from the beginning to the given time.
-	QSqlQuery readSourcesLogTo( const QDateTime & to,
+	SourcesLogCursor readSourcesLogTo( const QDateTime & to,
 		const QString & channelName = QString(),
 		const QString & sourceName = QString(),
-		const QString & typeName = QString() );
+		const QString & typeName = QString(),
+		SourcesLogResolution resolution = SourcesLogRawResolution );
 	//! Read source's log from the given time to the end.
-	QSqlQuery readSourcesLogFrom( const QDateTime & from,
+	SourcesLogCursor readSourcesLogFrom( const QDateTime & from,
 		const QString & channelName = QString(),
 		const QString & sourceName = QString(),
-		const QString & typeName = QString() );
+		const QString & typeName = QString(),
+		SourcesLogResolution resolution = SourcesLogRawResolution );
 	//! Read all records from the source's log.
-	QSqlQuery readAllSourcesLog( const QString & channelName = QString(),
+	SourcesLogCursor readAllSourcesLog( const QString & channelName = QString(),
 		const QString & sourceName = QString(),
-		const QString & typeName = QString() );
+		const QString & typeName = QString(),
+		SourcesLogResolution resolution = SourcesLogRawResolution );
+
+	//! \return Coarsest resolution of the source's log that still
+	//! has records not rarer than the given interval in seconds.
+	static SourcesLogResolution sourcesLogResolution( qint64 secs );
+	//! \return Are there rollups of the source's log for the sources
+	//! of the given type? Rollups exist only for numeric sources.
+	static bool hasSourcesLogRollups( Como::Source::Type type );
 
 	//! \return Configuration of the log.
 	const LogCfg & cfg() const;
@@ -142,10 +176,6 @@ private:
 	//! Private initialization.
 	void privateInit();
 
-	//! Insert record into event's log.
-	void insertMsgIntoEventLog( LogLevel level, const QDateTime & dateTime,
-		const QString & msg );
-
 private slots:
 	//! DB is ready.
 	void dbReady();
@@ -153,6 +183,10 @@ private slots:
 	void dbError();
 	//! Erase outdated recrods from source's log.
 	void eraseSourcesLog();
+	//! Flush buffered records and rollups of the source's log.
+	void flushSourcesLog();
+	//! Write queued messages to the event's log.
+	void flushEventLog();
 
 private:
 	Q_DISABLE_COPY( Log )
@@ -10,6 +10,149 @@
 
 namespace Globe {
 
+//
+// SourcesLogPolicy
+//
+
+SourcesLogPolicy::SourcesLogPolicy()
+	:	m_isOnChangeOnly( false )
+	,	m_absoluteDeadband( 0.0 )
+	,	m_relativeDeadband( 0.0 )
+	,	m_maxInterval( 0 )
+{
+}
+
+SourcesLogPolicy::SourcesLogPolicy( const SourcesLogPolicy & other )
+	:	m_channelName( other.channelName() )
+	,	m_typeName( other.typeName() )
+	,	m_sourceName( other.sourceName() )
+	,	m_isOnChangeOnly( other.isOnChangeOnly() )
+	,	m_absoluteDeadband( other.absoluteDeadband() )
+	,	m_relativeDeadband( other.relativeDeadband() )
+	,	m_maxInterval( other.maxInterval() )
+{
+}
+
+SourcesLogPolicy &
+SourcesLogPolicy::operator = ( const SourcesLogPolicy & other )
+{
+	if( this != &other )
+	{
+		m_channelName = other.channelName();
+		m_typeName = other.typeName();
+		m_sourceName = other.sourceName();
+		m_isOnChangeOnly = other.isOnChangeOnly();
+		m_absoluteDeadband = other.absoluteDeadband();
+		m_relativeDeadband = other.relativeDeadband();
+		m_maxInterval = other.maxInterval();
+	}
+
+	return *this;
+}
+
+const QString &
+SourcesLogPolicy::channelName() const
+{
+	return m_channelName;
+}
+
+void
+SourcesLogPolicy::setChannelName( const QString & name )
+{
+	m_channelName = name;
+}
+
+const QString &
+SourcesLogPolicy::typeName() const
+{
+	return m_typeName;
+}
+
+void
+SourcesLogPolicy::setTypeName( const QString & name )
+{
+	m_typeName = name;
+}
+
+const QString &
+SourcesLogPolicy::sourceName() const
+{
+	return m_sourceName;
+}
+
+void
+SourcesLogPolicy::setSourceName( const QString & name )
+{
+	m_sourceName = name;
+}
+
+bool
+SourcesLogPolicy::isOnChangeOnly() const
+{
+	return m_isOnChangeOnly;
+}
+
+void
+SourcesLogPolicy::setOnChangeOnly( bool on )
+{
+	m_isOnChangeOnly = on;
+}
+
+double
+SourcesLogPolicy::absoluteDeadband() const
+{
+	return m_absoluteDeadband;
+}
+
+void
+SourcesLogPolicy::setAbsoluteDeadband( double d )
+{
+	m_absoluteDeadband = d;
+}
+
+double
+SourcesLogPolicy::relativeDeadband() const
+{
+	return m_relativeDeadband;
+}
+
+void
+SourcesLogPolicy::setRelativeDeadband( double d )
+{
+	m_relativeDeadband = d;
+}
+
+int
+SourcesLogPolicy::maxInterval() const
+{
+	return m_maxInterval;
+}
+
+void
+SourcesLogPolicy::setMaxInterval( int secs )
+{
+	m_maxInterval = secs;
+}
+
+bool
+SourcesLogPolicy::isMatched( const QString & channelName,
+	const QString & typeName,
+	const QString & sourceName ) const
+{
+	return ( ( m_channelName.isEmpty() || m_channelName == channelName ) &&
+		( m_typeName.isEmpty() || m_typeName == typeName ) &&
+		( m_sourceName.isEmpty() || m_sourceName == sourceName ) );
+}
+
+int
+SourcesLogPolicy::specificity() const
+{
+	return ( ( m_sourceName.isEmpty() ? 0 : 4 ) +
+		( m_channelName.isEmpty() ? 0 : 2 ) +
+		( m_typeName.isEmpty() ? 0 : 1 ) );
+}
+
+
 //
 // LogCfg
 //
@@ -25,6 +168,7 @@ LogCfg::LogCfg( const LogCfg & other )
 	:	m_isEventLogEnabled( other.isEventLogEnabled() )
 	,	m_isSourcesLogEnabled( other.isSourcesLogEnabled() )
 	,	m_sourcesLogDays( other.sourcesLogDays() )
+	,	m_sourcesLogPolicies( other.sourcesLogPolicies() )
 {
 }
 
@@ -36,6 +180,7 @@ LogCfg::operator = ( const LogCfg & other )
 		m_isEventLogEnabled = other.isEventLogEnabled();
 		m_isSourcesLogEnabled = other.isSourcesLogEnabled();
 		m_sourcesLogDays = other.sourcesLogDays();
+		m_sourcesLogPolicies = other.sourcesLogPolicies();
 	}
 
 	return *this;
@@ -77,6 +222,133 @@ LogCfg::setSourcesLogDays( int days )
 	m_sourcesLogDays = days;
 }
 
+const SourcesLogPolicies &
+LogCfg::sourcesLogPolicies() const
+{
+	return m_sourcesLogPolicies;
+}
+
+void
+LogCfg::setSourcesLogPolicies( const SourcesLogPolicies & policies )
+{
+	m_sourcesLogPolicies = policies;
+}
+
+int
+LogCfg::sourcesLogPolicyIndex( const QString & channelName,
+	const QString & typeName,
+	const QString & sourceName ) const
+{
+	int index = -1;
+	int specificity = -1;
+
+	for( int i = 0; i < m_sourcesLogPolicies.size(); ++i )
+	{
+		const SourcesLogPolicy & p = m_sourcesLogPolicies.at( i );
+
+		if( p.isMatched( channelName, typeName, sourceName ) &&
+			p.specificity() > specificity )
+		{
+			index = i;
+			specificity = p.specificity();
+		}
+	}
+
+	return index;
+}
+
+
+//
+// SourcesLogPolicyTag
+//
+
+SourcesLogPolicyTag::SourcesLogPolicyTag( const QString & name,
+	bool isMandatory )
+	:	cfgfile::tag_no_value_t< cfgfile::qstring_trait_t > ( name, isMandatory )
+	,	m_channelName( *this, QLatin1String( "channelName" ), false )
+	,	m_typeName( *this, QLatin1String( "typeName" ), false )
+	,	m_sourceName( *this, QLatin1String( "sourceName" ), false )
+	,	m_onChangeOnly( *this, QLatin1String( "onChangeOnly" ), false )
+	,	m_absoluteDeadband( *this, QLatin1String( "absoluteDeadband" ), false )
+	,	m_relativeDeadband( *this, QLatin1String( "relativeDeadband" ), false )
+	,	m_deadbandConstraint( 0.0, 1.0e+300 )
+	,	m_maxInterval( *this, QLatin1String( "maxInterval" ), false )
+	,	m_maxIntervalConstraint( 0, 365 * 24 * 60 * 60 )
+{
+	m_absoluteDeadband.set_constraint( &m_deadbandConstraint );
+	m_relativeDeadband.set_constraint( &m_deadbandConstraint );
+	m_maxInterval.set_constraint( &m_maxIntervalConstraint );
+}
+
+SourcesLogPolicyTag::SourcesLogPolicyTag( const SourcesLogPolicy & policy,
+	const QString & name, bool isMandatory )
+	:	cfgfile::tag_no_value_t< cfgfile::qstring_trait_t > ( name, isMandatory )
+	,	m_channelName( *this, QLatin1String( "channelName" ), false )
+	,	m_typeName( *this, QLatin1String( "typeName" ), false )
+	,	m_sourceName( *this, QLatin1String( "sourceName" ), false )
+	,	m_onChangeOnly( *this, QLatin1String( "onChangeOnly" ), false )
+	,	m_absoluteDeadband( *this, QLatin1String( "absoluteDeadband" ), false )
+	,	m_relativeDeadband( *this, QLatin1String( "relativeDeadband" ), false )
+	,	m_deadbandConstraint( 0.0, 1.0e+300 )
+	,	m_maxInterval( *this, QLatin1String( "maxInterval" ), false )
+	,	m_maxIntervalConstraint( 0, 365 * 24 * 60 * 60 )
+{
+	m_absoluteDeadband.set_constraint( &m_deadbandConstraint );
+	m_relativeDeadband.set_constraint( &m_deadbandConstraint );
+	m_maxInterval.set_constraint( &m_maxIntervalConstraint );
+
+	if( !policy.channelName().isEmpty() )
+		m_channelName.set_value( policy.channelName() );
+
+	if( !policy.typeName().isEmpty() )
+		m_typeName.set_value( policy.typeName() );
+
+	if( !policy.sourceName().isEmpty() )
+		m_sourceName.set_value( policy.sourceName() );
+
+	if( policy.isOnChangeOnly() )
+		m_onChangeOnly.set_defined();
+
+	if( policy.absoluteDeadband() > 0.0 )
+		m_absoluteDeadband.set_value( policy.absoluteDeadband() );
+
+	if( policy.relativeDeadband() > 0.0 )
+		m_relativeDeadband.set_value( policy.relativeDeadband() );
+
+	if( policy.maxInterval() > 0 )
+		m_maxInterval.set_value( policy.maxInterval() );
+
+	set_defined();
+}
+
+SourcesLogPolicy
+SourcesLogPolicyTag::policy() const
+{
+	SourcesLogPolicy p;
+
+	if( m_channelName.is_defined() )
+		p.setChannelName( m_channelName.value() );
+
+	if( m_typeName.is_defined() )
+		p.setTypeName( m_typeName.value() );
+
+	if( m_sourceName.is_defined() )
+		p.setSourceName( m_sourceName.value() );
+
+	p.setOnChangeOnly( m_onChangeOnly.is_defined() );
+
+	if( m_absoluteDeadband.is_defined() )
+		p.setAbsoluteDeadband( m_absoluteDeadband.value() );
+
+	if( m_relativeDeadband.is_defined() )
+		p.setRelativeDeadband( m_relativeDeadband.value() );
+
+	if( m_maxInterval.is_defined() )
+		p.setMaxInterval( m_maxInterval.value() );
+
+	return p;
+}
+
 
 //
 // LogTag
@@ -88,6 +360,7 @@ LogTag::LogTag()
 	,	m_isEventLogEnabled( *this, QLatin1String( "isEventLogEnabled" ), true )
 	,	m_isSourcesLogEnabled( *this, QLatin1String( "isSourcesLogEnabled" ), true )
 	,	m_sourcesLogDays( *this, QLatin1String( "sourcesLogDays" ), false )
+	,	m_sourcesLogPolicies( *this, QLatin1String( "sourcesLogPolicy" ), false )
 {
 }
 
@@ -97,6 +370,7 @@ LogTag::LogTag( const LogCfg & cfg )
 	,	m_isEventLogEnabled( *this, QLatin1String( "isEventLogEnabled" ), true )
 	,	m_isSourcesLogEnabled( *this, QLatin1String( "isSourcesLogEnabled" ), true )
 	,	m_sourcesLogDays( *this, QLatin1String( "sourcesLogDays" ), false )
+	,	m_sourcesLogPolicies( *this, QLatin1String( "sourcesLogPolicy" ), false )
 {
 	m_isEventLogEnabled.set_value( cfg.isEventLogEnabled() );
 	m_isSourcesLogEnabled.set_value( cfg.isSourcesLogEnabled() );
@@ -104,6 +378,16 @@ LogTag::LogTag( const LogCfg & cfg )
 	if( cfg.isSourcesLogEnabled() )
 		m_sourcesLogDays.set_value( cfg.sourcesLogDays() );
 
+	foreach( const SourcesLogPolicy & policy, cfg.sourcesLogPolicies() )
+	{
+		cfgfile::tag_vector_of_tags_t< SourcesLogPolicyTag,
+			cfgfile::qstring_trait_t >::ptr_to_tag_t p(
+				new SourcesLogPolicyTag( policy,
+					QLatin1String( "sourcesLogPolicy" ), true ) );
+
+		m_sourcesLogPolicies.set_value( p );
+	}
+
 	set_defined();
 }
 
@@ -118,6 +402,16 @@ LogTag::cfg() const
 	if( cfg.isSourcesLogEnabled() )
 		cfg.setSourcesLogDays( m_sourcesLogDays.value() );
 
+	if( m_sourcesLogPolicies.is_defined() )
+	{
+		SourcesLogPolicies policies;
+
+		for( std::size_t i = 0; i < m_sourcesLogPolicies.size(); ++i )
+			policies.append( m_sourcesLogPolicies.at( i ).policy() );
+
+		cfg.setSourcesLogPolicies( policies );
+	}
+
 	return cfg;
 }
 
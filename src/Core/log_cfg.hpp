@@ -10,9 +10,100 @@
 // cfgfile include.
 #include <cfgfile/all.hpp>
 
+// Qt include.
+#include <QList>
+
 
 namespace Globe {
 
+//
+// SourcesLogPolicy
+//
+
+/*!
+	Policy of writing values of sources into the source's log.
+
+	Policy is applied to the sources with the given channel's name,
+	type name and source's name. Empty name matches any value. If a few
+	policies match the source then the most specific one is used, the
+	source's name is more specific than the channel's name, and the
+	channel's name is more specific than the type name.
+*/
+class SourcesLogPolicy {
+public:
+	SourcesLogPolicy();
+
+	SourcesLogPolicy( const SourcesLogPolicy & other );
+
+	SourcesLogPolicy & operator = ( const SourcesLogPolicy & other );
+
+	//! \return Channel's name.
+	const QString & channelName() const;
+	//! Set channel's name.
+	void setChannelName( const QString & name );
+
+	//! \return Type name of the source.
+	const QString & typeName() const;
+	//! Set type name of the source.
+	void setTypeName( const QString & name );
+
+	//! \return Name of the source.
+	const QString & sourceName() const;
+	//! Set name of the source.
+	void setSourceName( const QString & name );
+
+	//! \return Should be value logged only when it's changed?
+	bool isOnChangeOnly() const;
+	//! Set should be value logged only when it's changed.
+	void setOnChangeOnly( bool on = true );
+
+	//! \return Absolute deadband of numeric values.
+	double absoluteDeadband() const;
+	//! Set absolute deadband of numeric values.
+	void setAbsoluteDeadband( double d );
+
+	//! \return Relative deadband of numeric values, part of the last
+	//! logged value.
+	double relativeDeadband() const;
+	//! Set relative deadband of numeric values.
+	void setRelativeDeadband( double d );
+
+	//! \return Max interval in seconds between logged values.
+	//! 0 = not limited.
+	int maxInterval() const;
+	//! Set max interval in seconds between logged values.
+	void setMaxInterval( int secs );
+
+	//! \return Does the policy match the given source?
+	bool isMatched( const QString & channelName,
+		const QString & typeName,
+		const QString & sourceName ) const;
+
+	//! \return Specificity of the policy, bigger is more specific.
+	int specificity() const;
+
+private:
+	//! Channel's name.
+	QString m_channelName;
+	//! Type name of the source.
+	QString m_typeName;
+	//! Name of the source.
+	QString m_sourceName;
+	//! Should be value logged only when it's changed?
+	bool m_isOnChangeOnly;
+	//! Absolute deadband.
+	double m_absoluteDeadband;
+	//! Relative deadband.
+	double m_relativeDeadband;
+	//! Max interval between logged values.
+	int m_maxInterval;
+}; // class SourcesLogPolicy
+
+
+//! List of policies of the source's log.
+typedef QList< SourcesLogPolicy > SourcesLogPolicies;
+
+
 //
 // LogCfg
 //
@@ -41,6 +132,20 @@ public:
 	//! Set number of the source's log days.
 	void setSourcesLogDays( int days );
 
+	//! \return Policies of the source's log.
+	const SourcesLogPolicies & sourcesLogPolicies() const;
+	//! Set policies of the source's log.
+	void setSourcesLogPolicies( const SourcesLogPolicies & policies );
+
+	/*!
+		\return Index of the most specific policy of the source's log
+		for the given source.
+		\retval -1 if there is no such policy.
+	*/
+	int sourcesLogPolicyIndex( const QString & channelName,
+		const QString & typeName,
+		const QString & sourceName ) const;
+
 private:
 	//! Is event's log enabled?
 	bool m_isEventLogEnabled;
@@ -49,9 +154,51 @@ private:
 	//! Number of days of the source's log.
 	//! 0 = ongoing log.
 	int m_sourcesLogDays;
+	//! Policies of the source's log.
+	SourcesLogPolicies m_sourcesLogPolicies;
 }; // class LogCfg
 
 
+//
+// SourcesLogPolicyTag
+//
+
+//! Tag with policy of the source's log.
+class SourcesLogPolicyTag
+	:	public cfgfile::tag_no_value_t< cfgfile::qstring_trait_t >
+{
+public:
+	explicit SourcesLogPolicyTag( const QString & name,
+		bool isMandatory = false );
+
+	SourcesLogPolicyTag( const SourcesLogPolicy & policy,
+		const QString & name, bool isMandatory = false );
+
+	//! \return Policy.
+	SourcesLogPolicy policy() const;
+
+private:
+	//! Channel's name.
+	cfgfile::tag_scalar_t< QString, cfgfile::qstring_trait_t > m_channelName;
+	//! Type name of the source.
+	cfgfile::tag_scalar_t< QString, cfgfile::qstring_trait_t > m_typeName;
+	//! Name of the source.
+	cfgfile::tag_scalar_t< QString, cfgfile::qstring_trait_t > m_sourceName;
+	//! Log only changes.
+	cfgfile::tag_no_value_t< cfgfile::qstring_trait_t > m_onChangeOnly;
+	//! Absolute deadband.
+	cfgfile::tag_scalar_t< double, cfgfile::qstring_trait_t > m_absoluteDeadband;
+	//! Relative deadband.
+	cfgfile::tag_scalar_t< double, cfgfile::qstring_trait_t > m_relativeDeadband;
+	//! Constraint for deadbands.
+	cfgfile::constraint_min_max_t< double > m_deadbandConstraint;
+	//! Max interval between logged values.
+	cfgfile::tag_scalar_t< int, cfgfile::qstring_trait_t > m_maxInterval;
+	//! Constraint for max interval.
+	cfgfile::constraint_min_max_t< int > m_maxIntervalConstraint;
+}; // class SourcesLogPolicyTag
+
+
 //
 // LogTag
 //
@@ -75,6 +222,9 @@ private:
 	cfgfile::tag_scalar_t< bool, cfgfile::qstring_trait_t > m_isSourcesLogEnabled;
 	//! Number of days of the source's log.
 	cfgfile::tag_scalar_t< int, cfgfile::qstring_trait_t > m_sourcesLogDays;
+	//! Policies of the source's log.
+	cfgfile::tag_vector_of_tags_t< SourcesLogPolicyTag,
+		cfgfile::qstring_trait_t > m_sourcesLogPolicies;
 }; // class LogTag
 
 } /* namespace Globe */
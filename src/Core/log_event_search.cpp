@@ -0,0 +1,181 @@
+
+/*
+	SPDX-FileCopyrightText: 2012-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// Globe include.
+#include <Core/log_event_search.hpp>
+
+// Qt include.
+#include <QDateTime>
+#include <QStringList>
+#include <QVariant>
+
+
+namespace Globe {
+
+//! \return Date and time as it's stored in the event's log.
+static inline QString eventLogDateTimeToString( const QDateTime & dt )
+{
+	return dt.toString( QLatin1String( "yyyy-MM-dd hh:mm:ss.zzz" ) );
+}
+
+//! \return Words and "quoted phrases" of the text.
+static QStringList searchTerms( const QString & text )
+{
+	QStringList terms;
+	QString term;
+	bool quoted = false;
+
+	for( const QChar & c : text )
+	{
+		if( c == QLatin1Char( '"' ) )
+		{
+			if( !term.trimmed().isEmpty() )
+				terms.append( term.trimmed() );
+
+			term.clear();
+			quoted = !quoted;
+		}
+		else if( c.isSpace() && !quoted )
+		{
+			if( !term.isEmpty() )
+				terms.append( term );
+
+			term.clear();
+		}
+		else
+			term.append( c );
+	}
+
+	if( !term.trimmed().isEmpty() )
+		terms.append( term.trimmed() );
+
+	return terms;
+}
+
+QString eventLogMatchExpression( const QString & text )
+{
+	QStringList phrases;
+
+	for( const auto & t : searchTerms( text ) )
+		phrases.append( QLatin1Char( '"' ) + t + QLatin1Char( '"' ) );
+
+	return phrases.join( QLatin1Char( ' ' ) );
+}
+
+bool createEventLogSearchIndex()
+{
+	if( hasEventLogSearchIndex() )
+		return true;
+
+	QSqlQuery create;
+
+	if( !create.exec( QLatin1String(
+		"CREATE VIRTUAL TABLE eventLogSearch USING fts5( msg, "
+		"content = 'eventLog', content_rowid = 'rowid' )" ) ) )
+			return false;
+
+	create.exec( QLatin1String(
+		"CREATE TRIGGER IF NOT EXISTS eventLogSearchInsert "
+		"AFTER INSERT ON eventLog BEGIN "
+		"INSERT INTO eventLogSearch ( rowid, msg ) "
+		"VALUES ( new.rowid, new.msg ); END" ) );
+
+	create.exec( QLatin1String(
+		"INSERT INTO eventLogSearch ( eventLogSearch ) VALUES ( 'rebuild' )" ) );
+
+	return true;
+}
+
+void clearEventLogSearchIndex()
+{
+	if( !hasEventLogSearchIndex() )
+		return;
+
+	QSqlQuery clear;
+
+	clear.exec( QLatin1String(
+		"INSERT INTO eventLogSearch ( eventLogSearch ) "
+		"VALUES ( 'delete-all' )" ) );
+}
+
+bool hasEventLogSearchIndex()
+{
+	QSqlQuery select;
+	select.setForwardOnly( true );
+
+	select.exec( QLatin1String( "SELECT 1 FROM sqlite_master "
+		"WHERE type = 'table' AND name = 'eventLogSearch'" ) );
+
+	return select.next();
+}
+
+QSqlQuery searchEventLog( const QDateTime & from,
+	const QDateTime & to,
+	const QString & text,
+	LogLevel minLevel,
+	bool hasIndex )
+{
+	const QStringList terms = searchTerms( text );
+
+	QSqlQuery select;
+	select.setForwardOnly( true );
+
+	if( terms.isEmpty() )
+	{
+		select.prepare( QLatin1String(
+			"SELECT * FROM eventLog WHERE dateTime BETWEEN ? AND ? "
+			"AND level >= ? ORDER BY dateTime" ) );
+		select.addBindValue( eventLogDateTimeToString( from ) );
+		select.addBindValue( eventLogDateTimeToString( to ) );
+		select.addBindValue( int( minLevel ) );
+	}
+	else if( hasIndex )
+	{
+		select.prepare( QLatin1String(
+			"SELECT eventLog.level, eventLog.dateTime, eventLog.msg "
+			"FROM eventLogSearch JOIN eventLog "
+			"ON eventLog.rowid = eventLogSearch.rowid "
+			"WHERE eventLogSearch MATCH ? "
+			"AND eventLog.dateTime BETWEEN ? AND ? "
+			"AND eventLog.level >= ? "
+			"ORDER BY eventLogSearch.rank" ) );
+		select.addBindValue( eventLogMatchExpression( text ) );
+		select.addBindValue( eventLogDateTimeToString( from ) );
+		select.addBindValue( eventLogDateTimeToString( to ) );
+		select.addBindValue( int( minLevel ) );
+	}
+	else
+	{
+		QString sql = QLatin1String(
+			"SELECT * FROM eventLog WHERE dateTime BETWEEN ? AND ? "
+			"AND level >= ?" );
+
+		for( int i = 0; i < terms.size(); ++i )
+			sql.append( QLatin1String( " AND msg LIKE ? ESCAPE '\\'" ) );
+
+		sql.append( QLatin1String( " ORDER BY dateTime" ) );
+
+		select.prepare( sql );
+		select.addBindValue( eventLogDateTimeToString( from ) );
+		select.addBindValue( eventLogDateTimeToString( to ) );
+		select.addBindValue( int( minLevel ) );
+
+		for( QString t : terms )
+		{
+			t.replace( QLatin1String( "\\" ), QLatin1String( "\\\\" ) );
+			t.replace( QLatin1String( "%" ), QLatin1String( "\\%" ) );
+			t.replace( QLatin1String( "_" ), QLatin1String( "\\_" ) );
+
+			select.addBindValue( QLatin1Char( '%' ) + t + QLatin1Char( '%' ) );
+		}
+	}
+
+	select.exec();
+
+	return select;
+}
+
+} /* namespace Globe */
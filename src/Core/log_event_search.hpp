@@ -0,0 +1,65 @@
+
+/*
+	SPDX-FileCopyrightText: 2012-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#ifndef GLOBE__LOG_EVENT_SEARCH_HPP__INCLUDED
+#define GLOBE__LOG_EVENT_SEARCH_HPP__INCLUDED
+
+// Qt include.
+#include <QSqlQuery>
+#include <QString>
+
+// Globe include.
+#include <Core/log.hpp>
+#include <Core/export.hpp>
+
+
+QT_BEGIN_NAMESPACE
+class QDateTime;
+QT_END_NAMESPACE
+
+
+namespace Globe {
+
+/*!
+	\return Full-text query that matches records with all words and
+	"quoted phrases" of the \a text. Words are quoted, so characters
+	of the query syntax in the \a text are searched as is.
+*/
+CORE_EXPORT QString eventLogMatchExpression( const QString & text );
+
+/*!
+	Create full-text index of the event's log if it doesn't exist.
+	Index is filled with existing records once and then kept in sync
+	by the trigger on insert into the event's log.
+
+	\return false if SQLite doesn't support FTS5.
+*/
+CORE_EXPORT bool createEventLogSearchIndex();
+
+//! Clear full-text index of the event's log.
+CORE_EXPORT void clearEventLogSearchIndex();
+
+//! \return Is there full-text index of the event's log in the DB?
+CORE_EXPORT bool hasEventLogSearchIndex();
+
+/*!
+	Select from the event's log records for the given period of time
+	with level not less than \a minLevel.
+
+	If \a text is empty records are ordered by date and time. Otherwise
+	only records with the \a text are selected, ordered by relevance
+	if \a hasIndex, or by date and time with slow scan of messages if
+	there is no full-text index.
+*/
+CORE_EXPORT QSqlQuery searchEventLog( const QDateTime & from,
+	const QDateTime & to,
+	const QString & text,
+	LogLevel minLevel,
+	bool hasIndex );
+
+} /* namespace Globe */
+
+#endif // GLOBE__LOG_EVENT_SEARCH_HPP__INCLUDED
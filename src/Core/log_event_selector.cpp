@@ -7,11 +7,14 @@
 // Globe include.
 #include <Core/log_event_selector.hpp>
 #include <Core/launch_time.hpp>
+#include <Core/select_query_navigation.hpp>
 
 #include "ui_log_event_selector.h"
 
 // Qt include.
 #include <QDateTimeEdit>
+#include <QLineEdit>
+#include <QComboBox>
 
 
 namespace Globe {
@@ -94,6 +97,8 @@ LogEventSelector::init()
 		this, &LogEventSelector::setStartTimeToLaunchTime );
 	connect( d->m_ui.m_toCurrentTimeButton, &QToolButton::clicked,
 		this, &LogEventSelector::setEndTimeToCurrent );
+	connect( d->m_ui.m_search, &QLineEdit::returnPressed,
+		d->m_ui.m_navigation, &SelectQueryNavigation::executeButtonClicked );
 }
 
 const LogEventSelectorCfg &
@@ -120,6 +125,18 @@ LogEventSelector::endDateTime() const
 	return d->m_ui.m_to->dateTime();
 }
 
+QString
+LogEventSelector::searchText() const
+{
+	return d->m_ui.m_search->text().trimmed();
+}
+
+LogLevel
+LogEventSelector::minLevel() const
+{
+	return static_cast< LogLevel > ( d->m_ui.m_level->currentIndex() );
+}
+
 void
 LogEventSelector::startDateTimeChanged( const QDateTime & dt )
 {
@@ -13,6 +13,7 @@
 #include <QDateTime>
 
 // Globe include.
+#include <Core/log.hpp>
 #include <Core/export.hpp>
 
 
@@ -77,6 +78,12 @@ public:
 	//! \return Date and time for end slection from log.
 	QDateTime endDateTime() const;
 
+	//! \return Text to search in messages.
+	QString searchText() const;
+
+	//! \return Min level of the records.
+	LogLevel minLevel() const;
+
 private slots:
 	//! Start date and time changed.
 	void startDateTimeChanged( const QDateTime & dt );
@@ -9,6 +9,8 @@
 
 // Qt include.
 #include <QList>
+#include <QSqlQuery>
+#include <QVariant>
 
 
 namespace Globe {
@@ -98,10 +100,18 @@ public:
 	{
 	}
 
-	//! Data.
-	QList< LogEventRecord > m_data;
+	//! Rows.
+	LogLazyRows< LogEventRecord > m_rows;
 }; // class LogEventViewModelPrivate
 
+//! \return Record from the current row of the event's log select.
+static LogEventRecord readEventLogRecord( const QSqlQuery & query )
+{
+	return LogEventRecord( (LogLevel) query.value( 0 ).toInt(),
+		query.value( 1 ).toString(),
+		query.value( 2 ).toString() );
+}
+
 
 //
 // LogEventViewModel
@@ -117,25 +127,24 @@ LogEventViewModel::~LogEventViewModel()
 {
 }
 
-const LogEventRecord &
+LogEventRecord
 LogEventViewModel::record( const QModelIndex & index ) const
 {
-	return d->m_data.at( index.row() );
+	return d->m_rows.at( index.row() );
 }
 
 void
-LogEventViewModel::initModel( const QList< LogEventRecord > & data )
+LogEventViewModel::initModel( const QDateTime & from,
+	const LogLazyRows< LogEventRecord >::Select & select,
+	bool isRanked )
 {
-	clear();
+	beginResetModel();
 
-	if( !data.isEmpty() )
-	{
-		beginInsertRows( QModelIndex(), 0, data.size() - 1 );
+	d->m_rows.reset( from, select, &readEventLogRecord, ( isRanked ? -1 : 1 ) );
 
-		d->m_data = data;
+	endResetModel();
 
-		endInsertRows();
-	}
+	fetchMore( QModelIndex() );
 }
 
 void
@@ -143,7 +152,7 @@ LogEventViewModel::clear()
 {
 	beginResetModel();
 
-	d->m_data.clear();
+	d->m_rows.clear();
 
 	endResetModel();
 }
@@ -152,11 +161,39 @@ int
 LogEventViewModel::rowCount( const QModelIndex & parent ) const
 {
 	if( !parent.isValid() )
-		return d->m_data.size();
+		return d->m_rows.size();
 	else
 		return 0;
 }
 
+bool
+LogEventViewModel::canFetchMore( const QModelIndex & parent ) const
+{
+	if( !parent.isValid() )
+		return d->m_rows.canFetchMore();
+	else
+		return false;
+}
+
+void
+LogEventViewModel::fetchMore( const QModelIndex & parent )
+{
+	if( parent.isValid() )
+		return;
+
+	const int count = d->m_rows.fetch();
+
+	if( count > 0 )
+	{
+		beginInsertRows( QModelIndex(), d->m_rows.size(),
+			d->m_rows.size() + count - 1 );
+
+		d->m_rows.commitFetched();
+
+		endInsertRows();
+	}
+}
+
 int
 LogEventViewModel::columnCount( const QModelIndex & parent ) const
 {
@@ -178,9 +215,9 @@ LogEventViewModel::data( const QModelIndex & index, int role ) const
 		switch( column )
 		{
 			case dateTimeColumn :
-				return d->m_data[ index.row() ].dateTime();
+				return d->m_rows.at( index.row() ).dateTime();
 			case messageColumn :
-				return d->m_data[ index.row() ].message();
+				return d->m_rows.at( index.row() ).message();
 			default :
 				return QVariant();
 		}
@@ -189,30 +226,6 @@ LogEventViewModel::data( const QModelIndex & index, int role ) const
 		return QVariant();
 }
 
-bool
-LogEventViewModel::setData( const QModelIndex & index, const QVariant & value,
-	int role )
-{
-	const int column = index.column();
-	const int row = index.row();
-
-	if( role == Qt::DisplayRole )
-	{
-		switch( column )
-		{
-			case dateTimeColumn :
-				d->m_data[ row ].setDateTime( value.toString() ); break;
-			case messageColumn :
-				d->m_data[ row ].setMessage( value.toString() ); break;
-		}
-	}
-
-	emit dataChanged( QAbstractTableModel::index( row, column ),
-		QAbstractTableModel::index( row, column ) );
-
-	return true;
-}
-
 Qt::ItemFlags
 LogEventViewModel::flags( const QModelIndex & index ) const
 {
@@ -13,6 +13,7 @@
 
 // Globe include.
 #include <Core/log.hpp>
+#include <Core/log_lazy_rows.hpp>
 #include <Core/export.hpp>
 
 
@@ -66,7 +67,7 @@ private:
 
 class LogEventViewModelPrivate;
 
-//! Model for the event log.
+//! Model for the event log. Rows are fetched on demand.
 class CORE_EXPORT LogEventViewModel
 	:	public QAbstractTableModel
 {
@@ -78,10 +79,17 @@ public:
 	~LogEventViewModel();
 
 	//! \return Record.
-	const LogEventRecord & record( const QModelIndex & index ) const;
-
-	//! Init model.
-	void initModel( const QList< LogEventRecord > & data );
+	LogEventRecord record( const QModelIndex & index ) const;
+
+	/*!
+		Init model with the select from the event's log. \a select is
+		called with \a from and later with date and time of the block
+		of rows to read again, or with invalid date and time if
+		\a isRanked, i.e. select is not ordered by date and time.
+	*/
+	void initModel( const QDateTime & from,
+		const LogLazyRows< LogEventRecord >::Select & select,
+		bool isRanked = false );
 
 	//! Clear model.
 	void clear();
@@ -93,14 +101,15 @@ public:
 	//! \return Data by the given index and role.
 	QVariant data( const QModelIndex & index,
 		int role = Qt::DisplayRole ) const;
-	//! Set data.
-	bool setData( const QModelIndex & index, const QVariant & value,
-		int role = Qt::EditRole );
 	//! \return Flags.
 	Qt::ItemFlags flags( const QModelIndex & index ) const;
 	//! \return Header data.
 	QVariant headerData( int section, Qt::Orientation orientation,
 		int role = Qt::DisplayRole ) const;
+	//! \return Are there not fetched rows?
+	bool canFetchMore( const QModelIndex & parent ) const;
+	//! Fetch next block of rows.
+	void fetchMore( const QModelIndex & parent );
 
 private:
 	Q_DISABLE_COPY( LogEventViewModel )
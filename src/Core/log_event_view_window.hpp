@@ -62,10 +62,6 @@ private:
 	void init();
 	//! Set navigation buttons.
 	void setNavigationButtons();
-	//! \return List with log records.
-	QList< LogEventRecord > readLog();
-	//! \return List with log records.
-	QList< LogEventRecord > readLogFirstTime();
 
 private slots:
 	//! Select from log.
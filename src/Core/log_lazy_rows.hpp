@@ -0,0 +1,290 @@
+
+/*
+	SPDX-FileCopyrightText: 2012-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#ifndef GLOBE__LOG_LAZY_ROWS_HPP__INCLUDED
+#define GLOBE__LOG_LAZY_ROWS_HPP__INCLUDED
+
+// Qt include.
+#include <QSqlQuery>
+#include <QDateTime>
+#include <QString>
+#include <QVector>
+#include <QHash>
+#include <QList>
+
+// C++ include.
+#include <functional>
+
+
+namespace Globe {
+
+//
+// LogLazyRows
+//
+
+/*!
+	Rows of the log's select fetched by blocks on demand.
+
+	Select is read forward only. For each fetched block the date and
+	time of its first row is remembered, so the block evicted from
+	the cache is read again with the select started from this date
+	and time, that is a lookup in the index of the log.
+	Only a few recently used blocks are kept in memory.
+
+	Select not ordered by date and time, ranked search for example,
+	is read again from the beginning with the rows before the block
+	skipped.
+
+	Query is QSqlQuery or SourcesLogCursor, anything forward only with
+	next(), value() and finish().
+*/
+template< typename Record, typename Query = QSqlQuery >
+class LogLazyRows {
+public:
+	//! Select records not older than the given date and time.
+	typedef std::function< Query ( const QDateTime & from ) > Select;
+	//! Read record from the current row of the query.
+	typedef std::function< Record ( const Query & query ) > Read;
+
+	//! Count of rows in the block.
+	static const int blockSize = 256;
+	//! Max count of blocks in the cache.
+	static const int maxCachedBlocks = 16;
+
+	LogLazyRows()
+		:	m_dateTimeColumn( 0 )
+		,	m_count( 0 )
+		,	m_hasMore( false )
+		,	m_sameDateTimeCount( 0 )
+	{
+	}
+
+	//! Start new select. Negative \a dateTimeColumn means select
+	//! not ordered by date and time.
+	void reset( const QDateTime & from, const Select & select,
+		const Read & read, int dateTimeColumn )
+	{
+		clear();
+
+		m_select = select;
+		m_read = read;
+		m_dateTimeColumn = dateTimeColumn;
+		m_query = m_select( from );
+		m_hasMore = m_query.next();
+
+		releaseQueryIfDone();
+	}
+
+	//! Clear.
+	void clear()
+	{
+		m_query = Query();
+		m_select = Select();
+		m_read = Read();
+		m_keys.clear();
+		m_blocks.clear();
+		m_lru.clear();
+		m_pending.clear();
+		m_lastDateTime.clear();
+		m_count = 0;
+		m_hasMore = false;
+		m_sameDateTimeCount = 0;
+	}
+
+	//! \return Count of fetched rows.
+	int size() const
+	{
+		return m_count;
+	}
+
+	//! \return Are there not fetched rows?
+	bool canFetchMore() const
+	{
+		return m_hasMore;
+	}
+
+	/*!
+		Read next block from the select.
+
+		\return Count of read rows. They are counted in size() only
+		after commitFetched().
+	*/
+	int fetch()
+	{
+		m_pending.clear();
+
+		if( !m_hasMore )
+			return 0;
+
+		Key key;
+
+		if( m_dateTimeColumn < 0 )
+			key.m_skip = m_keys.size() * blockSize;
+
+		while( m_hasMore && m_pending.size() < blockSize )
+		{
+			if( m_dateTimeColumn < 0 )
+			{
+				m_pending.append( m_read( m_query ) );
+				m_hasMore = m_query.next();
+
+				continue;
+			}
+
+			const QString dt = m_query.value( m_dateTimeColumn ).toString();
+
+			if( dt == m_lastDateTime )
+				++m_sameDateTimeCount;
+			else
+			{
+				m_lastDateTime = dt;
+				m_sameDateTimeCount = 0;
+			}
+
+			if( m_pending.isEmpty() )
+			{
+				key.m_dateTime = dt;
+				key.m_skip = m_sameDateTimeCount;
+			}
+
+			m_pending.append( m_read( m_query ) );
+
+			m_hasMore = m_query.next();
+		}
+
+		if( !m_pending.isEmpty() )
+			m_keys.append( key );
+
+		releaseQueryIfDone();
+
+		return m_pending.size();
+	}
+
+	//! Make rows read by fetch() available.
+	void commitFetched()
+	{
+		if( m_pending.isEmpty() )
+			return;
+
+		m_count += m_pending.size();
+
+		cache( m_keys.size() - 1, m_pending );
+
+		m_pending.clear();
+	}
+
+	//! \return Record in the given row.
+	Record at( int row )
+	{
+		const int block = row / blockSize;
+
+		if( !m_blocks.contains( block ) )
+			cache( block, readBlock( block ) );
+		else if( m_lru.last() != block )
+		{
+			m_lru.removeOne( block );
+			m_lru.append( block );
+		}
+
+		const QVector< Record > & records = m_blocks[ block ];
+		const int i = row % blockSize;
+
+		return ( i < records.size() ? records.at( i ) : Record() );
+	}
+
+private:
+	//! Put block into the cache.
+	void cache( int block, const QVector< Record > & records )
+	{
+		m_blocks.insert( block, records );
+		m_lru.removeOne( block );
+		m_lru.append( block );
+
+		while( m_lru.size() > maxCachedBlocks )
+			m_blocks.remove( m_lru.takeFirst() );
+	}
+
+	//! Read again block evicted from the cache.
+	QVector< Record > readBlock( int block )
+	{
+		QVector< Record > records;
+
+		if( block < 0 || block >= m_keys.size() || !m_select )
+			return records;
+
+		const Key & key = m_keys.at( block );
+
+		Query query = m_select( m_dateTimeColumn < 0 ? QDateTime() :
+			QDateTime::fromString( key.m_dateTime,
+				QLatin1String( "yyyy-MM-dd hh:mm:ss.zzz" ) ) );
+
+		for( int i = 0; i < key.m_skip; ++i )
+			if( !query.next() )
+				return records;
+
+		const int count = qMin( blockSize, m_count - block * blockSize );
+
+		while( records.size() < count && query.next() )
+			records.append( m_read( query ) );
+
+		query.finish();
+
+		return records;
+	}
+
+	//! Finish the query when all rows are fetched, active statement
+	//! blocks dropping of the tables on the connection.
+	void releaseQueryIfDone()
+	{
+		if( !m_hasMore )
+			m_query.finish();
+	}
+
+private:
+	//! Start of the block in the select.
+	struct Key {
+		Key()
+			:	m_skip( 0 )
+		{
+		}
+
+		//! Date and time of the first row.
+		QString m_dateTime;
+		//! Count of rows with the same date and time before the block,
+		//! or of all rows before the block if select is not ordered by
+		//! date and time.
+		int m_skip;
+	}; // struct Key
+
+	//! Select.
+	Select m_select;
+	//! Read record.
+	Read m_read;
+	//! Column with date and time.
+	int m_dateTimeColumn;
+	//! Forward only query positioned on the first not fetched row.
+	Query m_query;
+	//! Starts of the fetched blocks.
+	QVector< Key > m_keys;
+	//! Cached blocks.
+	QHash< int, QVector< Record > > m_blocks;
+	//! Cached blocks from the least recently used.
+	QList< int > m_lru;
+	//! Rows read by fetch() and not yet commited.
+	QVector< Record > m_pending;
+	//! Count of fetched rows.
+	int m_count;
+	//! Are there not fetched rows?
+	bool m_hasMore;
+	//! Date and time of the last fetched row.
+	QString m_lastDateTime;
+	//! Count of fetched rows with the same date and time before the last.
+	int m_sameDateTimeCount;
+}; // class LogLazyRows
+
+} /* namespace Globe */
+
+#endif // GLOBE__LOG_LAZY_ROWS_HPP__INCLUDED
@@ -0,0 +1,615 @@
+
+/*
+	SPDX-FileCopyrightText: 2012-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// Globe include.
+#include <Core/log_sources_chart.hpp>
+#include <Core/log.hpp>
+
+// Qt include.
+#include <QPainter>
+#include <QPaintEvent>
+#include <QMouseEvent>
+#include <QWheelEvent>
+#include <QTimer>
+#include <QVariant>
+#include <QVector>
+#include <QMap>
+#include <QColor>
+
+// C++ include.
+#include <limits>
+
+
+namespace Globe {
+
+//! Count of chunks of the visible period read with separate selects.
+static const int chartFetchChunks = 16;
+
+//! Count of records read in one step.
+static const int chartRecordsPerStep = 4096;
+
+//! Delay before reading after change of the visible period, in msecs.
+static const int chartFetchDelay = 50;
+
+//! Min visible period in msecs.
+static const qint64 chartMinViewMSecs = 1000;
+
+//! Zoom factor of one step of the wheel.
+static const double chartZoomFactor = 0.8;
+
+//! Margins of the plot.
+static const int chartLeftMargin = 70;
+static const int chartRightMargin = 10;
+static const int chartTopMargin = 10;
+static const int chartBottomMargin = 25;
+
+//! Format of the date and time in the log.
+static const QString chartDateTimeFormat =
+	QLatin1String( "yyyy-MM-dd hh:mm:ss.zzz" );
+
+
+//
+// ChartBucket
+//
+
+//! Min and max values in one pixel column.
+struct ChartBucket {
+	ChartBucket()
+		:	m_min( std::numeric_limits< double >::max() )
+		,	m_max( std::numeric_limits< double >::lowest() )
+		,	m_isSet( false )
+	{
+	}
+
+	//! Add value.
+	void add( double min, double max )
+	{
+		m_min = qMin( m_min, min );
+		m_max = qMax( m_max, max );
+		m_isSet = true;
+	}
+
+	//! Min value.
+	double m_min;
+	//! Max value.
+	double m_max;
+	//! Is there any value?
+	bool m_isSet;
+}; // struct ChartBucket
+
+
+//
+// ChartSeries
+//
+
+//! Series of one source.
+struct ChartSeries {
+	//! Name to show.
+	QString m_name;
+	//! Color.
+	QColor m_color;
+	//! Pixel columns.
+	QVector< ChartBucket > m_buckets;
+}; // struct ChartSeries
+
+
+//
+// LogSourcesChartPrivate
+//
+
+class LogSourcesChartPrivate {
+public:
+	LogSourcesChartPrivate()
+		:	m_from( 0 )
+		,	m_to( 0 )
+		,	m_viewFrom( 0 )
+		,	m_viewTo( 0 )
+		,	m_resolution( SourcesLogRawResolution )
+		,	m_chunk( 0 )
+		,	m_isSelecting( false )
+		,	m_bucketsCount( 0 )
+		,	m_isDirty( false )
+		,	m_isDragging( false )
+		,	m_dragX( 0 )
+		,	m_dragViewFrom( 0 )
+		,	m_dragViewTo( 0 )
+		,	m_fetchTimer( 0 )
+		,	m_delayTimer( 0 )
+	{
+	}
+
+	//! \return Rectangle of the plot.
+	QRect plotRect( const QRect & r ) const
+	{
+		return r.adjusted( chartLeftMargin, chartTopMargin,
+			-chartRightMargin, -chartBottomMargin );
+	}
+
+	//! \return Is there selection?
+	bool hasSelection() const
+	{
+		return ( m_from < m_to );
+	}
+
+	//! Add current record of the select to the series.
+	void addRecord();
+	//! \return Color of the series with the given index.
+	static QColor seriesColor( int i );
+
+	//! Start of the selected period in msecs since epoch.
+	qint64 m_from;
+	//! End of the selected period in msecs since epoch.
+	qint64 m_to;
+	//! Channel name.
+	QString m_channelName;
+	//! Source name.
+	QString m_sourceName;
+	//! Type name.
+	QString m_typeName;
+	//! Start of the visible period.
+	qint64 m_viewFrom;
+	//! End of the visible period.
+	qint64 m_viewTo;
+	//! Resolution of the current reading.
+	SourcesLogResolution m_resolution;
+	//! Current chunk.
+	int m_chunk;
+	//! Select of the current chunk.
+	SourcesLogCursor m_query;
+	//! Is current chunk being read?
+	bool m_isSelecting;
+	//! Count of pixel columns.
+	int m_bucketsCount;
+	//! Series by channel, source and type names.
+	QMap< QString, ChartSeries > m_series;
+	//! Should visible period be read when chart is shown?
+	bool m_isDirty;
+	//! Is chart dragged?
+	bool m_isDragging;
+	//! X of the start of the drag.
+	int m_dragX;
+	//! Visible period at the start of the drag.
+	qint64 m_dragViewFrom;
+	qint64 m_dragViewTo;
+	//! Timer of the reading steps.
+	QTimer * m_fetchTimer;
+	//! Timer to start reading after change of the view.
+	QTimer * m_delayTimer;
+}; // class LogSourcesChartPrivate
+
+void
+LogSourcesChartPrivate::addRecord()
+{
+	const Como::Source::Type type =
+		static_cast< Como::Source::Type > ( m_query.value( 2 ).toInt() );
+
+	if( type == Como::Source::String )
+		return;
+
+	double min = 0.0;
+	double max = 0.0;
+	bool ok = false;
+
+	if( m_resolution == SourcesLogRawResolution )
+	{
+		min = m_query.value( 5 ).toString().toDouble( &ok );
+		max = min;
+	}
+	else
+	{
+		bool maxOk = false;
+		min = m_query.value( 7 ).toString().toDouble( &ok );
+		max = m_query.value( 8 ).toString().toDouble( &maxOk );
+		ok = ok && maxOk;
+	}
+
+	if( !ok )
+		return;
+
+	const qint64 msecs = QDateTime::fromString(
+		m_query.value( 0 ).toString(), chartDateTimeFormat )
+			.toMSecsSinceEpoch();
+
+	const qint64 span = m_viewTo - m_viewFrom;
+	const int x = qBound( 0,
+		int( ( msecs - m_viewFrom ) * m_bucketsCount / span ),
+		m_bucketsCount - 1 );
+
+	const QString channelName = m_query.value( 1 ).toString();
+	const QString sourceName = m_query.value( 3 ).toString();
+	const QString typeName = m_query.value( 4 ).toString();
+
+	const QString key = channelName + QLatin1Char( '\n' ) + typeName +
+		QLatin1Char( '\n' ) + sourceName;
+
+	auto it = m_series.find( key );
+
+	if( it == m_series.end() )
+	{
+		ChartSeries s;
+		s.m_name = QString( "%1: %2 / %3" )
+			.arg( channelName, typeName, sourceName );
+		s.m_color = seriesColor( m_series.size() );
+		s.m_buckets.resize( m_bucketsCount );
+
+		it = m_series.insert( key, s );
+	}
+
+	it.value().m_buckets[ x ].add( min, max );
+}
+
+QColor
+LogSourcesChartPrivate::seriesColor( int i )
+{
+	static const Qt::GlobalColor colors[] = { Qt::blue, Qt::red,
+		Qt::darkGreen, Qt::magenta, Qt::darkCyan, Qt::darkYellow,
+		Qt::darkBlue, Qt::darkRed, Qt::darkMagenta, Qt::black };
+
+	return QColor( colors[ i % int( sizeof( colors ) / sizeof( colors[ 0 ] ) ) ] );
+}
+
+
+//
+// LogSourcesChart
+//
+
+LogSourcesChart::LogSourcesChart( QWidget * parent )
+	:	QWidget( parent )
+	,	d( new LogSourcesChartPrivate )
+{
+	setMinimumSize( 200, 100 );
+	setCursor( Qt::OpenHandCursor );
+
+	d->m_fetchTimer = new QTimer( this );
+	d->m_fetchTimer->setInterval( 0 );
+
+	d->m_delayTimer = new QTimer( this );
+	d->m_delayTimer->setSingleShot( true );
+	d->m_delayTimer->setInterval( chartFetchDelay );
+
+	connect( d->m_fetchTimer, &QTimer::timeout,
+		this, &LogSourcesChart::fetchStep );
+	connect( d->m_delayTimer, &QTimer::timeout,
+		this, &LogSourcesChart::startFetch );
+}
+
+LogSourcesChart::~LogSourcesChart()
+{
+}
+
+void
+LogSourcesChart::setSelection( const QDateTime & from,
+	const QDateTime & to,
+	const QString & channelName,
+	const QString & sourceName,
+	const QString & typeName )
+{
+	d->m_from = from.toMSecsSinceEpoch();
+	d->m_to = to.toMSecsSinceEpoch();
+	d->m_channelName = channelName;
+	d->m_sourceName = sourceName;
+	d->m_typeName = typeName;
+	d->m_series.clear();
+
+	setView( d->m_from, d->m_to );
+}
+
+void
+LogSourcesChart::clear()
+{
+	d->m_fetchTimer->stop();
+	d->m_delayTimer->stop();
+	d->m_query = SourcesLogCursor();
+	d->m_isSelecting = false;
+	d->m_from = 0;
+	d->m_to = 0;
+	d->m_series.clear();
+
+	update();
+}
+
+void
+LogSourcesChart::setView( qint64 from, qint64 to )
+{
+	if( to - from < chartMinViewMSecs )
+	{
+		const qint64 center = from + ( to - from ) / 2;
+		from = center - chartMinViewMSecs / 2;
+		to = from + chartMinViewMSecs;
+	}
+
+	d->m_viewFrom = from;
+	d->m_viewTo = to;
+
+	viewChanged();
+}
+
+void
+LogSourcesChart::viewChanged()
+{
+	d->m_fetchTimer->stop();
+	d->m_query = SourcesLogCursor();
+	d->m_isSelecting = false;
+
+	if( !d->hasSelection() )
+		return;
+
+	if( isVisible() )
+		d->m_delayTimer->start();
+	else
+		d->m_isDirty = true;
+
+	update();
+}
+
+void
+LogSourcesChart::startFetch()
+{
+	d->m_isDirty = false;
+	d->m_bucketsCount = qMax( 1, d->plotRect( rect() ).width() );
+
+	// Series are kept while panning and zooming so their colors
+	// don't change.
+	for( auto it = d->m_series.begin(), last = d->m_series.end();
+		it != last; ++it )
+	{
+		it.value().m_buckets.fill( ChartBucket(), d->m_bucketsCount );
+	}
+
+	d->m_resolution = Log::sourcesLogResolution(
+		( d->m_viewTo - d->m_viewFrom ) / 1000 / d->m_bucketsCount );
+	d->m_chunk = 0;
+	d->m_isSelecting = false;
+
+	d->m_fetchTimer->start();
+}
+
+void
+LogSourcesChart::fetchStep()
+{
+	const qint64 span = d->m_viewTo - d->m_viewFrom;
+
+	for( int i = 0; i < chartRecordsPerStep; ++i )
+	{
+		if( !d->m_isSelecting )
+		{
+			if( d->m_chunk == chartFetchChunks )
+			{
+				d->m_fetchTimer->stop();
+
+				break;
+			}
+
+			const qint64 from = d->m_viewFrom + span * d->m_chunk /
+				chartFetchChunks;
+			const qint64 to = d->m_viewFrom + span * ( d->m_chunk + 1 ) /
+				chartFetchChunks - 1;
+
+			++d->m_chunk;
+
+			if( to < d->m_from || from > d->m_to )
+				continue;
+
+			d->m_query = Log::instance().readSourcesLog(
+				QDateTime::fromMSecsSinceEpoch( qMax( from, d->m_from ) ),
+				QDateTime::fromMSecsSinceEpoch( qMin( to, d->m_to ) ),
+				d->m_channelName, d->m_sourceName, d->m_typeName,
+				d->m_resolution );
+			d->m_isSelecting = true;
+		}
+
+		if( d->m_query.next() )
+			d->addRecord();
+		else
+		{
+			d->m_query = SourcesLogCursor();
+			d->m_isSelecting = false;
+		}
+	}
+
+	update();
+}
+
+void
+LogSourcesChart::paintEvent( QPaintEvent * )
+{
+	QPainter p( this );
+	p.fillRect( rect(), palette().base() );
+
+	const QRect plot = d->plotRect( rect() );
+
+	p.setPen( palette().color( QPalette::Mid ) );
+	p.drawRect( plot );
+
+	if( !d->hasSelection() )
+		return;
+
+	p.setPen( palette().color( QPalette::Text ) );
+
+	const QString timeFormat = QLatin1String( "yyyy-MM-dd hh:mm:ss" );
+
+	p.drawText( QRect( plot.left(), plot.bottom() + 2, plot.width(),
+			chartBottomMargin - 2 ), Qt::AlignLeft | Qt::AlignVCenter,
+		QDateTime::fromMSecsSinceEpoch( d->m_viewFrom ).toString( timeFormat ) );
+	p.drawText( QRect( plot.left(), plot.bottom() + 2, plot.width(),
+			chartBottomMargin - 2 ), Qt::AlignRight | Qt::AlignVCenter,
+		QDateTime::fromMSecsSinceEpoch( d->m_viewTo ).toString( timeFormat ) );
+
+	double min = std::numeric_limits< double >::max();
+	double max = std::numeric_limits< double >::lowest();
+
+	for( const auto & s : std::as_const( d->m_series ) )
+	{
+		for( const auto & b : s.m_buckets )
+		{
+			if( b.m_isSet )
+			{
+				min = qMin( min, b.m_min );
+				max = qMax( max, b.m_max );
+			}
+		}
+	}
+
+	if( min > max )
+		return;
+
+	if( qFuzzyCompare( min, max ) )
+	{
+		min -= 1.0;
+		max += 1.0;
+	}
+
+	p.drawText( QRect( 0, plot.top(), chartLeftMargin - 4, 20 ),
+		Qt::AlignRight | Qt::AlignTop, QString::number( max, 'g', 6 ) );
+	p.drawText( QRect( 0, plot.bottom() - 20, chartLeftMargin - 4, 20 ),
+		Qt::AlignRight | Qt::AlignBottom, QString::number( min, 'g', 6 ) );
+
+	auto y = [&]( double v ) -> int
+	{
+		return plot.bottom() - int( ( v - min ) / ( max - min ) * plot.height() );
+	};
+
+	p.setClipRect( plot );
+
+	int legendY = plot.top() + p.fontMetrics().height();
+
+	for( const auto & s : std::as_const( d->m_series ) )
+	{
+		p.setPen( s.m_color );
+
+		int prevX = -1;
+		int prevY = 0;
+
+		const int count = qMin( s.m_buckets.size(), plot.width() );
+
+		for( int i = 0; i < count; ++i )
+		{
+			const ChartBucket & b = s.m_buckets.at( i );
+
+			if( !b.m_isSet )
+				continue;
+
+			const int x = plot.left() + i;
+			const int yMin = y( b.m_min );
+			const int yMax = y( b.m_max );
+
+			if( prevX >= 0 )
+				p.drawLine( prevX, prevY, x, ( yMin + yMax ) / 2 );
+
+			p.drawLine( x, yMin, x, yMax );
+
+			prevX = x;
+			prevY = ( yMin + yMax ) / 2;
+		}
+
+		p.drawText( plot.left() + 5, legendY, s.m_name );
+
+		legendY += p.fontMetrics().height();
+	}
+}
+
+void
+LogSourcesChart::resizeEvent( QResizeEvent * event )
+{
+	viewChanged();
+
+	QWidget::resizeEvent( event );
+}
+
+void
+LogSourcesChart::showEvent( QShowEvent * event )
+{
+	if( d->m_isDirty )
+		viewChanged();
+
+	QWidget::showEvent( event );
+}
+
+void
+LogSourcesChart::mousePressEvent( QMouseEvent * event )
+{
+	if( event->button() == Qt::LeftButton )
+	{
+		d->m_isDragging = true;
+		d->m_dragX = event->position().toPoint().x();
+		d->m_dragViewFrom = d->m_viewFrom;
+		d->m_dragViewTo = d->m_viewTo;
+
+		setCursor( Qt::ClosedHandCursor );
+
+		event->accept();
+	}
+	else
+		event->ignore();
+}
+
+void
+LogSourcesChart::mouseMoveEvent( QMouseEvent * event )
+{
+	if( d->m_isDragging && d->hasSelection() )
+	{
+		const int width = qMax( 1, d->plotRect( rect() ).width() );
+		const qint64 shift = qint64( d->m_dragX -
+			event->position().toPoint().x() ) *
+			( d->m_dragViewTo - d->m_dragViewFrom ) / width;
+
+		setView( d->m_dragViewFrom + shift, d->m_dragViewTo + shift );
+
+		event->accept();
+	}
+	else
+		event->ignore();
+}
+
+void
+LogSourcesChart::mouseReleaseEvent( QMouseEvent * event )
+{
+	if( d->m_isDragging )
+	{
+		d->m_isDragging = false;
+
+		setCursor( Qt::OpenHandCursor );
+
+		event->accept();
+	}
+	else
+		event->ignore();
+}
+
+void
+LogSourcesChart::mouseDoubleClickEvent( QMouseEvent * event )
+{
+	if( d->hasSelection() )
+		setView( d->m_from, d->m_to );
+
+	event->accept();
+}
+
+void
+LogSourcesChart::wheelEvent( QWheelEvent * event )
+{
+	if( !d->hasSelection() || event->angleDelta().y() == 0 )
+	{
+		event->ignore();
+
+		return;
+	}
+
+	const QRect plot = d->plotRect( rect() );
+	const qint64 span = d->m_viewTo - d->m_viewFrom;
+	const int x = qBound( 0, event->position().toPoint().x() - plot.left(),
+		plot.width() );
+	const qint64 anchor = d->m_viewFrom + span * x / qMax( 1, plot.width() );
+	const double factor = ( event->angleDelta().y() > 0 ?
+		chartZoomFactor : 1.0 / chartZoomFactor );
+
+	setView( anchor - qint64( ( anchor - d->m_viewFrom ) * factor ),
+		anchor + qint64( ( d->m_viewTo - anchor ) * factor ) );
+
+	event->accept();
+}
+
+} /* namespace Globe */
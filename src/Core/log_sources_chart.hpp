@@ -0,0 +1,89 @@
+
+/*
+	SPDX-FileCopyrightText: 2012-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#ifndef GLOBE__LOG_SOURCES_CHART_HPP__INCLUDED
+#define GLOBE__LOG_SOURCES_CHART_HPP__INCLUDED
+
+// Qt include.
+#include <QWidget>
+#include <QScopedPointer>
+#include <QDateTime>
+
+// Globe include.
+#include <Core/export.hpp>
+
+
+namespace Globe {
+
+//
+// LogSourcesChart
+//
+
+class LogSourcesChartPrivate;
+
+/*!
+	Chart of the numeric sources from the source's log.
+
+	Each source of the selection is a series. For every pixel column of
+	the chart only min and max values are kept, so count of points in
+	the log doesn't matter for drawing. Only visible period is read from
+	the log, by chunks of time in short steps on the event loop, with
+	rollups if a pixel covers a minute or an hour.
+
+	Drag with the mouse to pan, wheel to zoom, double click to show the
+	whole period.
+*/
+class CORE_EXPORT LogSourcesChart
+	:	public QWidget
+{
+	Q_OBJECT
+
+public:
+	LogSourcesChart( QWidget * parent = 0 );
+
+	~LogSourcesChart();
+
+	//! Set selection to show.
+	void setSelection( const QDateTime & from,
+		const QDateTime & to,
+		const QString & channelName,
+		const QString & sourceName,
+		const QString & typeName );
+
+	//! Clear.
+	void clear();
+
+protected:
+	void paintEvent( QPaintEvent * event ) override;
+	void resizeEvent( QResizeEvent * event ) override;
+	void showEvent( QShowEvent * event ) override;
+	void mousePressEvent( QMouseEvent * event ) override;
+	void mouseMoveEvent( QMouseEvent * event ) override;
+	void mouseReleaseEvent( QMouseEvent * event ) override;
+	void mouseDoubleClickEvent( QMouseEvent * event ) override;
+	void wheelEvent( QWheelEvent * event ) override;
+
+private slots:
+	//! Start reading of the visible period.
+	void startFetch();
+	//! Read next portion of the records.
+	void fetchStep();
+
+private:
+	//! Read visible period again.
+	void viewChanged();
+	//! Set visible period.
+	void setView( qint64 from, qint64 to );
+
+private:
+	Q_DISABLE_COPY( LogSourcesChart )
+
+	QScopedPointer< LogSourcesChartPrivate > d;
+}; // class LogSourcesChart
+
+} /* namespace Globe */
+
+#endif // GLOBE__LOG_SOURCES_CHART_HPP__INCLUDED
@@ -0,0 +1,488 @@
+
+/*
+	SPDX-FileCopyrightText: 2012-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// Globe include.
+#include <Core/log_sources_export.hpp>
+#include <Core/sources_log_encoding.hpp>
+
+// Qt include.
+#include <QFile>
+#include <QTimer>
+#include <QVariant>
+#include <QVector>
+#include <QStringList>
+#include <QDataStream>
+#include <QTime>
+
+
+namespace Globe {
+
+//! Magic number of the exported file.
+static const quint32 exportFileMagic = 0x474C5345;
+
+//! Magic number of the block of the exported file.
+static const quint32 exportBlockMagic = 0x474C5342;
+
+//! Version of the format of the exported file.
+static const quint16 exportFileVersion = 1;
+
+//! Max count of records in one block of the binary format.
+static const int maxExportBlockRecords = 4096;
+
+//! Count of records written in one step of the export.
+static const int exportRecordsPerStep = 2048;
+
+//! Length of the slice of the period read with one select, in msecs.
+static const qint64 exportSliceMSecs = 60 * 60 * 1000;
+
+//! Format of the date and time in the log.
+static const QString exportDateTimeFormat =
+	QLatin1String( "yyyy-MM-dd hh:mm:ss.zzz" );
+
+
+//
+// ExportRecord
+//
+
+//! Record of the source's log in the block of the binary format.
+struct ExportRecord {
+	ExportRecord()
+		:	m_msecs( 0 )
+		,	m_type( 0 )
+		,	m_count( 0 )
+	{
+	}
+
+	//! Date and time in msecs since epoch.
+	qint64 m_msecs;
+	//! Type of the source.
+	int m_type;
+	//! Channel name.
+	QString m_channelName;
+	//! Source name.
+	QString m_sourceName;
+	//! Type name.
+	QString m_typeName;
+	//! Value.
+	QString m_value;
+	//! Description.
+	QString m_desc;
+	//! Min value of the rollup.
+	QString m_min;
+	//! Max value of the rollup.
+	QString m_max;
+	//! Count of records in the rollup.
+	qint64 m_count;
+	//! Last value of the rollup.
+	QString m_last;
+}; // struct ExportRecord
+
+
+//! \return Field of CSV quoted if needed.
+static inline QString csvField( const QString & s )
+{
+	if( s.contains( QLatin1Char( ',' ) ) || s.contains( QLatin1Char( '"' ) ) ||
+		s.contains( QLatin1Char( '\n' ) ) || s.contains( QLatin1Char( '\r' ) ) )
+	{
+		QString q = s;
+		q.replace( QLatin1String( "\"" ), QLatin1String( "\"\"" ) );
+
+		return QLatin1Char( '"' ) + q + QLatin1Char( '"' );
+	}
+	else
+		return s;
+}
+
+
+//
+// LogSourcesExportPrivate
+//
+
+class LogSourcesExportPrivate {
+public:
+	LogSourcesExportPrivate( const QString & fileName,
+		LogSourcesExportFormat format,
+		const QDateTime & from,
+		const QDateTime & to,
+		const QString & channelName,
+		const QString & sourceName,
+		const QString & typeName,
+		SourcesLogResolution resolution )
+		:	m_file( fileName )
+		,	m_format( format )
+		,	m_from( from )
+		,	m_to( to )
+		,	m_channelName( channelName )
+		,	m_sourceName( sourceName )
+		,	m_typeName( typeName )
+		,	m_resolution( resolution )
+		,	m_isSelecting( false )
+		,	m_records( 0 )
+		,	m_timer( 0 )
+	{
+	}
+
+	//! \return Is record a rollup?
+	bool isRollup() const
+	{
+		return ( m_resolution != SourcesLogRawResolution );
+	}
+
+	//! Select next slice of the period. \return false if period is over.
+	bool selectNextSlice();
+	//! Append current record of the select to the buffer.
+	void appendRecord();
+	//! Encode collected block of the binary format into the buffer.
+	void encodeBlock();
+	//! Write header of the file into the buffer.
+	void writeHeader();
+	//! Write buffer to the file. \return false on error.
+	bool writeBuffer();
+	//! \return Progress in percents.
+	int percent() const;
+	//! Stop and remove file.
+	void abort();
+
+	//! File.
+	QFile m_file;
+	//! Format.
+	LogSourcesExportFormat m_format;
+	//! Start of the period.
+	QDateTime m_from;
+	//! End of the period.
+	QDateTime m_to;
+	//! Channel name.
+	QString m_channelName;
+	//! Source name.
+	QString m_sourceName;
+	//! Type name.
+	QString m_typeName;
+	//! Resolution.
+	SourcesLogResolution m_resolution;
+	//! Start of the next slice.
+	QDateTime m_sliceStart;
+	//! Select of the current slice.
+	SourcesLogCursor m_query;
+	//! Is current slice being read?
+	bool m_isSelecting;
+	//! Date and time of the last written record.
+	QString m_lastDateTime;
+	//! Count of written records.
+	qint64 m_records;
+	//! Encoded data not yet written to the file.
+	QByteArray m_buffer;
+	//! Records of the current block of the binary format.
+	QVector< ExportRecord > m_block;
+	//! Timer of the steps.
+	QTimer * m_timer;
+}; // class LogSourcesExportPrivate
+
+bool
+LogSourcesExportPrivate::selectNextSlice()
+{
+	if( m_sliceStart > m_to )
+		return false;
+
+	// Slices are aligned to the hour as buckets of rollups are,
+	// so no rollup is read twice.
+	const QDateTime sliceEnd = QDateTime( m_sliceStart.date(),
+		QTime( m_sliceStart.time().hour(), 0 ) )
+			.addMSecs( exportSliceMSecs - 1 );
+	const QDateTime to = qMin( sliceEnd, m_to );
+
+	m_query = Log::instance().readSourcesLog( m_sliceStart, to,
+		m_channelName, m_sourceName, m_typeName, m_resolution );
+
+	m_sliceStart = to.addMSecs( 1 );
+	m_isSelecting = true;
+
+	return true;
+}
+
+void
+LogSourcesExportPrivate::appendRecord()
+{
+	m_lastDateTime = m_query.value( 0 ).toString();
+
+	if( m_format == LogSourcesExportCsv )
+	{
+		QStringList fields;
+
+		fields << csvField( m_lastDateTime )
+			<< csvField( m_query.value( 1 ).toString() )
+			<< m_query.value( 2 ).toString()
+			<< csvField( m_query.value( 3 ).toString() )
+			<< csvField( m_query.value( 4 ).toString() )
+			<< csvField( m_query.value( 5 ).toString() )
+			<< csvField( m_query.value( 6 ).toString() );
+
+		if( isRollup() )
+			fields << csvField( m_query.value( 7 ).toString() )
+				<< csvField( m_query.value( 8 ).toString() )
+				<< m_query.value( 9 ).toString()
+				<< csvField( m_query.value( 10 ).toString() );
+
+		m_buffer.append( fields.join( QLatin1Char( ',' ) ).toUtf8() );
+		m_buffer.append( "\r\n" );
+	}
+	else
+	{
+		ExportRecord r;
+		r.m_msecs = QDateTime::fromString( m_lastDateTime,
+			exportDateTimeFormat ).toMSecsSinceEpoch();
+		r.m_channelName = m_query.value( 1 ).toString();
+		r.m_type = m_query.value( 2 ).toInt();
+		r.m_sourceName = m_query.value( 3 ).toString();
+		r.m_typeName = m_query.value( 4 ).toString();
+		r.m_value = m_query.value( 5 ).toString();
+		r.m_desc = m_query.value( 6 ).toString();
+
+		if( isRollup() )
+		{
+			r.m_min = m_query.value( 7 ).toString();
+			r.m_max = m_query.value( 8 ).toString();
+			r.m_count = m_query.value( 9 ).toLongLong();
+			r.m_last = m_query.value( 10 ).toString();
+		}
+
+		m_block.append( r );
+
+		if( m_block.size() == maxExportBlockRecords )
+			encodeBlock();
+	}
+
+	++m_records;
+}
+
+void
+LogSourcesExportPrivate::encodeBlock()
+{
+	if( m_block.isEmpty() )
+		return;
+
+	const qint64 first = m_block.first().m_msecs;
+
+	SourcesLogBlockEncoder encoder( first );
+
+	for( const auto & r : std::as_const( m_block ) )
+	{
+		encoder.add( r.m_msecs, r.m_type, r.m_channelName, r.m_sourceName,
+			r.m_typeName, r.m_value, r.m_desc );
+
+		if( isRollup() )
+		{
+			writeString( encoder.extra(), r.m_min );
+			writeString( encoder.extra(), r.m_max );
+			writeVarint( encoder.extra(), quint64( r.m_count ) );
+			writeString( encoder.extra(), r.m_last );
+		}
+	}
+
+	const QByteArray compressed = qCompress( encoder.payload() );
+
+	QDataStream stream( &m_buffer, QIODevice::WriteOnly | QIODevice::Append );
+	stream << exportBlockMagic << quint32( m_block.size() ) << first
+		<< quint32( compressed.size() );
+
+	m_buffer.append( compressed );
+
+	m_block.clear();
+}
+
+void
+LogSourcesExportPrivate::writeHeader()
+{
+	if( m_format == LogSourcesExportCsv )
+	{
+		m_buffer.append( "dateTime,channelName,type,sourceName,typeName,"
+			"value,desc" );
+
+		if( isRollup() )
+			m_buffer.append( ",min,max,count,last" );
+
+		m_buffer.append( "\r\n" );
+	}
+	else
+	{
+		QDataStream stream( &m_buffer, QIODevice::WriteOnly | QIODevice::Append );
+		stream << exportFileMagic << exportFileVersion
+			<< qint32( m_resolution );
+	}
+}
+
+bool
+LogSourcesExportPrivate::writeBuffer()
+{
+	if( m_buffer.isEmpty() )
+		return true;
+
+	const bool ok = ( m_file.write( m_buffer ) == m_buffer.size() );
+
+	m_buffer.clear();
+
+	return ok;
+}
+
+int
+LogSourcesExportPrivate::percent() const
+{
+	const qint64 total = m_from.msecsTo( m_to );
+
+	if( total <= 0 )
+		return 100;
+
+	const QDateTime pos = ( m_lastDateTime.isEmpty() ? m_from :
+		QDateTime::fromString( m_lastDateTime, exportDateTimeFormat ) );
+
+	return qBound( 0, int( m_from.msecsTo( pos ) * 100 / total ), 100 );
+}
+
+void
+LogSourcesExportPrivate::abort()
+{
+	m_timer->stop();
+	m_query = SourcesLogCursor();
+	m_isSelecting = false;
+	m_buffer.clear();
+	m_block.clear();
+
+	if( m_file.isOpen() )
+		m_file.close();
+
+	m_file.remove();
+}
+
+
+//
+// LogSourcesExport
+//
+
+LogSourcesExport::LogSourcesExport( const QString & fileName,
+	LogSourcesExportFormat format,
+	const QDateTime & from,
+	const QDateTime & to,
+	const QString & channelName,
+	const QString & sourceName,
+	const QString & typeName,
+	SourcesLogResolution resolution,
+	QObject * parent )
+	:	QObject( parent )
+	,	d( new LogSourcesExportPrivate( fileName, format, from, to,
+			channelName, sourceName, typeName, resolution ) )
+{
+	d->m_timer = new QTimer( this );
+	d->m_timer->setInterval( 0 );
+
+	connect( d->m_timer, &QTimer::timeout,
+		this, &LogSourcesExport::step );
+}
+
+LogSourcesExport::~LogSourcesExport()
+{
+	if( isRunning() )
+		d->abort();
+}
+
+bool
+LogSourcesExport::isRunning() const
+{
+	return d->m_timer->isActive();
+}
+
+qint64
+LogSourcesExport::records() const
+{
+	return d->m_records;
+}
+
+void
+LogSourcesExport::start()
+{
+	if( isRunning() )
+		return;
+
+	if( !d->m_file.open( QIODevice::WriteOnly | QIODevice::Truncate ) )
+	{
+		emit failed( tr( "Unable to open file \"%1\"." )
+			.arg( d->m_file.fileName() ) );
+
+		return;
+	}
+
+	d->m_sliceStart = d->m_from;
+	d->m_isSelecting = false;
+	d->m_lastDateTime.clear();
+	d->m_records = 0;
+
+	d->writeHeader();
+
+	d->m_timer->start();
+}
+
+void
+LogSourcesExport::cancel()
+{
+	if( !isRunning() )
+		return;
+
+	d->abort();
+
+	emit canceled();
+}
+
+void
+LogSourcesExport::step()
+{
+	for( int i = 0; i < exportRecordsPerStep; ++i )
+	{
+		if( !d->m_isSelecting && !d->selectNextSlice() )
+		{
+			d->m_timer->stop();
+			d->encodeBlock();
+
+			if( !d->writeBuffer() )
+			{
+				fail( d->m_file.errorString() );
+
+				return;
+			}
+
+			d->m_file.close();
+
+			emit progress( 100, d->m_records );
+			emit finished();
+
+			return;
+		}
+
+		if( d->m_query.next() )
+			d->appendRecord();
+		else
+		{
+			d->m_query = SourcesLogCursor();
+			d->m_isSelecting = false;
+		}
+	}
+
+	if( !d->writeBuffer() )
+	{
+		fail( d->m_file.errorString() );
+
+		return;
+	}
+
+	emit progress( d->percent(), d->m_records );
+}
+
+void
+LogSourcesExport::fail( const QString & reason )
+{
+	d->abort();
+
+	emit failed( reason );
+}
+
+} /* namespace Globe */
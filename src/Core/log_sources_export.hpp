@@ -0,0 +1,117 @@
+
+/*
+	SPDX-FileCopyrightText: 2012-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#ifndef GLOBE__LOG_SOURCES_EXPORT_HPP__INCLUDED
+#define GLOBE__LOG_SOURCES_EXPORT_HPP__INCLUDED
+
+// Qt include.
+#include <QObject>
+#include <QScopedPointer>
+#include <QDateTime>
+
+// Globe include.
+#include <Core/log.hpp>
+#include <Core/export.hpp>
+
+
+namespace Globe {
+
+//
+// LogSourcesExportFormat
+//
+
+//! Format of the exported source's log.
+enum LogSourcesExportFormat {
+	//! Comma separated values with the header line.
+	LogSourcesExportCsv = 0,
+	/*!
+		Compact columnar binary format.
+
+		File starts with magic 0x474C5345, version (quint16) and
+		resolution (qint32). Then blocks of up to 4096 records follow.
+		Each block has header with magic 0x474C5342, count of records,
+		first date and time in msecs since epoch and size of the
+		payload, and qCompress'ed payload: dictionary of strings,
+		zigzag varint delta encoded timestamps, types, dictionary ids of
+		channel, source, type names and descriptions, values. Rollups
+		additionally have min, max, count and last value columns.
+		Byte order is big endian.
+	*/
+	LogSourcesExportBinary = 1
+}; // enum LogSourcesExportFormat
+
+
+//
+// LogSourcesExport
+//
+
+class LogSourcesExportPrivate;
+
+/*!
+	Export of the source's log into the file.
+
+	Records are streamed from the log straight to the file in short
+	steps on the event loop, the period is read by slices of one hour,
+	so memory used by the export doesn't depend on the size of the
+	period.
+*/
+class CORE_EXPORT LogSourcesExport
+	:	public QObject
+{
+	Q_OBJECT
+
+signals:
+	//! Progress of the export in percents and count of written records.
+	void progress( int percent, qint64 records );
+	//! Export finished successfully.
+	void finished();
+	//! Export canceled, file removed.
+	void canceled();
+	//! Export failed, file removed.
+	void failed( const QString & reason );
+
+public:
+	LogSourcesExport( const QString & fileName,
+		LogSourcesExportFormat format,
+		const QDateTime & from,
+		const QDateTime & to,
+		const QString & channelName,
+		const QString & sourceName,
+		const QString & typeName,
+		SourcesLogResolution resolution,
+		QObject * parent = 0 );
+
+	~LogSourcesExport();
+
+	//! \return Is export running?
+	bool isRunning() const;
+
+	//! \return Count of written records.
+	qint64 records() const;
+
+public slots:
+	//! Start export.
+	void start();
+	//! Cancel export.
+	void cancel();
+
+private slots:
+	//! Export next portion of records.
+	void step();
+
+private:
+	//! Stop with error.
+	void fail( const QString & reason );
+
+private:
+	Q_DISABLE_COPY( LogSourcesExport )
+
+	QScopedPointer< LogSourcesExportPrivate > d;
+}; // class LogSourcesExport
+
+} /* namespace Globe */
+
+#endif // GLOBE__LOG_SOURCES_EXPORT_HPP__INCLUDED
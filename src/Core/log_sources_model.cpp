@@ -9,6 +9,7 @@
 
 // Qt include.
 #include <QList>
+#include <QVariant>
 
 
 namespace Globe {
@@ -96,8 +97,8 @@ public:
 	{
 	}
 
-	//! Data.
-	QList< LogSourcesRecord > m_data;
+	//! Rows.
+	LogLazyRows< LogSourcesRecord, SourcesLogCursor > m_rows;
 }; // class LogSourcesModelPrivate
 
 
@@ -115,25 +116,45 @@ LogSourcesModel::~LogSourcesModel()
 {
 }
 
-const LogSourcesRecord &
+LogSourcesRecord
 LogSourcesModel::record( const QModelIndex & index ) const
 {
-	return d->m_data.at( index.row() );
+	return d->m_rows.at( index.row() );
 }
 
 void
-LogSourcesModel::initModel( const QList< LogSourcesRecord > & data )
+LogSourcesModel::initModel( const QDateTime & from,
+	const LogLazyRows< LogSourcesRecord, SourcesLogCursor >::Select & select,
+	SourcesLogResolution resolution )
 {
-	clear();
-
-	if( !data.isEmpty() )
+	auto read = [resolution]( const SourcesLogCursor & query ) -> LogSourcesRecord
 	{
-		beginInsertRows( QModelIndex(), 0, data.size() - 1 );
+		QString desc = query.value( 6 ).toString();
+
+		if( resolution != SourcesLogRawResolution )
+			desc = tr( "Min: %1, max: %2, count: %3, last: %4. %5" )
+				.arg( query.value( 7 ).toString(),
+					query.value( 8 ).toString(),
+					query.value( 9 ).toString(),
+					query.value( 10 ).toString(),
+					desc );
+
+		return LogSourcesRecord( query.value( 0 ).toString(),
+			query.value( 1 ).toString(),
+			Como::Source( (Como::Source::Type) query.value( 2 ).toInt(),
+				query.value( 3 ).toString(),
+				query.value( 4 ).toString(),
+				query.value( 5 ),
+				desc ) );
+	};
 
-		d->m_data = data;
+	beginResetModel();
 
-		endInsertRows();
-	}
+	d->m_rows.reset( from, select, read, 0 );
+
+	endResetModel();
+
+	fetchMore( QModelIndex() );
 }
 
 void
@@ -141,7 +162,7 @@ LogSourcesModel::clear()
 {
 	beginResetModel();
 
-	d->m_data.clear();
+	d->m_rows.clear();
 
 	endResetModel();
 }
@@ -150,11 +171,39 @@ int
 LogSourcesModel::rowCount( const QModelIndex & parent ) const
 {
 	if( !parent.isValid() )
-		return d->m_data.size();
+		return d->m_rows.size();
 	else
 		return 0;
 }
 
+bool
+LogSourcesModel::canFetchMore( const QModelIndex & parent ) const
+{
+	if( !parent.isValid() )
+		return d->m_rows.canFetchMore();
+	else
+		return false;
+}
+
+void
+LogSourcesModel::fetchMore( const QModelIndex & parent )
+{
+	if( parent.isValid() )
+		return;
+
+	const int count = d->m_rows.fetch();
+
+	if( count > 0 )
+	{
+		beginInsertRows( QModelIndex(), d->m_rows.size(),
+			d->m_rows.size() + count - 1 );
+
+		d->m_rows.commitFetched();
+
+		endInsertRows();
+	}
+}
+
 int
 LogSourcesModel::columnCount( const QModelIndex & parent ) const
 {
@@ -177,20 +226,22 @@ LogSourcesModel::data( const QModelIndex & index, int role ) const
 
 	if( role == Qt::DisplayRole )
 	{
+		const LogSourcesRecord record = d->m_rows.at( index.row() );
+
 		switch( column )
 		{
 			case dateTimeColumn :
-				return d->m_data[ index.row() ].dateTime();
+				return record.dateTime();
 			case channelNameColumn :
-				return d->m_data[ index.row() ].channelName();
+				return record.channelName();
 			case typeNameColumn :
-				return d->m_data[ index.row() ].source().typeName();
+				return record.source().typeName();
 			case sourceNameColumn :
-				return d->m_data[ index.row() ].source().name();
+				return record.source().name();
 			case valueColumn :
-				return d->m_data[ index.row() ].source().value();
+				return record.source().value();
 			case descriptionColumn :
-				return d->m_data[ index.row() ].source().description();
+				return record.source().description();
 			default :
 				return QVariant();
 		}
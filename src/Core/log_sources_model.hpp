@@ -14,6 +14,10 @@
 // Como include.
 #include <Como/Source>
 
+// Globe include.
+#include <Core/log.hpp>
+#include <Core/log_lazy_rows.hpp>
+
 
 namespace Globe {
 
@@ -65,7 +69,7 @@ private:
 
 class LogSourcesModelPrivate;
 
-//! Model for the sources log.
+//! Model for the sources log. Rows are fetched on demand.
 class LogSourcesModel
 	:	public QAbstractTableModel
 {
@@ -77,10 +81,16 @@ public:
 	~LogSourcesModel();
 
 	//! \return Record.
-	const LogSourcesRecord & record( const QModelIndex & index ) const;
+	LogSourcesRecord record( const QModelIndex & index ) const;
 
-	//! Init model.
-	void initModel( const QList< LogSourcesRecord > & data );
+	/*!
+		Init model with the select from the source's log. \a select is
+		called with \a from and later with date and time of the block
+		of rows to read again.
+	*/
+	void initModel( const QDateTime & from,
+		const LogLazyRows< LogSourcesRecord, SourcesLogCursor >::Select & select,
+		SourcesLogResolution resolution );
 
 	//! Clear model.
 	void clear();
@@ -97,6 +107,10 @@ public:
 	//! \return Header data.
 	QVariant headerData( int section, Qt::Orientation orientation,
 		int role = Qt::DisplayRole ) const;
+	//! \return Are there not fetched rows?
+	bool canFetchMore( const QModelIndex & parent ) const;
+	//! Fetch next block of rows.
+	void fetchMore( const QModelIndex & parent );
 
 private:
 	Q_DISABLE_COPY( LogSourcesModel )
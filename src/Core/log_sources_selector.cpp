@@ -21,6 +21,13 @@
 
 namespace Globe {
 
+//! Automatic resolution of the source's log.
+static const int autoResolution = -1;
+
+//! Max number of records to read with automatic resolution.
+static const qint64 maxRecordsWithAutoResolution = 10000;
+
+
 //
 // LogSourcesSelectorPrivate
 //
@@ -60,6 +67,14 @@ LogSourcesSelector::init()
 
 	d->m_ui.m_channel->addItems( SourcesManager::instance().channelsNames() );
 
+	d->m_ui.m_resolution->addItem( tr( "Auto" ), autoResolution );
+	d->m_ui.m_resolution->addItem( tr( "All Records" ),
+		SourcesLogRawResolution );
+	d->m_ui.m_resolution->addItem( tr( "1 Minute" ),
+		SourcesLogMinuteResolution );
+	d->m_ui.m_resolution->addItem( tr( "1 Hour" ),
+		SourcesLogHourResolution );
+
 	connect( d->m_ui.m_fromLaunchButton, &QToolButton::clicked,
 		this, &LogSourcesSelector::setStartTimeToLaunchTime );
 	connect( d->m_ui.m_toCurrentTimeButton, &QToolButton::clicked,
@@ -112,6 +127,55 @@ LogSourcesSelector::sourceName() const
 	return d->m_ui.m_name->currentText();
 }
 
+SourcesLogResolution
+LogSourcesSelector::resolution() const
+{
+	const int r = d->m_ui.m_resolution->currentData().toInt();
+
+	if( r == autoResolution )
+	{
+		const SourcesLogResolution resolution = Log::sourcesLogResolution(
+			startDateTime().secsTo( endDateTime() ) /
+				maxRecordsWithAutoResolution );
+
+		// Records of not numeric sources are only raw ones.
+		if( resolution != SourcesLogRawResolution && !hasRollups() )
+			return SourcesLogRawResolution;
+
+		return resolution;
+	}
+	else
+		return static_cast< SourcesLogResolution > ( r );
+}
+
+bool
+LogSourcesSelector::isAutoResolution() const
+{
+	return ( d->m_ui.m_resolution->currentData().toInt() == autoResolution );
+}
+
+bool
+LogSourcesSelector::hasRollups() const
+{
+	const QString type = typeName();
+	const QString name = sourceName();
+
+	const QList< Como::Source > sources =
+		SourcesManager::instance().sources( channelName() );
+
+	for( const Como::Source & s : sources )
+	{
+		if( ( !type.isEmpty() && s.typeName() != type ) ||
+			( !name.isEmpty() && s.name() != name ) )
+				continue;
+
+		if( !Log::hasSourcesLogRollups( s.type() ) )
+			return false;
+	}
+
+	return true;
+}
+
 void
 LogSourcesSelector::setStartTimeToLaunchTime()
 {
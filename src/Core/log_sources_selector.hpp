@@ -15,6 +15,9 @@
 // Como include.
 #include <Como/Source>
 
+// Globe include.
+#include <Core/log.hpp>
+
 
 namespace Globe {
 
@@ -57,6 +60,12 @@ public:
 	//! \return Source name.
 	QString sourceName() const;
 
+	//! \return Resolution of the source's log to read.
+	SourcesLogResolution resolution() const;
+
+	//! \return Is resolution selected automatically?
+	bool isAutoResolution() const;
+
 private slots:
 	//! Set start time to the launching app time.
 	void setStartTimeToLaunchTime();
@@ -80,6 +89,8 @@ private:
 	void clearTypes();
 	//! Clear names.
 	void clearNames();
+	//! \return Are there rollups for all selected sources?
+	bool hasRollups() const;
 
 private:
 	Q_DISABLE_COPY( LogSourcesSelector )
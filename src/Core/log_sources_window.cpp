@@ -10,9 +10,12 @@
 #include <Core/log.hpp>
 #include <Core/log_sources_selector.hpp>
 #include <Core/log_sources_view.hpp>
+#include <Core/log_sources_model.hpp>
 #include <Core/select_query_navigation.hpp>
 #include <Core/log_sources_window_cfg.hpp>
 #include <Core/globe_menu.hpp>
+#include <Core/log_sources_export.hpp>
+#include <Core/log_sources_chart.hpp>
 
 // Qt include.
 #include <QCloseEvent>
@@ -21,9 +24,14 @@
 #include <QMessageBox>
 #include <QHBoxLayout>
 #include <QWidget>
-#include <QSqlQuery>
+#include <QScrollBar>
+#include <QApplication>
 #include <QCoreApplication>
 #include <QFile>
+#include <QFileDialog>
+#include <QProgressDialog>
+#include <QAction>
+#include <QTabWidget>
 
 // cfgfile include.
 #include <cfgfile/all.hpp>
@@ -31,6 +39,22 @@
 
 namespace Globe {
 
+//! \return Select from the source's log.
+static LogLazyRows< LogSourcesRecord, SourcesLogCursor >::Select selectFromSourcesLog(
+	const QDateTime & to,
+	const QString & channelName,
+	const QString & sourceName,
+	const QString & typeName,
+	SourcesLogResolution resolution )
+{
+	return [=]( const QDateTime & from )
+		{
+			return Log::instance().readSourcesLog( from, to,
+				channelName, sourceName, typeName, resolution );
+		};
+}
+
+
 //
 // LogSourcesWindowPrivate
 //
@@ -41,10 +65,11 @@ public:
 		:	m_toolWindowObject( 0 )
 		,	m_selector( 0 )
 		,	m_view( 0 )
-		,	m_logPageSize( 100 )
-		,	m_havePrevLogPage( false )
-		,	m_haveNextLogPage( false )
-		,	m_pos( 0 )
+		,	m_chart( 0 )
+		,	m_exportToCsvAction( 0 )
+		,	m_exportToBinaryAction( 0 )
+		,	m_export( 0 )
+		,	m_exportProgress( 0 )
 	{
 	}
 
@@ -54,16 +79,16 @@ public:
 	LogSourcesSelector * m_selector;
 	//! View.
 	LogSourcesView * m_view;
-	//! Query.
-	QSqlQuery m_query;
-	//! Size of the log page.
-	int m_logPageSize;
-	//! Have previous log page.
-	bool m_havePrevLogPage;
-	//! Have next log page.
-	bool m_haveNextLogPage;
-	//! Position in query.
-	int m_pos;
+	//! Chart.
+	LogSourcesChart * m_chart;
+	//! Export to CSV action.
+	QAction * m_exportToCsvAction;
+	//! Export to binary action.
+	QAction * m_exportToBinaryAction;
+	//! Running export.
+	LogSourcesExport * m_export;
+	//! Progress of the export.
+	QProgressDialog * m_exportProgress;
 }; // class LogSourcesWindowPrivate
 
 
@@ -218,6 +243,10 @@ LogSourcesWindow::initMenu( const Menu & menu )
 {
 	menuBar()->addMenu( menu.fileMenu() );
 
+	QMenu * exportMenu = menuBar()->addMenu( tr( "&Export" ) );
+	exportMenu->addAction( d->m_exportToCsvAction );
+	exportMenu->addAction( d->m_exportToBinaryAction );
+
 	QMenu * toolsMenu = menuBar()->addMenu( tr( "&Tools" ) );
 
 	foreach( ToolWindowObject * obj, menu.toolWindows() )
@@ -250,15 +279,30 @@ LogSourcesWindow::init()
 
 	d->m_selector = new LogSourcesSelector( centralWidget );
 
-	setNavigationButtons();
+	QTabWidget * tabs = new QTabWidget( centralWidget );
+
+	d->m_view = new LogSourcesView( tabs );
+
+	d->m_chart = new LogSourcesChart( tabs );
 
-	d->m_view = new LogSourcesView( centralWidget );
+	tabs->addTab( d->m_view, tr( "Table" ) );
+	tabs->addTab( d->m_chart, tr( "Chart" ) );
+
+	setNavigationButtons();
 
 	layout->addWidget( d->m_selector );
-	layout->addWidget( d->m_view );
+	layout->addWidget( tabs );
 
 	setCentralWidget( centralWidget );
 
+	d->m_exportToCsvAction = new QAction( tr( "To &CSV..." ), this );
+	d->m_exportToBinaryAction = new QAction( tr( "To &Binary..." ), this );
+
+	connect( d->m_exportToCsvAction, &QAction::triggered,
+		this, &LogSourcesWindow::exportToCsv );
+	connect( d->m_exportToBinaryAction, &QAction::triggered,
+		this, &LogSourcesWindow::exportToBinary );
+
 	connect( d->m_selector->navigationWidget(),
 		&SelectQueryNavigation::executeButtonClicked,
 		this, &LogSourcesWindow::selectFromLog );
@@ -279,199 +323,190 @@ LogSourcesWindow::init()
 void
 LogSourcesWindow::setNavigationButtons()
 {
-	if( d->m_havePrevLogPage )
-		d->m_selector->navigationWidget()->enablePreviousButtons( true );
-	else
-		d->m_selector->navigationWidget()->enablePreviousButtons( false );
+	const bool hasRows = ( d->m_view->model()->rowCount() > 0 );
 
-	if( d->m_haveNextLogPage )
-		d->m_selector->navigationWidget()->enableNextButtons( true );
-	else
-		d->m_selector->navigationWidget()->enableNextButtons( false );
+	d->m_selector->navigationWidget()->enablePreviousButtons( hasRows );
+	d->m_selector->navigationWidget()->enableNextButtons( hasRows );
 }
 
-QList< LogSourcesRecord >
-LogSourcesWindow::readLog()
+void
+LogSourcesWindow::selectFromLog()
 {
-	QList< LogSourcesRecord > records;
-
-	int size = 0;
+	const QDateTime to = d->m_selector->endDateTime();
+	const QString channelName = d->m_selector->channelName();
+	const QString sourceName = d->m_selector->sourceName();
+	const QString typeName = d->m_selector->typeName();
+	const SourcesLogResolution resolution = d->m_selector->resolution();
+
+	d->m_view->model()->initModel( d->m_selector->startDateTime(),
+		selectFromSourcesLog( to, channelName, sourceName, typeName,
+			resolution ),
+		resolution );
+
+	// Sources not known now could be not numeric ones without rollups.
+	if( resolution != SourcesLogRawResolution &&
+		d->m_selector->isAutoResolution() &&
+		d->m_view->model()->rowCount() == 0 )
+			d->m_view->model()->initModel( d->m_selector->startDateTime(),
+				selectFromSourcesLog( to, channelName, sourceName, typeName,
+					SourcesLogRawResolution ),
+				SourcesLogRawResolution );
+
+	d->m_chart->setSelection( d->m_selector->startDateTime(), to,
+		channelName, sourceName, typeName );
 
-	do
-	{
-		LogSourcesRecord record( d->m_query.value( 0 ).toString(),
-			d->m_query.value( 1 ).toString(),
-			Como::Source( (Como::Source::Type) d->m_query.value( 2 ).toInt(),
-				d->m_query.value( 3 ).toString(),
-				d->m_query.value( 4 ).toString(),
-				d->m_query.value( 5 ),
-				d->m_query.value( 6 ).toString() ) );
-
-		records.append( record );
-
-		++size;
-		++d->m_pos;
-
-		if( size == d->m_logPageSize )
-			break;
-	} while( d->m_query.next() );
+	setNavigationButtons();
 
-	return records;
+	d->m_view->resizeColumnToContents( 0 );
 }
 
-QList< LogSourcesRecord >
-LogSourcesWindow::readLogFirstTime()
+void
+LogSourcesWindow::nextLogPage()
 {
-	QList< LogSourcesRecord > records;
-
-	int size = 0;
-
-	while( d->m_query.next() )
-	{
-		LogSourcesRecord record( d->m_query.value( 0 ).toString(),
-			d->m_query.value( 1 ).toString(),
-			Como::Source( (Como::Source::Type) d->m_query.value( 2 ).toInt(),
-				d->m_query.value( 3 ).toString(),
-				d->m_query.value( 4 ).toString(),
-				d->m_query.value( 5 ),
-				d->m_query.value( 6 ).toString() ) );
-
-		records.append( record );
-
-		++size;
-		++d->m_pos;
-
-		if( size == d->m_logPageSize )
-			break;
-	}
-
-	return records;
+	d->m_view->verticalScrollBar()->triggerAction(
+		QAbstractSlider::SliderPageStepAdd );
 }
 
 void
-LogSourcesWindow::selectFromLog()
+LogSourcesWindow::prevLogPage()
 {
-	d->m_pos = 0;
-	d->m_haveNextLogPage = false;
-	d->m_havePrevLogPage = false;
-
-	d->m_query = Log::instance().readSourcesLog( d->m_selector->startDateTime(),
-		d->m_selector->endDateTime(),
-		d->m_selector->channelName(),
-		d->m_selector->sourceName(),
-		d->m_selector->typeName() );
-
-	QList< LogSourcesRecord > records = readLogFirstTime();
-
-	if( d->m_query.next() )
-		d->m_haveNextLogPage = true;
-	else
-		d->m_haveNextLogPage = false;
-
-	setNavigationButtons();
-
-	d->m_view->model()->initModel( records );
-
-	d->m_view->resizeColumnToContents( 0 );
+	d->m_view->verticalScrollBar()->triggerAction(
+		QAbstractSlider::SliderPageStepSub );
 }
 
 void
-LogSourcesWindow::nextLogPage()
+LogSourcesWindow::goToFirstLogPage()
 {
-	d->m_havePrevLogPage = true;
-
-	QList< LogSourcesRecord > records;
+	d->m_view->scrollToTop();
+}
 
-	if( d->m_query.seek( d->m_pos ) )
-	{
-		records = readLog();
+void
+LogSourcesWindow::goToLastLogPage()
+{
+	QApplication::setOverrideCursor( Qt::WaitCursor );
 
-		if( d->m_query.next() )
-			d->m_haveNextLogPage = true;
-		else
-		{
-			d->m_haveNextLogPage = false;
-			d->m_pos += ( d->m_logPageSize - ( d->m_pos % d->m_logPageSize ) );
-		}
-	}
-	else
-		d->m_haveNextLogPage = false;
+	// Only the last blocks stay in memory.
+	while( d->m_view->model()->canFetchMore( QModelIndex() ) )
+		d->m_view->model()->fetchMore( QModelIndex() );
 
-	setNavigationButtons();
+	QApplication::restoreOverrideCursor();
 
-	d->m_view->model()->initModel( records );
+	d->m_view->scrollToBottom();
 }
 
 void
-LogSourcesWindow::prevLogPage()
+LogSourcesWindow::exportToCsv()
 {
-	d->m_haveNextLogPage = true;
-
-	QList< LogSourcesRecord > records;
+	exportLog( LogSourcesExportCsv );
+}
 
-	d->m_pos -= ( d->m_logPageSize * 2 );
+void
+LogSourcesWindow::exportToBinary()
+{
+	exportLog( LogSourcesExportBinary );
+}
 
-	if( !d->m_pos )
-		d->m_havePrevLogPage = false;
+void
+LogSourcesWindow::exportLog( LogSourcesExportFormat format )
+{
+	if( d->m_export )
+		return;
+
+	const QString fileName = QFileDialog::getSaveFileName( this,
+		tr( "Export Sources Log" ), QString(),
+		( format == LogSourcesExportCsv ? tr( "CSV (*.csv)" ) :
+			tr( "Sources Log (*.glsx)" ) ) );
+
+	if( fileName.isEmpty() )
+		return;
+
+	d->m_export = new LogSourcesExport( fileName, format,
+		d->m_selector->startDateTime(), d->m_selector->endDateTime(),
+		d->m_selector->channelName(), d->m_selector->sourceName(),
+		d->m_selector->typeName(), d->m_selector->resolution(), this );
+
+	d->m_exportProgress = new QProgressDialog(
+		tr( "Exporting sources log into \"%1\"..." ).arg( fileName ),
+		tr( "Cancel" ), 0, 100, this );
+	d->m_exportProgress->setWindowModality( Qt::WindowModal );
+	d->m_exportProgress->setMinimumDuration( 0 );
+	d->m_exportProgress->setValue( 0 );
+
+	connect( d->m_exportProgress, &QProgressDialog::canceled,
+		d->m_export, &LogSourcesExport::cancel );
+	connect( d->m_export, &LogSourcesExport::progress,
+		this, &LogSourcesWindow::exportProgress );
+	connect( d->m_export, &LogSourcesExport::finished,
+		this, &LogSourcesWindow::exportFinished );
+	connect( d->m_export, &LogSourcesExport::canceled,
+		this, &LogSourcesWindow::exportCanceled );
+	connect( d->m_export, &LogSourcesExport::failed,
+		this, &LogSourcesWindow::exportFailed );
+
+	d->m_exportToCsvAction->setEnabled( false );
+	d->m_exportToBinaryAction->setEnabled( false );
+
+	d->m_export->start();
+}
 
-	if( d->m_query.seek( d->m_pos ) )
+void
+LogSourcesWindow::exportProgress( int percent, qint64 records )
+{
+	if( d->m_exportProgress )
 	{
-		if( d->m_query.previous() )
-			d->m_havePrevLogPage = true;
-		else
-			d->m_havePrevLogPage = false;
-
-		d->m_query.next();
-
-		records = readLog();
+		d->m_exportProgress->setValue( percent );
+		d->m_exportProgress->setLabelText(
+			tr( "Exported %1 records..." ).arg( records ) );
 	}
-	else
-		d->m_haveNextLogPage = false;
-
-	setNavigationButtons();
-
-	d->m_view->model()->initModel( records );
 }
 
 void
-LogSourcesWindow::goToFirstLogPage()
+LogSourcesWindow::exportFinished()
 {
-	d->m_pos = 0;
-	d->m_haveNextLogPage = true;
-	d->m_havePrevLogPage = false;
-
-	QList< LogSourcesRecord > records;
-
-	d->m_query.seek( d->m_pos );
-
-	records = readLog();
-
-	setNavigationButtons();
+	Log::instance().writeMsgToEventLog( LogLevelInfo, QString(
+		"%1 records of sources log exported." )
+			.arg( d->m_export->records() ) );
 
-	d->m_view->model()->initModel( records );
+	stopExport();
 }
 
 void
-LogSourcesWindow::goToLastLogPage()
+LogSourcesWindow::exportCanceled()
 {
-	d->m_haveNextLogPage = false;
-	d->m_havePrevLogPage = true;
+	Log::instance().writeMsgToEventLog( LogLevelInfo,
+		QLatin1String( "Export of sources log canceled." ) );
 
-	do {
-		d->m_pos += d->m_logPageSize;
-	} while( d->m_query.seek( d->m_pos ) );
+	stopExport();
+}
 
-	d->m_pos -= d->m_logPageSize;
+void
+LogSourcesWindow::exportFailed( const QString & reason )
+{
+	Log::instance().writeMsgToEventLog( LogLevelError, QString(
+		"Unable to export sources log.\n"
+		"%1" ).arg( reason ) );
 
-	d->m_query.seek( d->m_pos );
+	stopExport();
 
-	QList< LogSourcesRecord > records = readLog();
+	QMessageBox::critical( this,
+		tr( "Unable to export sources log..." ), reason );
+}
 
-	d->m_pos += ( d->m_logPageSize - ( d->m_pos % d->m_logPageSize ) );
+void
+LogSourcesWindow::stopExport()
+{
+	if( d->m_exportProgress )
+	{
+		d->m_exportProgress->disconnect( d->m_export );
+		d->m_exportProgress->deleteLater();
+		d->m_exportProgress = 0;
+	}
 
-	setNavigationButtons();
+	d->m_export->deleteLater();
+	d->m_export = 0;
 
-	d->m_view->model()->initModel( records );
+	d->m_exportToCsvAction->setEnabled( true );
+	d->m_exportToBinaryAction->setEnabled( true );
 }
 
 } /* namespace Globe */
@@ -12,6 +12,7 @@
 
 // Globe include.
 #include <Core/log_sources_model.hpp>
+#include <Core/log_sources_export.hpp>
 #include <Core/tool_window.hpp>
 #include <Core/export.hpp>
 
@@ -61,10 +62,10 @@ private:
 	void init();
 	//! Set navigation buttons.
 	void setNavigationButtons();
-	//! \return List with log records.
-	QList< LogSourcesRecord > readLog();
-	//! \return List with log records.
-	QList< LogSourcesRecord > readLogFirstTime();
+	//! Export selected period of the log into the file.
+	void exportLog( LogSourcesExportFormat format );
+	//! Stop export.
+	void stopExport();
 
 private slots:
 	//! Select from log.
@@ -77,6 +78,18 @@ private slots:
 	void goToFirstLogPage();
 	//! Go to the last log page.
 	void goToLastLogPage();
+	//! Export to CSV.
+	void exportToCsv();
+	//! Export to binary format.
+	void exportToBinary();
+	//! Progress of the export.
+	void exportProgress( int percent, qint64 records );
+	//! Export finished.
+	void exportFinished();
+	//! Export canceled.
+	void exportCanceled();
+	//! Export failed.
+	void exportFailed( const QString & reason );
 
 private:
 	Q_DISABLE_COPY( LogSourcesWindow )
@@ -814,8 +814,15 @@ PropertiesManager::readPropertiesConfigs( PropertiesMap & map )
 					"from file \"%2\"." )
 						.arg( keyAsString, fileName ) );
 
-			const QMessageBox::StandardButton button =
-				QMessageBox::question( 0,
+			QMessageBox::StandardButton button = QMessageBox::Cancel;
+
+			// Without windows keep the file, user should decide.
+			if( Configuration::instance().isHeadless() )
+				Configuration::instance().critical(
+					tr( "Unable to read properties configuration..." ),
+					x.desc() );
+			else
+				button = QMessageBox::question( 0,
 					tr( "Unable to read properties configuration..." ),
 					tr( "Unable to read properties configuration...\n\n"
 						"%1\n\n"
@@ -880,7 +887,7 @@ PropertiesManager::readConfiguration( const QString & fileName )
 						"%2" )
 							.arg( fileName, x.desc() ) );
 
-				QMessageBox::critical( 0,
+				Configuration::instance().critical(
 					tr( "Unable to read properties configuration..." ),
 					x.desc() );
 
@@ -895,7 +902,7 @@ PropertiesManager::readConfiguration( const QString & fileName )
 					"Unable to open file." )
 						.arg( fileName ) );
 
-			QMessageBox::critical( 0,
+			Configuration::instance().critical(
 				tr( "Unable to read properties configuration..." ),
 				tr( "Unable to open file \"%1\"." ).arg( fileName ) );
 
@@ -27,6 +27,14 @@
 #include <QCoreApplication>
 #include <QFile>
 #include <QFileInfo>
+#include <QMediaPlayer>
+#include <QAudioOutput>
+#include <QSoundEffect>
+#include <QTimer>
+#include <QLabel>
+#include <QStatusBar>
+#include <QDateTime>
+#include <QUrl>
 
 // cfgfile include.
 #include <cfgfile/all.hpp>
@@ -34,6 +42,77 @@
 
 namespace Globe {
 
+//! Count of the levels with sounds, from critical to info.
+static const int soundLevelsCount = Info - Critical + 1;
+
+
+//
+// LevelSound
+//
+
+//! Preloaded sound of the level.
+struct LevelSound {
+	LevelSound()
+		:	m_effect( 0 )
+		,	m_player( 0 )
+		,	m_lastPlayed( 0 )
+		,	m_suppressed( 0 )
+	{
+	}
+
+	//! \return Is sound playing?
+	bool isPlaying() const
+	{
+		if( m_effect )
+			return m_effect->isPlaying();
+		else if( m_player )
+			return ( m_player->playbackState() == QMediaPlayer::PlayingState );
+		else
+			return false;
+	}
+
+	//! Play from the beginning.
+	void play()
+	{
+		if( m_effect )
+			m_effect->play();
+		else if( m_player )
+		{
+			m_player->setPosition( 0 );
+			m_player->play();
+		}
+	}
+
+	//! Stop.
+	void stop()
+	{
+		if( m_effect )
+			m_effect->stop();
+		else if( m_player )
+			m_player->stop();
+	}
+
+	//! Delete loaded sound.
+	void unload()
+	{
+		delete m_effect;
+		m_effect = 0;
+
+		delete m_player;
+		m_player = 0;
+	}
+
+	//! Effect, WAV files are decoded once at loading.
+	QSoundEffect * m_effect;
+	//! Player of other formats with the source set at loading.
+	QMediaPlayer * m_player;
+	//! Time of the last play in msecs since epoch.
+	qint64 m_lastPlayed;
+	//! Count of suppressed plays.
+	qint64 m_suppressed;
+}; // struct LevelSound
+
+
 //
 // SoundsPrivate
 //
@@ -43,21 +122,39 @@ public:
 	SoundsPrivate()
 		:	m_toolWindowObject( 0 )
 		,	m_level( None )
-		,	m_player( 0 )
+		,	m_pendingLevel( None )
+		,	m_coalesceTimer( 0 )
+		,	m_suppressedLabel( 0 )
 		,	m_tabs( 0 )
 		,	m_playedSoundsView( 0 )
 		,	m_disabledSoundsView( 0 )
 	{
 	}
 
+	//! \return Sound of the given level.
+	LevelSound & sound( Level level )
+	{
+		return m_sounds[ level - Critical ];
+	}
+
 	//! Tool window object.
 	ToolWindowObject * m_toolWindowObject;
 	//! Level of the current sound.
 	Level m_level;
 	//! Configuration.
 	SoundsCfg m_cfg;
-	//! Player.
-	QMediaPlayer * m_player;
+	//! Sounds of the levels.
+	LevelSound m_sounds[ soundLevelsCount ];
+	//! Level of the sound to play at the end of coalesce interval.
+	Level m_pendingLevel;
+	//! Source of the sound to play.
+	Como::Source m_pendingSource;
+	//! Channel of the sound to play.
+	QString m_pendingChannelName;
+	//! Coalesce timer.
+	QTimer * m_coalesceTimer;
+	//! Label with counters of the suppressed plays.
+	QLabel * m_suppressedLabel;
 	//! Tab widget.
 	QTabWidget * m_tabs;
 	//! Played sounds widget.
@@ -177,6 +274,8 @@ Sounds::readCfg( const QString & fileName )
 
 	d->m_cfg = tag.cfg();
 
+	loadSounds();
+
 	restoreWindowState( d->m_cfg.windowState(), this );
 }
 
@@ -239,6 +338,58 @@ void
 Sounds::setCfg( const SoundsCfg & c )
 {
 	d->m_cfg = c;
+
+	loadSounds();
+}
+
+qint64
+Sounds::suppressedPlays( Level level ) const
+{
+	if( level >= Critical && level <= Info )
+		return d->sound( level ).m_suppressed;
+	else
+		return 0;
+}
+
+void
+Sounds::loadSounds()
+{
+	d->m_pendingLevel = None;
+	d->m_level = None;
+
+	for( int i = Critical; i <= Info; ++i )
+	{
+		const Level level = static_cast< Level > ( i );
+		LevelSound & s = d->sound( level );
+
+		s.unload();
+
+		if( !isSoundEnabled( level ) || soundFileName( level ).isEmpty() )
+			continue;
+
+		const QFileInfo info( Configuration::instance().path() +
+			soundFileName( level ) );
+		const QUrl url = QUrl::fromLocalFile( info.absoluteFilePath() );
+
+		if( info.suffix().compare( QLatin1String( "wav" ),
+			Qt::CaseInsensitive ) == 0 )
+		{
+			s.m_effect = new QSoundEffect( this );
+			s.m_effect->setSource( url );
+
+			connect( s.m_effect, &QSoundEffect::playingChanged,
+				this, &Sounds::soundStateChanged );
+		}
+		else
+		{
+			s.m_player = new QMediaPlayer( this );
+			s.m_player->setAudioOutput( new QAudioOutput( s.m_player ) );
+			s.m_player->setSource( url );
+
+			connect( s.m_player, &QMediaPlayer::playbackStateChanged,
+				this, &Sounds::soundStateChanged );
+		}
+	}
 }
 
 bool
@@ -279,26 +430,100 @@ Sounds::playSound( Globe::Level level, const Como::Source & source,
 	{
 		if( DisabledSounds::instance().isSoundsEnabled( source, channelName ) )
 		{
-			d->m_player->stop();
-			d->m_player->setSource( QUrl::fromLocalFile(
-				QFileInfo( Configuration::instance().path() + soundFileName( level ) )
-					.absoluteFilePath() ) );
-			d->m_player->play();
+			// Only the most severe sound of the interval is played.
+			if( d->m_pendingLevel <= level )
+				suppressPlay( level );
+			else
+			{
+				if( d->m_pendingLevel != None )
+					suppressPlay( d->m_pendingLevel );
+
+				d->m_pendingLevel = level;
+				d->m_pendingSource = source;
+				d->m_pendingChannelName = channelName;
+			}
+
+			if( !d->m_coalesceTimer->isActive() )
+				d->m_coalesceTimer->start( d->m_cfg.coalesceInterval() );
+		}
+	}
+}
 
-			d->m_level = level;
+void
+Sounds::playPendingSound()
+{
+	const Level level = d->m_pendingLevel;
 
-			d->m_playedSoundsView->model()->addRecord(
-				PlayedSoundsModelRecord( QDateTime::currentDateTime(),
-					level, channelName, source ) );
-		}
+	d->m_pendingLevel = None;
+
+	if( level == None )
+		return;
+
+	LevelSound & s = d->sound( level );
+
+	const qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+	if( level > d->m_level ||
+		( s.m_lastPlayed > 0 &&
+			now - s.m_lastPlayed < d->m_cfg.minPlayInterval() ) )
+	{
+		suppressPlay( level );
 	}
+	else
+	{
+		for( auto & other : d->m_sounds )
+			if( &other != &s )
+				other.stop();
+
+		s.play();
+		s.m_lastPlayed = now;
+
+		d->m_level = level;
+
+		d->m_playedSoundsView->model()->addRecord(
+			PlayedSoundsModelRecord( QDateTime::currentDateTime(),
+				level, d->m_pendingChannelName, d->m_pendingSource ) );
+	}
+
+	updateSuppressedPlays();
+}
+
+void
+Sounds::suppressPlay( Level level )
+{
+	++d->sound( level ).m_suppressed;
 }
 
 void
-Sounds::playerStateChanged( QMediaPlayer::PlaybackState state )
+Sounds::updateSuppressedPlays()
 {
-	if( state == QMediaPlayer::StoppedState )
-		d->m_level = None;
+	d->m_suppressedLabel->setText( tr( "Suppressed: critical %1, "
+		"error %2, warning %3, debug %4, info %5" )
+			.arg( d->sound( Critical ).m_suppressed )
+			.arg( d->sound( Error ).m_suppressed )
+			.arg( d->sound( Warning ).m_suppressed )
+			.arg( d->sound( Debug ).m_suppressed )
+			.arg( d->sound( Info ).m_suppressed ) );
+
+	emit suppressedPlaysChanged();
+}
+
+void
+Sounds::soundStateChanged()
+{
+	for( int i = Critical; i <= Info; ++i )
+	{
+		const Level level = static_cast< Level > ( i );
+
+		if( d->sound( level ).isPlaying() )
+		{
+			d->m_level = level;
+
+			return;
+		}
+	}
+
+	d->m_level = None;
 }
 
 void
@@ -318,10 +543,14 @@ Sounds::init()
 	showAction->setShortcut( QKeySequence( tr( "Alt+D" ) ) );
 	d->m_toolWindowObject = new ToolWindowObject( showAction, this, this );
 
-	d->m_player = new QMediaPlayer( this );
+	d->m_coalesceTimer = new QTimer( this );
+	d->m_coalesceTimer->setSingleShot( true );
+
+	connect( d->m_coalesceTimer, &QTimer::timeout,
+		this, &Sounds::playPendingSound );
 
-	connect( d->m_player, &QMediaPlayer::playbackStateChanged,
-		this, &Sounds::playerStateChanged );
+	d->m_suppressedLabel = new QLabel( this );
+	statusBar()->addPermanentWidget( d->m_suppressedLabel );
 
 	d->m_tabs = new QTabWidget( this );
 
@@ -334,6 +563,10 @@ Sounds::init()
 	d->m_disabledSoundsView = new DisabledSoundsView( this );
 
 	d->m_tabs->addTab( d->m_disabledSoundsView, tr( "Disabled Sounds" ) );
+
+	loadSounds();
+
+	updateSuppressedPlays();
 }
 
 } /* namespace Globe */
@@ -10,7 +10,6 @@
 // Qt include.
 #include <QMainWindow>
 #include <QScopedPointer>
-#include <QMediaPlayer>
 
 // Como include.
 #include <Como/Source>
@@ -39,6 +38,10 @@ class CORE_EXPORT Sounds
 {
 	Q_OBJECT
 
+signals:
+	//! Counters of the suppressed plays changed.
+	void suppressedPlaysChanged();
+
 private:
 	Sounds( QWidget * parent = 0, Qt::WindowFlags f = Qt::WindowFlags() );
 
@@ -67,14 +70,20 @@ public:
 	//! Set configuration.
 	void setCfg( const SoundsCfg & c );
 
+	//! \return Count of triggered sounds of the given level that were
+	//! not played because of coalescing or rate limit.
+	qint64 suppressedPlays( Level level ) const;
+
 public slots:
 	//! Play sound.
 	void playSound( Globe::Level level, const Como::Source & source,
 		const QString & channelName );
 
 private slots:
-	//! Player state changed.
-	void playerStateChanged( QMediaPlayer::PlaybackState state );
+	//! State of one of the sounds changed.
+	void soundStateChanged();
+	//! Play the most severe sound triggered during coalesce interval.
+	void playPendingSound();
 
 protected:
 	void closeEvent( QCloseEvent * event );
@@ -86,6 +95,12 @@ private:
 	bool isSoundEnabled( Level level );
 	//! \return Sound file for the given level.
 	const QString & soundFileName( Level level );
+	//! Load sounds of the levels.
+	void loadSounds();
+	//! Count suppressed play of the sound.
+	void suppressPlay( Level level );
+	//! Show counters of the suppressed plays.
+	void updateSuppressedPlays();
 
 private:
 	Q_DISABLE_COPY( Sounds )
@@ -10,6 +10,16 @@
 
 namespace Globe {
 
+//! Default interval of coalescing of the sounds, in msecs.
+static const int defaultSoundsCoalesceInterval = 250;
+
+//! Default min interval between plays of the sound of one level, in msecs.
+static const int defaultSoundsMinPlayInterval = 1000;
+
+//! Max interval of coalescing and between plays of the sounds, in msecs.
+static const int maxSoundsInterval = 60 * 60 * 1000;
+
+
 //
 // SoundsCfg
 //
@@ -20,6 +30,8 @@ SoundsCfg::SoundsCfg()
 	,	m_isWarningSoundEnabled( false )
 	,	m_isDebugSoundEnabled( false )
 	,	m_isInfoSoundEnabled( false )
+	,	m_coalesceInterval( defaultSoundsCoalesceInterval )
+	,	m_minPlayInterval( defaultSoundsMinPlayInterval )
 {
 }
 
@@ -34,6 +46,8 @@ SoundsCfg::SoundsCfg( const SoundsCfg & other )
 	,	m_debugSoundFile( other.debugSoundFile() )
 	,	m_isInfoSoundEnabled( other.isInfoSoundEnabled() )
 	,	m_infoSoundFile( other.infoSoundFile() )
+	,	m_coalesceInterval( other.coalesceInterval() )
+	,	m_minPlayInterval( other.minPlayInterval() )
 	,	m_windowState( other.windowState() )
 {
 }
@@ -53,6 +67,8 @@ SoundsCfg::operator = ( const SoundsCfg & other )
 		m_debugSoundFile = other.debugSoundFile();
 		m_isInfoSoundEnabled = other.isInfoSoundEnabled();
 		m_infoSoundFile = other.infoSoundFile();
+		m_coalesceInterval = other.coalesceInterval();
+		m_minPlayInterval = other.minPlayInterval();
 		m_windowState = other.windowState();
 	}
 
@@ -219,6 +235,30 @@ SoundsCfg::setInfoSoundFile( const QString & fileName )
 	}
 }
 
+int
+SoundsCfg::coalesceInterval() const
+{
+	return m_coalesceInterval;
+}
+
+void
+SoundsCfg::setCoalesceInterval( int msecs )
+{
+	m_coalesceInterval = msecs;
+}
+
+int
+SoundsCfg::minPlayInterval() const
+{
+	return m_minPlayInterval;
+}
+
+void
+SoundsCfg::setMinPlayInterval( int msecs )
+{
+	m_minPlayInterval = msecs;
+}
+
 const WindowStateCfg &
 SoundsCfg::windowState() const
 {
@@ -244,8 +284,14 @@ SoundsCfgTag::SoundsCfgTag()
 	,	m_warningSoundFile( *this, QLatin1String( "warningSoundFile" ), false )
 	,	m_debugSoundFile( *this, QLatin1String( "debugSoundFile" ), false )
 	,	m_infoSoundFile( *this, QLatin1String( "infoSoundFile" ), false )
+	,	m_coalesceInterval( *this, QLatin1String( "coalesceInterval" ), false )
+	,	m_coalesceIntervalConstraint( 1, maxSoundsInterval )
+	,	m_minPlayInterval( *this, QLatin1String( "minPlayInterval" ), false )
+	,	m_minPlayIntervalConstraint( 1, maxSoundsInterval )
 	,	m_windowState( *this, QLatin1String( "windowState" ), true )
 {
+	m_coalesceInterval.set_constraint( &m_coalesceIntervalConstraint );
+	m_minPlayInterval.set_constraint( &m_minPlayIntervalConstraint );
 }
 
 SoundsCfgTag::SoundsCfgTag( const SoundsCfg & cfg )
@@ -256,9 +302,16 @@ SoundsCfgTag::SoundsCfgTag( const SoundsCfg & cfg )
 	,	m_warningSoundFile( *this, QLatin1String( "warningSoundFile" ), false )
 	,	m_debugSoundFile( *this, QLatin1String( "debugSoundFile" ), false )
 	,	m_infoSoundFile( *this, QLatin1String( "infoSoundFile" ), false )
+	,	m_coalesceInterval( *this, QLatin1String( "coalesceInterval" ), false )
+	,	m_coalesceIntervalConstraint( 1, maxSoundsInterval )
+	,	m_minPlayInterval( *this, QLatin1String( "minPlayInterval" ), false )
+	,	m_minPlayIntervalConstraint( 1, maxSoundsInterval )
 	,	m_windowState( cfg.windowState(), *this,
 			QLatin1String( "windowState" ), true )
 {
+	m_coalesceInterval.set_constraint( &m_coalesceIntervalConstraint );
+	m_minPlayInterval.set_constraint( &m_minPlayIntervalConstraint );
+
 	if( cfg.isCriticalSoundEnabled() && !cfg.criticalSoundFile().isEmpty() )
 		m_criticalSoundFile.set_value( cfg.criticalSoundFile() );
 
@@ -274,6 +327,9 @@ SoundsCfgTag::SoundsCfgTag( const SoundsCfg & cfg )
 	if( cfg.isInfoSoundEnabled() && !cfg.infoSoundFile().isEmpty() )
 		m_infoSoundFile.set_value( cfg.infoSoundFile() );
 
+	m_coalesceInterval.set_value( cfg.coalesceInterval() );
+	m_minPlayInterval.set_value( cfg.minPlayInterval() );
+
 	set_defined();
 }
 
@@ -297,6 +353,12 @@ SoundsCfgTag::cfg() const
 	if( m_infoSoundFile.is_defined() )
 		c.setInfoSoundFile( m_infoSoundFile.value() );
 
+	if( m_coalesceInterval.is_defined() )
+		c.setCoalesceInterval( m_coalesceInterval.value() );
+
+	if( m_minPlayInterval.is_defined() )
+		c.setMinPlayInterval( m_minPlayInterval.value() );
+
 	c.setWindowState( m_windowState.cfg() );
 
 	return c;
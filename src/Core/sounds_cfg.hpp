@@ -77,6 +77,18 @@ public:
 	//! Set info sound file.
 	void setInfoSoundFile( const QString & fileName );
 
+	//! \return Interval in msecs during which triggered sounds are
+	//! coalesced into one play of the most severe of them.
+	int coalesceInterval() const;
+	//! Set coalesce interval.
+	void setCoalesceInterval( int msecs );
+
+	//! \return Min interval in msecs between plays of the sound of
+	//! one level.
+	int minPlayInterval() const;
+	//! Set min play interval.
+	void setMinPlayInterval( int msecs );
+
 	//! \return Window state configuration.
 	const WindowStateCfg & windowState() const;
 	//! Set window state configuration.
@@ -103,6 +115,10 @@ private:
 	bool m_isInfoSoundEnabled;
 	//! Info sound file.
 	QString m_infoSoundFile;
+	//! Coalesce interval.
+	int m_coalesceInterval;
+	//! Min play interval.
+	int m_minPlayInterval;
 	//! Window state configuration.
 	WindowStateCfg m_windowState;
 }; // class SoundsCfg
@@ -135,6 +151,14 @@ private:
 	cfgfile::tag_scalar_t< QString, cfgfile::qstring_trait_t > m_debugSoundFile;
 	//! Info sound file.
 	cfgfile::tag_scalar_t< QString, cfgfile::qstring_trait_t > m_infoSoundFile;
+	//! Coalesce interval.
+	cfgfile::tag_scalar_t< int, cfgfile::qstring_trait_t > m_coalesceInterval;
+	//! Constraint for the coalesce interval.
+	cfgfile::constraint_min_max_t< int > m_coalesceIntervalConstraint;
+	//! Min play interval.
+	cfgfile::tag_scalar_t< int, cfgfile::qstring_trait_t > m_minPlayInterval;
+	//! Constraint for the min play interval.
+	cfgfile::constraint_min_max_t< int > m_minPlayIntervalConstraint;
 	//! Window state configuration.
 	WindowStateCfgTag m_windowState;
 }; // class SoundsCfgTag
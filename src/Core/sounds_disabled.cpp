@@ -15,6 +15,8 @@
 #include <QMessageBox>
 #include <QCoreApplication>
 #include <QFile>
+#include <QHash>
+#include <QVector>
 
 // cfgfile include.
 #include <cfgfile/all.hpp>
@@ -22,6 +24,70 @@
 
 namespace Globe {
 
+//! Count of the slots in the timer wheel.
+static const int timerWheelSize = 64;
+
+//! Duration of the slot of the timer wheel in msecs.
+static const qint64 timerWheelSlotDuration = 1000;
+
+//! Max count of the ticks the timer sleeps without wake up.
+static const qint64 timerWheelMaxSleep = 24 * 60 * 60;
+
+
+//
+// DisabledSoundsKey
+//
+
+//! Key of the disabled sound.
+struct DisabledSoundsKey {
+	DisabledSoundsKey()
+	{
+	}
+
+	DisabledSoundsKey( const Como::Source & source,
+		const QString & channelName )
+		:	m_channelName( channelName )
+		,	m_sourceName( source.name() )
+		,	m_typeName( source.typeName() )
+	{
+	}
+
+	//! Channel name.
+	QString m_channelName;
+	//! Source name.
+	QString m_sourceName;
+	//! Type name.
+	QString m_typeName;
+}; // struct DisabledSoundsKey
+
+static inline bool operator == ( const DisabledSoundsKey & k1,
+	const DisabledSoundsKey & k2 )
+{
+	return ( k1.m_channelName == k2.m_channelName &&
+		k1.m_sourceName == k2.m_sourceName &&
+		k1.m_typeName == k2.m_typeName );
+}
+
+static inline size_t qHash( const DisabledSoundsKey & key, size_t seed = 0 )
+{
+	return qHashMulti( seed, key.m_channelName, key.m_sourceName,
+		key.m_typeName );
+}
+
+
+//
+// DisabledSoundsTimer
+//
+
+//! Expiration of the disabled sound in the timer wheel.
+struct DisabledSoundsTimer {
+	//! Key.
+	DisabledSoundsKey m_key;
+	//! Expiration time in msecs since epoch.
+	qint64 m_to;
+}; // struct DisabledSoundsTimer
+
+
 //
 // DisabledSoundsPrivate
 //
@@ -30,15 +96,140 @@ class DisabledSoundsPrivate {
 public:
 	DisabledSoundsPrivate()
 		:	m_timer( 0 )
+		,	m_wheel( timerWheelSize )
+		,	m_timersCount( 0 )
+		,	m_lastTick( 0 )
+		,	m_overflowTick( 0 )
 	{
 	}
 
+	//! Put expiration of the disabled sound into the timer wheel.
+	void schedule( const DisabledSoundsKey & key, const QDateTime & to );
+	//! Put expiration into the slot of the wheel or into the overflow.
+	void put( const DisabledSoundsTimer & timer );
+	//! Move expirations that came within one turn of the wheel from
+	//! the overflow to the wheel.
+	void cascade();
+	//! Start timer to the next non-empty slot of the wheel or to the
+	//! moment when the nearest expiration from the overflow has to be
+	//! moved to the wheel.
+	void startTimer();
+	//! Clear all.
+	void clear();
+
 	//! Timer.
 	QTimer * m_timer;
-	//! Map of disabled sounds.
-	DisabledSoundsMap m_map;
+	//! Disabled sounds.
+	QHash< DisabledSoundsKey, DisabledSoundsData > m_disabled;
+	//! Timer wheel. Slot of the expiration is the tick of it modulo
+	//! size of the wheel.
+	QVector< QList< DisabledSoundsTimer > > m_wheel;
+	//! Expirations that are more than one turn of the wheel ahead.
+	QList< DisabledSoundsTimer > m_overflow;
+	//! Nearest tick of the expirations in the overflow.
+	qint64 m_overflowTick;
+	//! Count of expirations in the wheel and in the overflow.
+	int m_timersCount;
+	//! Last processed tick.
+	qint64 m_lastTick;
 }; // class DisabledSoundsPrivate
 
+void
+DisabledSoundsPrivate::schedule( const DisabledSoundsKey & key,
+	const QDateTime & to )
+{
+	// Sounds disabled without time are disabled until enabled by user.
+	if( !to.isValid() )
+		return;
+
+	const qint64 msecs = to.toMSecsSinceEpoch();
+
+	if( m_timersCount == 0 )
+		m_lastTick = QDateTime::currentMSecsSinceEpoch() /
+			timerWheelSlotDuration;
+
+	put( { key, msecs } );
+
+	++m_timersCount;
+
+	startTimer();
+}
+
+void
+DisabledSoundsPrivate::put( const DisabledSoundsTimer & timer )
+{
+	const qint64 tick = qMax( ( timer.m_to + timerWheelSlotDuration - 1 ) /
+		timerWheelSlotDuration, m_lastTick + 1 );
+
+	if( tick - m_lastTick > timerWheelSize )
+	{
+		m_overflowTick = ( m_overflow.isEmpty() ? tick :
+			qMin( m_overflowTick, tick ) );
+
+		m_overflow.append( timer );
+	}
+	else
+		m_wheel[ tick % timerWheelSize ].append( timer );
+}
+
+void
+DisabledSoundsPrivate::cascade()
+{
+	if( m_overflow.isEmpty() || m_overflowTick - m_lastTick > timerWheelSize )
+		return;
+
+	QList< DisabledSoundsTimer > overflow;
+	overflow.swap( m_overflow );
+
+	for( const DisabledSoundsTimer & timer : std::as_const( overflow ) )
+		put( timer );
+}
+
+void
+DisabledSoundsPrivate::startTimer()
+{
+	if( m_timersCount > 0 )
+	{
+		qint64 next = m_lastTick + timerWheelMaxSleep;
+
+		if( !m_overflow.isEmpty() )
+			next = qBound( m_lastTick + 1, m_overflowTick - timerWheelSize, next );
+
+		for( qint64 t = m_lastTick + 1;
+			t < next && t <= m_lastTick + timerWheelSize; ++t )
+		{
+			if( !m_wheel.at( t % timerWheelSize ).isEmpty() )
+			{
+				next = t;
+
+				break;
+			}
+		}
+
+		const qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+		m_timer->start( qMax( qint64( 0 ),
+			next * timerWheelSlotDuration - now ) );
+	}
+	else
+		m_timer->stop();
+}
+
+void
+DisabledSoundsPrivate::clear()
+{
+	m_disabled.clear();
+
+	for( auto & slot : m_wheel )
+		slot.clear();
+
+	m_overflow.clear();
+
+	m_timersCount = 0;
+
+	m_timer->stop();
+}
+
 
 //
 // DisabledSounds
@@ -80,15 +271,9 @@ DisabledSounds::instance()
 
 bool
 DisabledSounds::isSoundsEnabled( const Como::Source & source,
-	const QString & channelName )
+	const QString & channelName ) const
 {
-	const int index = d->m_map[ channelName ].indexOf(
-		DisabledSoundsData( source ) );
-
-	if( index == -1 )
-		return true;
-	else
-		return false;
+	return !d->m_disabled.contains( DisabledSoundsKey( source, channelName ) );
 }
 
 void
@@ -96,32 +281,34 @@ DisabledSounds::disableSounds( const Como::Source & source,
 	const QString & channelName,
 	const QDateTime & to )
 {
-	const int index = d->m_map[ channelName ].indexOf(
-		DisabledSoundsData( source ) );
+	const DisabledSoundsKey key( source, channelName );
+
+	auto it = d->m_disabled.find( key );
 
-	if( index == -1 )
+	if( it == d->m_disabled.end() )
 	{
-		d->m_map[ channelName ].append( DisabledSoundsData( source, to ) );
+		d->m_disabled.insert( key, DisabledSoundsData( source, to ) );
+
+		d->schedule( key, to );
 
 		emit soundsDisabled( source, channelName, to );
 	}
-	else
-		d->m_map[ channelName ][ index ].dateTime() = to;
+	else if( it.value().dateTime() != to )
+	{
+		// Previous expiration stays in the wheel and will be skipped
+		// as outdated.
+		it.value().dateTime() = to;
+
+		d->schedule( key, to );
+	}
 }
 
 void
 DisabledSounds::enableSounds( const Como::Source & source,
 	const QString & channelName )
 {
-	const int index = d->m_map[ channelName ].indexOf(
-		DisabledSoundsData( source ) );
-
-	if( index != -1 )
-	{
-		d->m_map[ channelName ].removeAt( index );
-
+	if( d->m_disabled.remove( DisabledSoundsKey( source, channelName ) ) )
 		emit soundsEnabled( source, channelName );
-	}
 }
 
 void
@@ -174,9 +361,22 @@ DisabledSounds::readCfg( const QString & fileName )
 		return;
 	}
 
-	d->m_map = tag.cfg().map();
+	d->clear();
+
+	const DisabledSoundsMap & map = tag.cfg().map();
+
+	for( DisabledSoundsMap::ConstIterator it = map.begin(),
+		last = map.end(); it != last; ++it )
+	{
+		foreach( const DisabledSoundsData & data, it.value() )
+		{
+			const DisabledSoundsKey key( data.source(), it.key() );
 
-	checkAndEnableIf();
+			d->m_disabled.insert( key, data );
+
+			d->schedule( key, data.dateTime() );
+		}
+	}
 
 	notifyAboutDisabledSounds();
 }
@@ -189,8 +389,16 @@ DisabledSounds::saveCfg( const QString & fileName )
 	if( file.open( QIODevice::WriteOnly ) )
 	{
 		try {
+			DisabledSoundsMap map;
+
+			for( auto it = d->m_disabled.cbegin(), last = d->m_disabled.cend();
+				it != last; ++it )
+			{
+				map[ it.key().m_channelName ].append( it.value() );
+			}
+
 			DisabledSoundsCfg cfg;
-			cfg.setMap( d->m_map );
+			cfg.setMap( map );
 
 			DisabledSoundsCfgTag tag( cfg );
 
@@ -232,61 +440,80 @@ DisabledSounds::saveCfg( const QString & fileName )
 }
 
 void
-DisabledSounds::checkAndEnableIf()
+DisabledSounds::timerWheelTick()
 {
-	const QDateTime now = QDateTime::currentDateTime();
+	const qint64 now = QDateTime::currentMSecsSinceEpoch();
+	const qint64 tick = now / timerWheelSlotDuration;
 
-	QMutableMapIterator< QString, QList< DisabledSoundsData > > it( d->m_map );
+	// If clock jumped forward more than one turn every slot is processed once.
+	qint64 first = d->m_lastTick + 1;
 
-	while( it.hasNext() )
-	{
-		it.next();
+	if( tick - first >= timerWheelSize )
+		first = tick - timerWheelSize + 1;
 
-		QList< DisabledSoundsData > toRemove;
+	QList< DisabledSoundsData > expired;
+	QList< QString > expiredChannels;
 
-		foreach( const DisabledSoundsData & data, it.value() )
-		{
-			if( data.dateTime() <= now )
-				toRemove.append( data );
-		}
+	for( qint64 t = first; t <= tick && d->m_timersCount > 0; ++t )
+	{
+		QList< DisabledSoundsTimer > & slot = d->m_wheel[ t % timerWheelSize ];
 
-		foreach( const DisabledSoundsData & data, toRemove )
+		for( int i = 0; i < slot.size(); )
 		{
-			it.value().removeOne( data );
+			if( slot.at( i ).m_to > now )
+			{
+				++i;
+
+				continue;
+			}
+
+			const DisabledSoundsTimer timer = slot.takeAt( i );
+
+			--d->m_timersCount;
+
+			auto it = d->m_disabled.find( timer.m_key );
+
+			// Sounds could be enabled by user or disabled to another time.
+			if( it != d->m_disabled.end() && it.value().dateTime().isValid() &&
+				it.value().dateTime().toMSecsSinceEpoch() == timer.m_to )
+			{
+				expired.append( it.value() );
+				expiredChannels.append( timer.m_key.m_channelName );
 
-			emit soundsEnabled( data.source(), it.key() );
+				d->m_disabled.erase( it );
+			}
 		}
 	}
-}
 
-void
-DisabledSounds::initTimer()
-{
-	d->m_timer->start( 60 * 1000 );
+	d->m_lastTick = qMax( d->m_lastTick, tick );
 
-	connect( d->m_timer, &QTimer::timeout,
-		this, &DisabledSounds::checkAndEnableIf );
+	d->cascade();
 
-	checkAndEnableIf();
+	d->startTimer();
+
+	for( int i = 0; i < expired.size(); ++i )
+		emit soundsEnabled( expired.at( i ).source(), expiredChannels.at( i ) );
 }
 
 void
 DisabledSounds::init()
 {
 	d->m_timer = new QTimer( this );
+	d->m_timer->setSingleShot( true );
+	d->m_timer->setTimerType( Qt::PreciseTimer );
 
-	QTimer::singleShot( ( 60 - QTime::currentTime().second() ) * 1000,
-		this, &DisabledSounds::initTimer );
+	connect( d->m_timer, &QTimer::timeout,
+		this, &DisabledSounds::timerWheelTick );
 }
 
 void
 DisabledSounds::notifyAboutDisabledSounds()
 {
-	for( DisabledSoundsMap::ConstIterator it = d->m_map.begin(),
-		last= d->m_map.end(); it != last; ++it )
+	for( auto it = d->m_disabled.cbegin(), last = d->m_disabled.cend();
+		it != last; ++it )
 	{
-		foreach( const DisabledSoundsData & data, it.value() )
-			emit soundsDisabled( data.source(), it.key(), data.dateTime() );
+		emit soundsDisabled( it.value().source(), it.key().m_channelName,
+			it.value().dateTime() );
 	}
 }
 
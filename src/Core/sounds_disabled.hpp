@@ -27,7 +27,13 @@ namespace Globe {
 
 class DisabledSoundsPrivate;
 
-//! Disabled sounds manager.
+/*!
+	Disabled sounds manager.
+
+	Disabled sounds are kept in the hash by channel, source and type
+	names, expirations are kept in the timer wheel with one second
+	slots, timer fires only on the ticks while there are expirations.
+*/
 class DisabledSounds
 	:	public QObject
 {
@@ -56,7 +62,7 @@ public:
 
 	//! \return Is sounds enabled for the given source.
 	bool isSoundsEnabled( const Como::Source & source,
-		const QString & channelName );
+		const QString & channelName ) const;
 
 	//! Disable sound for the give source.
 	void disableSounds( const Como::Source & source,
@@ -74,10 +80,8 @@ public:
 	void saveCfg( const QString & fileName );
 
 private slots:
-	//! Check if there are sounds that should be enabled.
-	void checkAndEnableIf();
-	//! Init timer.
-	void initTimer();
+	//! Enable sounds which time has come.
+	void timerWheelTick();
 
 private:
 	//! Init.
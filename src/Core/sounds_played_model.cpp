@@ -8,7 +8,8 @@
 #include <Core/sounds_played_model.hpp>
 
 // Qt include.
-#include <QList>
+#include <QVector>
+#include <QTimer>
 
 
 namespace Globe {
@@ -116,14 +117,29 @@ PlayedSoundsModelRecord::setSource( const Como::Source & s )
 class PlayedSoundsModelPrivate {
 public:
 	explicit PlayedSoundsModelPrivate( int maxRows )
-		:	m_maxRows( maxRows )
+		:	m_data( maxRows )
+		,	m_head( -1 )
+		,	m_size( 0 )
+		,	m_timer( 0 )
 	{
 	}
 
-	//! Data.
-	QList< PlayedSoundsModelRecord > m_data;
-	//! Max count of rows.
-	int m_maxRows;
+	//! \return Record in the given row, the newest record is in the first row.
+	PlayedSoundsModelRecord & at( int row )
+	{
+		return m_data[ ( m_head - row + m_data.size() ) % m_data.size() ];
+	}
+
+	//! Ring of the records.
+	QVector< PlayedSoundsModelRecord > m_data;
+	//! Index of the newest record in the ring.
+	int m_head;
+	//! Count of the rows.
+	int m_size;
+	//! Records not yet shown, from the oldest.
+	QVector< PlayedSoundsModelRecord > m_pending;
+	//! Timer to show pending records.
+	QTimer * m_timer;
 }; // class PlayedSoundsModelPrivate
 
 
@@ -136,11 +152,19 @@ static const int dateTimeColumn = 0;
 static const int channelNameColumn = 1;
 static const int typeNameColumn = 2;
 static const int sourceNameColumn = 3;
+//! Interval of showing of the added records in msecs.
+static const int addRecordsInterval = 100;
 
 PlayedSoundsModel::PlayedSoundsModel( QObject * parent )
 	:	QAbstractTableModel( parent )
 	,	d( new PlayedSoundsModelPrivate( maxRowsCount ) )
 {
+	d->m_timer = new QTimer( this );
+	d->m_timer->setSingleShot( true );
+	d->m_timer->setInterval( addRecordsInterval );
+
+	connect( d->m_timer, &QTimer::timeout,
+		this, &PlayedSoundsModel::showPendingRecords );
 }
 
 PlayedSoundsModel::~PlayedSoundsModel()
@@ -150,35 +174,62 @@ PlayedSoundsModel::~PlayedSoundsModel()
 void
 PlayedSoundsModel::addRecord( const PlayedSoundsModelRecord & r )
 {
-	beginInsertRows( QModelIndex(), 0, 0 );
+	// Records that would be pushed out of the ring at once are not kept.
+	if( d->m_pending.size() == d->m_data.size() )
+		d->m_pending.removeFirst();
 
-	d->m_data.prepend( r );
+	d->m_pending.append( r );
 
-	endInsertRows();
+	if( !d->m_timer->isActive() )
+		d->m_timer->start();
+}
+
+void
+PlayedSoundsModel::showPendingRecords()
+{
+	const int capacity = d->m_data.size();
+	const int count = d->m_pending.size();
 
-	const int size = d->m_data.size();
+	if( !count )
+		return;
 
-	if( size > d->m_maxRows )
+	const int kept = qMin( d->m_size, capacity - count );
+
+	if( kept < d->m_size )
 	{
-		beginRemoveRows( QModelIndex(), size - 1, size - 1 );
+		beginRemoveRows( QModelIndex(), kept, d->m_size - 1 );
 
-		d->m_data.removeLast();
+		d->m_size = kept;
 
 		endRemoveRows();
 	}
+
+	beginInsertRows( QModelIndex(), 0, count - 1 );
+
+	for( const auto & r : std::as_const( d->m_pending ) )
+	{
+		d->m_head = ( d->m_head + 1 ) % capacity;
+		d->m_data[ d->m_head ] = r;
+	}
+
+	d->m_size += count;
+
+	endInsertRows();
+
+	d->m_pending.clear();
 }
 
 const PlayedSoundsModelRecord &
 PlayedSoundsModel::record( const QModelIndex & index ) const
 {
-	return d->m_data.at( index.row() );
+	return d->at( index.row() );
 }
 
 int
 PlayedSoundsModel::rowCount( const QModelIndex & parent ) const
 {
 	if( !parent.isValid() )
-		return d->m_data.size();
+		return d->m_size;
 	else
 		return 0;
 }
@@ -201,13 +252,13 @@ PlayedSoundsModel::data( const QModelIndex & index, int role ) const
 		switch( column )
 		{
 			case dateTimeColumn :
-				return ( d->m_data[ index.row() ].dateTime() );
+				return ( d->at( index.row() ).dateTime() );
 			case channelNameColumn :
-				return ( d->m_data[ index.row() ].channelName() );
+				return ( d->at( index.row() ).channelName() );
 			case typeNameColumn :
-				return d->m_data[ index.row() ].source().typeName();
+				return d->at( index.row() ).source().typeName();
 			case sourceNameColumn :
-				return d->m_data[ index.row() ].source().name();
+				return d->at( index.row() ).source().name();
 			default :
 				return QVariant();
 		}
@@ -228,13 +279,13 @@ PlayedSoundsModel::setData( const QModelIndex & index, const QVariant & value,
 		switch( column )
 		{
 			case dateTimeColumn :
-				d->m_data[ row ].setDateTime( value.toDateTime() ); break;
+				d->at( row ).setDateTime( value.toDateTime() ); break;
 			case channelNameColumn :
-				d->m_data[ row ].setChannelName( value.toString() ); break;
+				d->at( row ).setChannelName( value.toString() ); break;
 			case typeNameColumn :
-				d->m_data[ row ].source().setTypeName( value.toString() ); break;
+				d->at( row ).source().setTypeName( value.toString() ); break;
 			case sourceNameColumn :
-				d->m_data[ row ].source().setName( value.toString() ); break;
+				d->at( row ).source().setName( value.toString() ); break;
 		}
 	}
 
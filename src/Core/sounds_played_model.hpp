@@ -78,7 +78,12 @@ private:
 
 class PlayedSoundsModelPrivate;
 
-//! Model for the played sounds.
+/*!
+	Model for the played sounds. Keeps a fixed number of the last
+	played sounds in the ring. Added records are shown by timer with
+	one insertion of rows, so a storm of alarms doesn't make the view
+	relayout for each sound.
+*/
 class PlayedSoundsModel
 	:	public QAbstractTableModel
 {
@@ -111,6 +116,10 @@ public:
 	QVariant headerData( int section, Qt::Orientation orientation,
 		int role = Qt::DisplayRole ) const;
 
+private slots:
+	//! Show added records.
+	void showPendingRecords();
+
 private:
 	Q_DISABLE_COPY( PlayedSoundsModel )
 
@@ -90,6 +90,40 @@ bool operator == ( const MapValue & v1, const MapValue & v2 )
 }
 
 
+//
+// SourcesSnapshot
+//
+
+SourcesSnapshot::SourcesSnapshot()
+{
+}
+
+bool
+SourcesSnapshot::syncSource( const QString & channelName,
+	Como::Source & s, bool & isRegistered ) const
+{
+	const auto channel = m_sources.constFind( channelName );
+
+	if( channel == m_sources.cend() )
+		return false;
+
+	const auto type = channel.value().constFind( s.typeName() );
+
+	if( type == channel.value().cend() )
+		return false;
+
+	const auto value = type.value().constFind( s.name() );
+
+	if( value == type.value().cend() )
+		return false;
+
+	s = value.value().m_source;
+	isRegistered = value.value().m_registered;
+
+	return true;
+}
+
+
 //
 // SourcesManagerPrivate
 //
@@ -245,6 +279,28 @@ SourcesManager::syncSource( const QString & channelName,
 	return false;
 }
 
+SourcesSnapshot
+SourcesManager::snapshot( const QStringList & channelsNames ) const
+{
+	SourcesSnapshot result;
+
+	for( const auto & name : channelsNames )
+	{
+		const auto it = d->m_map.constFind( name );
+
+		if( it == d->m_map.cend() )
+			continue;
+
+		auto & channel = result.m_sources[ name ];
+
+		for( const MapValue & v : it.value() )
+			channel[ v.source().typeName() ].insert( v.source().name(),
+				{ v.source(), v.isRegistered() } );
+	}
+
+	return result;
+}
+
 void
 SourcesManager::sourceUpdated( const Como::Source & source )
 {
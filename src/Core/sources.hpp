@@ -9,6 +9,8 @@
 
 // Qt include.
 #include <QObject>
+#include <QHash>
+#include <QStringList>
 
 // Como include.
 #include <Como/Source>
@@ -18,6 +20,36 @@ namespace Globe {
 
 class Channel;
 
+
+//
+// SourcesSnapshot
+//
+
+//! Copy of the sources of the sources manager for bulk synchronization.
+class SourcesSnapshot {
+public:
+	SourcesSnapshot();
+
+	//! Sync source. \return Was source synced?
+	bool syncSource( const QString & channelName,
+		Como::Source & s, bool & isRegistered ) const;
+
+private:
+	friend class SourcesManager;
+
+	//! Source in the snapshot.
+	struct Value {
+		//! Source.
+		Como::Source m_source;
+		//! Is registered?
+		bool m_registered;
+	}; // struct Value
+
+	//! Sources by channel, type name and source name.
+	QHash< QString, QHash< QString, QHash< QString, Value > > > m_sources;
+}; // class SourcesSnapshot
+
+
 //
 // SourcesManager.
 //
@@ -68,6 +100,10 @@ public:
 	bool syncSource( const QString & channelName,
 		Como::Source & s, bool & isRegistered );
 
+	//! \return Snapshot of the sources in the given channels for
+	//! synchronization of many sources at once.
+	SourcesSnapshot snapshot( const QStringList & channelsNames ) const;
+
 private slots:
 	//! Source updated or registered.
 	void sourceUpdated( const Como::Source & source );
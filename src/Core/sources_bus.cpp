@@ -0,0 +1,467 @@
+
+/*
+	SPDX-FileCopyrightText: 2012-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// Globe include.
+#include <Core/sources_bus.hpp>
+#include <Core/channels.hpp>
+#include <Core/sources.hpp>
+
+// Qt include.
+#include <QHash>
+#include <QSet>
+#include <QTimer>
+#include <QCoreApplication>
+
+
+namespace Globe {
+
+//
+// SourcesSubscriber
+//
+
+SourcesSubscriber::~SourcesSubscriber()
+{
+}
+
+
+//
+// SourceId
+//
+
+//! Id of the source in the channel.
+struct SourceId {
+	SourceId( const QString & typeName, const QString & name )
+		:	m_typeName( typeName )
+		,	m_name( name )
+	{
+	}
+
+	friend bool operator == ( const SourceId & id1, const SourceId & id2 )
+	{
+		return ( id1.m_typeName == id2.m_typeName &&
+			id1.m_name == id2.m_name );
+	}
+
+	friend size_t qHash( const SourceId & id, size_t seed = 0 )
+	{
+		return qHashMulti( seed, id.m_typeName, id.m_name );
+	}
+
+	//! Type name.
+	QString m_typeName;
+	//! Source name.
+	QString m_name;
+}; // struct SourceId
+
+
+//
+// ChannelBus
+//
+
+//! Subscriptions and batch of the channel.
+struct ChannelBus {
+	//! \return Is there no subscribers?
+	bool isEmpty() const
+	{
+		return ( m_all.isEmpty() && m_bySource.isEmpty() );
+	}
+
+	//! Subscribers to all sources.
+	QList< SourcesSubscriber* > m_all;
+	//! Subscribers to the single sources.
+	QHash< SourceId, QList< SourcesSubscriber* > > m_bySource;
+	//! Changes to dispatch.
+	QList< SourceChange > m_pending;
+	//! Indexes of the changes to dispatch.
+	QHash< SourceId, int > m_pendingIndex;
+}; // struct ChannelBus
+
+
+//
+// SourcesBusPrivate
+//
+
+class SourcesBusPrivate {
+public:
+	SourcesBusPrivate()
+		:	m_flushTimer( 0 )
+	{
+	}
+
+	//! Remove channel if there is no subscribers.
+	void removeIfEmpty( const QString & channelName );
+
+	//! Channels.
+	QHash< QString, ChannelBus > m_channels;
+	//! Channels with subscriptions of the subscriber.
+	QHash< SourcesSubscriber*, QSet< QString > > m_subscriberChannels;
+	//! Names of the channels with changes to dispatch.
+	QSet< QString > m_dirtyChannels;
+	//! Paused subscribers with ids of the changed sources by channels.
+	QHash< SourcesSubscriber*, QHash< QString, QSet< SourceId > > > m_paused;
+	//! Flush timer.
+	QTimer * m_flushTimer;
+}; // class SourcesBusPrivate
+
+void
+SourcesBusPrivate::removeIfEmpty( const QString & channelName )
+{
+	const auto it = m_channels.find( channelName );
+
+	if( it != m_channels.end() && it.value().isEmpty() )
+	{
+		m_channels.erase( it );
+
+		m_dirtyChannels.remove( channelName );
+	}
+}
+
+
+//
+// SourcesBus
+//
+
+SourcesBus::SourcesBus( QObject * parent )
+	:	QObject( parent )
+	,	d( new SourcesBusPrivate )
+{
+	d->m_flushTimer = new QTimer( this );
+	d->m_flushTimer->setSingleShot( true );
+	d->m_flushTimer->setInterval( 0 );
+
+	connect( d->m_flushTimer, &QTimer::timeout,
+		this, &SourcesBus::flush );
+
+	connect( &ChannelsManager::instance(), &ChannelsManager::channelCreated,
+		this, &SourcesBus::channelCreated );
+
+	connect( &ChannelsManager::instance(), &ChannelsManager::channelRemoved,
+		this, &SourcesBus::channelRemoved );
+
+	foreach( Channel * channel, ChannelsManager::instance().channels() )
+		channelCreated( channel );
+}
+
+SourcesBus::~SourcesBus()
+{
+}
+
+static SourcesBus * sourcesBusInstancePointer = 0;
+
+void
+SourcesBus::cleanup()
+{
+	delete sourcesBusInstancePointer;
+
+	sourcesBusInstancePointer = 0;
+}
+
+SourcesBus &
+SourcesBus::instance()
+{
+	if( !sourcesBusInstancePointer )
+	{
+		sourcesBusInstancePointer = new SourcesBus;
+
+		qAddPostRoutine( &SourcesBus::cleanup );
+	}
+
+	return *sourcesBusInstancePointer;
+}
+
+void
+SourcesBus::subscribe( SourcesSubscriber * subscriber,
+	const QString & channelName )
+{
+	ChannelBus & bus = d->m_channels[ channelName ];
+
+	if( !bus.m_all.contains( subscriber ) )
+		bus.m_all.append( subscriber );
+
+	d->m_subscriberChannels[ subscriber ].insert( channelName );
+}
+
+void
+SourcesBus::subscribe( SourcesSubscriber * subscriber,
+	const QString & channelName, const QString & typeName,
+	const QString & sourceName )
+{
+	QList< SourcesSubscriber* > & subscribers =
+		d->m_channels[ channelName ].m_bySource[
+			SourceId( typeName, sourceName ) ];
+
+	if( !subscribers.contains( subscriber ) )
+		subscribers.append( subscriber );
+
+	d->m_subscriberChannels[ subscriber ].insert( channelName );
+}
+
+void
+SourcesBus::unsubscribe( SourcesSubscriber * subscriber,
+	const QString & channelName )
+{
+	const auto it = d->m_channels.find( channelName );
+
+	if( it != d->m_channels.end() )
+	{
+		it.value().m_all.removeOne( subscriber );
+
+		d->removeIfEmpty( channelName );
+	}
+}
+
+void
+SourcesBus::unsubscribe( SourcesSubscriber * subscriber,
+	const QString & channelName, const QString & typeName,
+	const QString & sourceName )
+{
+	const auto it = d->m_channels.find( channelName );
+
+	if( it != d->m_channels.end() )
+	{
+		const SourceId id( typeName, sourceName );
+
+		auto sit = it.value().m_bySource.find( id );
+
+		if( sit != it.value().m_bySource.end() )
+		{
+			sit.value().removeOne( subscriber );
+
+			if( sit.value().isEmpty() )
+				it.value().m_bySource.erase( sit );
+		}
+
+		d->removeIfEmpty( channelName );
+	}
+}
+
+void
+SourcesBus::unsubscribe( SourcesSubscriber * subscriber )
+{
+	const QSet< QString > channels =
+		d->m_subscriberChannels.take( subscriber );
+
+	d->m_paused.remove( subscriber );
+
+	for( const auto & name : channels )
+	{
+		const auto it = d->m_channels.find( name );
+
+		if( it == d->m_channels.end() )
+			continue;
+
+		it.value().m_all.removeOne( subscriber );
+
+		for( auto sit = it.value().m_bySource.begin();
+			sit != it.value().m_bySource.end(); )
+		{
+			sit.value().removeOne( subscriber );
+
+			if( sit.value().isEmpty() )
+				sit = it.value().m_bySource.erase( sit );
+			else
+				++sit;
+		}
+
+		d->removeIfEmpty( name );
+	}
+}
+
+void
+SourcesBus::setPaused( SourcesSubscriber * subscriber, bool on )
+{
+	if( on )
+	{
+		if( !d->m_paused.contains( subscriber ) )
+			d->m_paused.insert( subscriber, {} );
+
+		return;
+	}
+
+	const auto it = d->m_paused.find( subscriber );
+
+	if( it == d->m_paused.end() )
+		return;
+
+	const QHash< QString, QSet< SourceId > > dirty = std::move( it.value() );
+
+	d->m_paused.erase( it );
+
+	if( dirty.isEmpty() )
+		return;
+
+	const SourcesSnapshot snapshot =
+		SourcesManager::instance().snapshot( dirty.keys() );
+
+	for( auto cit = dirty.cbegin(), last = dirty.cend(); cit != last; ++cit )
+	{
+		QList< SourceChange > changes;
+		changes.reserve( cit.value().size() );
+
+		for( const auto & id : cit.value() )
+		{
+			SourceChange c = { Como::Source( Como::Source::String, id.m_name,
+				id.m_typeName, QVariant(), QString() ), false };
+
+			if( snapshot.syncSource( cit.key(), c.m_source, c.m_registered ) )
+				changes.append( c );
+		}
+
+		// Subscriber could unsubscribe while catching up.
+		const auto sit = d->m_subscriberChannels.constFind( subscriber );
+
+		if( !changes.isEmpty() && sit != d->m_subscriberChannels.cend() &&
+			sit.value().contains( cit.key() ) )
+				subscriber->sourcesChanged( cit.key(), changes );
+	}
+}
+
+bool
+SourcesBus::isPaused( SourcesSubscriber * subscriber ) const
+{
+	return d->m_paused.contains( subscriber );
+}
+
+void
+SourcesBus::sourceUpdated( const Como::Source & source )
+{
+	addChange( source, true );
+}
+
+void
+SourcesBus::sourceDeregistered( const Como::Source & source )
+{
+	addChange( source, false );
+}
+
+void
+SourcesBus::addChange( const Como::Source & source, bool registered )
+{
+	Channel * channel = static_cast< Channel* > ( sender() );
+
+	const auto it = d->m_channels.find( channel->name() );
+
+	if( it == d->m_channels.end() )
+		return;
+
+	ChannelBus & bus = it.value();
+
+	const SourceId id( source.typeName(), source.name() );
+
+	if( bus.m_all.isEmpty() && !bus.m_bySource.contains( id ) )
+		return;
+
+	const auto pit = bus.m_pendingIndex.constFind( id );
+
+	if( pit != bus.m_pendingIndex.cend() )
+		bus.m_pending[ pit.value() ] = { source, registered };
+	else
+	{
+		bus.m_pendingIndex.insert( id, bus.m_pending.size() );
+		bus.m_pending.append( { source, registered } );
+	}
+
+	d->m_dirtyChannels.insert( channel->name() );
+
+	if( !d->m_flushTimer->isActive() )
+		d->m_flushTimer->start();
+}
+
+void
+SourcesBus::flush()
+{
+	const QSet< QString > channels = std::move( d->m_dirtyChannels );
+
+	d->m_dirtyChannels.clear();
+
+	for( const auto & name : channels )
+	{
+		const auto it = d->m_channels.find( name );
+
+		if( it == d->m_channels.end() )
+			continue;
+
+		const QList< SourceChange > changes = std::move( it.value().m_pending );
+
+		it.value().m_pending.clear();
+		it.value().m_pendingIndex.clear();
+
+		QHash< SourcesSubscriber*, QList< SourceChange > > batches;
+
+		for( auto * s : std::as_const( it.value().m_all ) )
+			batches.insert( s, changes );
+
+		if( !it.value().m_bySource.isEmpty() )
+		{
+			for( const auto & c : changes )
+			{
+				const auto sit = it.value().m_bySource.constFind(
+					SourceId( c.m_source.typeName(), c.m_source.name() ) );
+
+				if( sit == it.value().m_bySource.cend() )
+					continue;
+
+				for( auto * s : sit.value() )
+				{
+					if( !it.value().m_all.contains( s ) )
+						batches[ s ].append( c );
+				}
+			}
+		}
+
+		for( auto bit = batches.cbegin(), last = batches.cend();
+			bit != last; ++bit )
+		{
+			// Subscriber could unsubscribe while dispatching.
+			const auto sit = d->m_subscriberChannels.constFind( bit.key() );
+
+			if( sit == d->m_subscriberChannels.cend() ||
+				!sit.value().contains( name ) )
+					continue;
+
+			const auto pit = d->m_paused.find( bit.key() );
+
+			if( pit != d->m_paused.end() )
+			{
+				QSet< SourceId > & ids = pit.value()[ name ];
+
+				for( const auto & c : bit.value() )
+					ids.insert( SourceId( c.m_source.typeName(),
+						c.m_source.name() ) );
+			}
+			else
+				bit.key()->sourcesChanged( name, bit.value() );
+		}
+	}
+}
+
+void
+SourcesBus::channelCreated( Globe::Channel * channel )
+{
+	connect( channel, &Channel::sourceUpdated,
+		this, &SourcesBus::sourceUpdated );
+
+	connect( channel, &Channel::sourceDeregistered,
+		this, &SourcesBus::sourceDeregistered );
+}
+
+void
+SourcesBus::channelRemoved( Globe::Channel * channel )
+{
+	const auto it = d->m_channels.find( channel->name() );
+
+	if( it != d->m_channels.end() )
+	{
+		it.value().m_pending.clear();
+		it.value().m_pendingIndex.clear();
+	}
+
+	d->m_dirtyChannels.remove( channel->name() );
+
+	disconnect( channel, 0, this, 0 );
+}
+
+} /* namespace Globe */
@@ -0,0 +1,142 @@
+
+/*
+	SPDX-FileCopyrightText: 2012-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#ifndef GLOBE__SOURCES_BUS_HPP__INCLUDED
+#define GLOBE__SOURCES_BUS_HPP__INCLUDED
+
+// Qt include.
+#include <QObject>
+#include <QScopedPointer>
+#include <QString>
+#include <QList>
+
+// Como include.
+#include <Como/Source>
+
+// Globe include.
+#include <Core/export.hpp>
+
+
+namespace Globe {
+
+class Channel;
+
+
+//
+// SourceChange
+//
+
+//! Change of the source delivered by the sources bus.
+struct SourceChange {
+	//! Source.
+	Como::Source m_source;
+	//! Is source registered? False means source was deregistered.
+	bool m_registered;
+}; // struct SourceChange
+
+
+//
+// SourcesSubscriber
+//
+
+//! Subscriber of the sources bus.
+class CORE_EXPORT SourcesSubscriber {
+public:
+	virtual ~SourcesSubscriber();
+
+	//! Subscribed sources in the channel changed. Called once per batch
+	//! with the last change of every source.
+	virtual void sourcesChanged( const QString & channelName,
+		const QList< SourceChange > & changes ) = 0;
+}; // class SourcesSubscriber
+
+
+//
+// SourcesBus
+//
+
+class SourcesBusPrivate;
+
+/*!
+	Per-channel bus of the updates of the sources.
+
+	Bus is the only receiver of the updates and deregistrations from the
+	channels. Changes are collected into the batch of the channel, where
+	only the last change of every source is kept, and on the next
+	iteration of the event loop every subscriber gets one call with the
+	changes of the sources it subscribed to. Subscribers that don't show
+	anything just unsubscribe and cost nothing.
+
+	Hidden windows pause their subscriptions: only ids of the changed
+	sources are recorded for them, and when the window is shown again
+	it catches up with one batch per channel built from the snapshot of
+	the sources manager.
+*/
+class CORE_EXPORT SourcesBus
+	:	public QObject
+{
+	Q_OBJECT
+
+private:
+	SourcesBus( QObject * parent = 0 );
+
+	~SourcesBus();
+
+	static void cleanup();
+
+public:
+	//! \return Instance.
+	static SourcesBus & instance();
+
+	//! Subscribe to all sources of the channel.
+	void subscribe( SourcesSubscriber * subscriber,
+		const QString & channelName );
+	//! Subscribe to the source of the channel.
+	void subscribe( SourcesSubscriber * subscriber,
+		const QString & channelName, const QString & typeName,
+		const QString & sourceName );
+
+	//! Unsubscribe from all sources of the channel, subscriptions to
+	//! the single sources of the channel stay.
+	void unsubscribe( SourcesSubscriber * subscriber,
+		const QString & channelName );
+	//! Unsubscribe from the source of the channel.
+	void unsubscribe( SourcesSubscriber * subscriber,
+		const QString & channelName, const QString & typeName,
+		const QString & sourceName );
+	//! Unsubscribe from everything.
+	void unsubscribe( SourcesSubscriber * subscriber );
+
+	//! Pause or resume delivery of the changes to the subscriber.
+	void setPaused( SourcesSubscriber * subscriber, bool on = true );
+	//! \return Is delivery of the changes to the subscriber paused?
+	bool isPaused( SourcesSubscriber * subscriber ) const;
+
+private slots:
+	//! Source updated or registered.
+	void sourceUpdated( const Como::Source & source );
+	//! Source deregistered.
+	void sourceDeregistered( const Como::Source & source );
+	//! Channel created.
+	void channelCreated( Globe::Channel * channel );
+	//! Channel removed.
+	void channelRemoved( Globe::Channel * channel );
+	//! Dispatch batches.
+	void flush();
+
+private:
+	//! Add change to the batch of the channel.
+	void addChange( const Como::Source & source, bool registered );
+
+private:
+	Q_DISABLE_COPY( SourcesBus )
+
+	QScopedPointer< SourcesBusPrivate > d;
+}; // class SourcesBus
+
+} /* namespace Globe */
+
+#endif // GLOBE__SOURCES_BUS_HPP__INCLUDED
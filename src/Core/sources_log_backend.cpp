@@ -0,0 +1,163 @@
+
+/*
+	SPDX-FileCopyrightText: 2012-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// Globe include.
+#include <Core/sources_log_backend.hpp>
+
+// Qt include.
+#include <QDateTime>
+#include <QStringList>
+
+
+namespace Globe {
+
+QString
+sourcesLogDateTimeToString( const QDateTime & dt )
+{
+	return dt.toString( QLatin1String( "yyyy-MM-dd hh:mm:ss.zzz" ) );
+}
+
+QString
+sourcesLogCondition( const QDateTime & from,
+	const QDateTime & to,
+	const QString & channelName,
+	const QString & sourceName,
+	const QString & typeName,
+	QVariantList & values )
+{
+	QStringList conditions;
+
+	if( from.isValid() )
+	{
+		conditions.append( QLatin1String( "dateTime >= ?" ) );
+		values.append( sourcesLogDateTimeToString( from ) );
+	}
+
+	if( to.isValid() )
+	{
+		conditions.append( QLatin1String( "dateTime <= ?" ) );
+		values.append( sourcesLogDateTimeToString( to ) );
+	}
+
+	if( !channelName.isEmpty() )
+	{
+		conditions.append( QLatin1String( "channelName = ?" ) );
+		values.append( channelName );
+	}
+
+	if( !sourceName.isEmpty() )
+	{
+		conditions.append( QLatin1String( "sourceName = ?" ) );
+		values.append( sourceName );
+	}
+
+	if( !typeName.isEmpty() )
+	{
+		conditions.append( QLatin1String( "typeName = ?" ) );
+		values.append( typeName );
+	}
+
+	if( conditions.isEmpty() )
+		return QLatin1String( "1" );
+
+	return conditions.join( QLatin1String( " AND " ) );
+}
+
+
+//
+// SourcesLogCursorSource
+//
+
+SourcesLogCursorSource::~SourcesLogCursorSource()
+{
+}
+
+
+//
+// SqlSourcesLogCursorSource
+//
+
+//! Records of the executed query.
+class SqlSourcesLogCursorSource
+	:	public SourcesLogCursorSource
+{
+public:
+	explicit SqlSourcesLogCursorSource( const QSqlQuery & query )
+		:	m_query( query )
+	{
+	}
+
+	bool next() override
+	{
+		return m_query.next();
+	}
+
+	QVariant value( int column ) const override
+	{
+		return m_query.value( column );
+	}
+
+private:
+	//! Query.
+	QSqlQuery m_query;
+}; // class SqlSourcesLogCursorSource
+
+
+//
+// SourcesLogCursor
+//
+
+SourcesLogCursor::SourcesLogCursor()
+{
+}
+
+SourcesLogCursor::SourcesLogCursor( const QSqlQuery & query )
+	:	m_source( new SqlSourcesLogCursorSource( query ) )
+{
+}
+
+SourcesLogCursor::SourcesLogCursor( SourcesLogCursorSource * source )
+	:	m_source( source )
+{
+}
+
+bool
+SourcesLogCursor::next()
+{
+	if( !m_source )
+		return false;
+
+	if( m_source->next() )
+		return true;
+
+	// Nothing is held after the last record.
+	m_source.reset();
+
+	return false;
+}
+
+QVariant
+SourcesLogCursor::value( int column ) const
+{
+	return ( m_source ? m_source->value( column ) : QVariant() );
+}
+
+void
+SourcesLogCursor::finish()
+{
+	m_source.reset();
+}
+
+
+//
+// SourcesLogBackend
+//
+
+SourcesLogBackend::~SourcesLogBackend()
+{
+}
+
+} /* namespace Globe */
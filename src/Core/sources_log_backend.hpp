@@ -0,0 +1,150 @@
+
+/*
+	SPDX-FileCopyrightText: 2012-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#ifndef GLOBE__SOURCES_LOG_BACKEND_HPP__INCLUDED
+#define GLOBE__SOURCES_LOG_BACKEND_HPP__INCLUDED
+
+// Qt include.
+#include <QSqlQuery>
+#include <QString>
+#include <QVariant>
+#include <QVariantList>
+#include <QSharedPointer>
+
+// Como include.
+#include <Como/Source>
+
+// Globe include.
+#include <Core/export.hpp>
+
+
+QT_BEGIN_NAMESPACE
+class QDateTime;
+QT_END_NAMESPACE
+
+
+namespace Globe {
+
+//! \return Date and time as it's stored in the source's and event's logs.
+QString CORE_EXPORT sourcesLogDateTimeToString( const QDateTime & dt );
+
+/*!
+	\return Condition for the WHERE clause of the select from the
+	source's log. Values to bind are appended to \a values.
+	Invalid \a from or \a to means no limit.
+*/
+QString sourcesLogCondition( const QDateTime & from,
+	const QDateTime & to,
+	const QString & channelName,
+	const QString & sourceName,
+	const QString & typeName,
+	QVariantList & values );
+
+
+//
+// SourcesLogCursorSource
+//
+
+//! Source of the records read by the cursor of the source's log.
+class CORE_EXPORT SourcesLogCursorSource {
+public:
+	virtual ~SourcesLogCursorSource();
+
+	//! Move to the next record. \return false if there are no more.
+	virtual bool next() = 0;
+	//! \return Value of the column of the current record.
+	virtual QVariant value( int column ) const = 0;
+}; // class SourcesLogCursorSource
+
+
+//
+// SourcesLogCursor
+//
+
+/*!
+	Forward only cursor over the selected records of the source's log.
+
+	Backends stream records through it, so readers don't depend on
+	the storage. Copies share the position. Default constructed cursor
+	has no records.
+*/
+class CORE_EXPORT SourcesLogCursor {
+public:
+	SourcesLogCursor();
+
+	//! Cursor over the records of the executed query.
+	explicit SourcesLogCursor( const QSqlQuery & query );
+
+	//! Cursor over the records of the source, takes ownership.
+	explicit SourcesLogCursor( SourcesLogCursorSource * source );
+
+	//! Move to the next record. \return false if there are no more.
+	bool next();
+	//! \return Value of the column of the current record.
+	QVariant value( int column ) const;
+
+	//! Release resources, cursor has no more records then.
+	void finish();
+
+private:
+	//! Source of the records.
+	QSharedPointer< SourcesLogCursorSource > m_source;
+}; // class SourcesLogCursor
+
+
+//
+// SourcesLogBackend
+//
+
+/*!
+	Storage of the raw records of the source's log.
+
+	Selected records have columns: dateTime, channelName, type,
+	sourceName, typeName, value, desc and they are ordered by dateTime.
+*/
+class SourcesLogBackend {
+public:
+	virtual ~SourcesLogBackend();
+
+	//! Init backend. DB is ready at this moment.
+	virtual void init() = 0;
+
+	//! Write record.
+	virtual void write( const QDateTime & dateTime,
+		const QString & channelName,
+		Como::Source::Type type,
+		const QString & sourceName,
+		const QString & typeName,
+		const QString & value,
+		const QString & desc ) = 0;
+
+	//! Flush buffered records.
+	virtual void flush() = 0;
+
+	//! Select records. Invalid \a from or \a to means no limit.
+	virtual SourcesLogCursor select( const QDateTime & from,
+		const QDateTime & to,
+		const QString & channelName,
+		const QString & sourceName,
+		const QString & typeName ) = 0;
+
+	/*!
+		Erase records older than \a before. If \a wholeDaysOnly then
+		only days entirely older than \a before are erased, that
+		is the cheap way.
+
+		\return false if some records are still held by the readers and
+		erasing should be retried soon.
+	*/
+	virtual bool erase( const QDateTime & before, bool wholeDaysOnly ) = 0;
+
+	//! Erase all records.
+	virtual void clear() = 0;
+}; // class SourcesLogBackend
+
+} /* namespace Globe */
+
+#endif // GLOBE__SOURCES_LOG_BACKEND_HPP__INCLUDED
@@ -0,0 +1,190 @@
+
+/*
+	SPDX-FileCopyrightText: 2012-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#ifndef GLOBE__SOURCES_LOG_ENCODING_HPP__INCLUDED
+#define GLOBE__SOURCES_LOG_ENCODING_HPP__INCLUDED
+
+// Qt include.
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+#include <QHash>
+
+
+namespace Globe {
+
+//
+// Encoding helpers of the compact formats of the source's log.
+//
+
+//! Append unsigned LEB128 varint.
+inline void writeVarint( QByteArray & data, quint64 v )
+{
+	while( v >= 0x80 )
+	{
+		data.append( char( ( v & 0x7F ) | 0x80 ) );
+		v >>= 7;
+	}
+
+	data.append( char( v ) );
+}
+
+//! Read unsigned LEB128 varint at \a pos.
+inline bool readVarint( const QByteArray & data, int & pos,
+	quint64 & v )
+{
+	v = 0;
+
+	for( int shift = 0; pos < data.size() && shift < 64; shift += 7 )
+	{
+		const quint8 b = static_cast< quint8 > ( data.at( pos++ ) );
+
+		v |= quint64( b & 0x7F ) << shift;
+
+		if( !( b & 0x80 ) )
+			return true;
+	}
+
+	return false;
+}
+
+//! \return Zigzag encoded signed value.
+inline quint64 zigZag( qint64 v )
+{
+	return ( quint64( v ) << 1 ) ^ quint64( v >> 63 );
+}
+
+//! \return Zigzag decoded signed value.
+inline qint64 unZigZag( quint64 v )
+{
+	return qint64( v >> 1 ) ^ -qint64( v & 1 );
+}
+
+//! Append UTF-8 string prefixed with its size.
+inline void writeString( QByteArray & data, const QString & s )
+{
+	const QByteArray utf8 = s.toUtf8();
+
+	writeVarint( data, utf8.size() );
+	data.append( utf8 );
+}
+
+//! Read UTF-8 string prefixed with its size at \a pos.
+inline bool readString( const QByteArray & data, int & pos,
+	QString & s )
+{
+	quint64 size = 0;
+
+	if( !readVarint( data, pos, size ) ||
+		size > quint64( data.size() - pos ) )
+			return false;
+
+	s = QString::fromUtf8( data.constData() + pos, int( size ) );
+	pos += int( size );
+
+	return true;
+}
+
+
+//
+// SourcesLogBlockEncoder
+//
+
+/*!
+	Encoder of the columnar payload of the block of records.
+
+	Strings repeated in the records (channel, source, type name and
+	description) are written once into the dictionary of the block,
+	date and time are written as zigzag deltas from the previous record.
+	The payload is: dictionary, times, types, channels, sources,
+	type names, descriptions, values and extra column.
+*/
+class SourcesLogBlockEncoder {
+public:
+	explicit SourcesLogBlockEncoder( qint64 firstMsecs )
+		:	m_prev( firstMsecs )
+	{
+	}
+
+	//! Append record.
+	void add( qint64 msecs, int type, const QString & channelName,
+		const QString & sourceName, const QString & typeName,
+		const QString & value, const QString & desc )
+	{
+		writeVarint( m_times, zigZag( msecs - m_prev ) );
+		m_prev = msecs;
+
+		writeVarint( m_types, quint64( type ) );
+		writeVarint( m_channels, id( channelName ) );
+		writeVarint( m_sources, id( sourceName ) );
+		writeVarint( m_typeNames, id( typeName ) );
+		writeVarint( m_descs, id( desc ) );
+		writeString( m_values, value );
+	}
+
+	//! \return Extra column written after the values.
+	QByteArray & extra()
+	{
+		return m_extra;
+	}
+
+	//! \return Uncompressed payload of the block.
+	QByteArray payload() const
+	{
+		QByteArray data;
+
+		writeVarint( data, m_dictionary.size() );
+
+		for( const auto & s : m_dictionary )
+			writeString( data, s );
+
+		data.append( m_times );
+		data.append( m_types );
+		data.append( m_channels );
+		data.append( m_sources );
+		data.append( m_typeNames );
+		data.append( m_descs );
+		data.append( m_values );
+		data.append( m_extra );
+
+		return data;
+	}
+
+private:
+	//! \return Index of the string in the dictionary.
+	quint64 id( const QString & s )
+	{
+		auto it = m_ids.constFind( s );
+
+		if( it != m_ids.cend() )
+			return it.value();
+
+		m_dictionary.append( s );
+
+		return m_ids.insert( s, m_dictionary.size() - 1 ).value();
+	}
+
+private:
+	//! Date and time of the previous record.
+	qint64 m_prev;
+	//! Indexes of the strings in the dictionary.
+	QHash< QString, quint64 > m_ids;
+	//! Dictionary.
+	QStringList m_dictionary;
+	//! Columns.
+	QByteArray m_times;
+	QByteArray m_types;
+	QByteArray m_channels;
+	QByteArray m_sources;
+	QByteArray m_typeNames;
+	QByteArray m_descs;
+	QByteArray m_values;
+	QByteArray m_extra;
+}; // class SourcesLogBlockEncoder
+
+} /* namespace Globe */
+
+#endif // GLOBE__SOURCES_LOG_ENCODING_HPP__INCLUDED
@@ -0,0 +1,766 @@
+
+/*
+	SPDX-FileCopyrightText: 2012-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// Globe include.
+#include <Core/sources_log_segments_backend.hpp>
+#include <Core/utils.hpp>
+#include <Core/sources_log_encoding.hpp>
+
+// Qt include.
+#include <QDate>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QDataStream>
+#include <QMap>
+#include <QHash>
+#include <QVector>
+#include <QStringList>
+#include <QVariant>
+
+// C++ include.
+#include <limits>
+#include <vector>
+#include <algorithm>
+
+
+namespace Globe {
+
+//! Magic number of the block of the segment.
+static const quint32 segmentBlockMagic = 0x474C5342;
+
+//! Version of the format of the block.
+static const quint16 segmentBlockVersion = 1;
+
+//! Size of the header of the block in bytes:
+//! magic, version, count, first and last msecs, size of the payload.
+static const qint64 segmentBlockHeaderSize = 4 + 2 + 4 + 8 + 8 + 4;
+
+//! Max count of records in one block.
+static const int maxSegmentBlockRecords = 4096;
+
+//! Extension of the segment file.
+static const QString segmentFileSuffix = QLatin1String( ".seg" );
+
+
+//
+// SegmentRecord
+//
+
+//! Record of the source's log in the segment.
+struct SegmentRecord {
+	SegmentRecord()
+		:	m_msecs( 0 )
+		,	m_type( Como::Source::Int )
+	{
+	}
+
+	//! Date and time in msecs since epoch.
+	qint64 m_msecs;
+	//! Type of the source.
+	Como::Source::Type m_type;
+	//! Channel name.
+	QString m_channelName;
+	//! Source name.
+	QString m_sourceName;
+	//! Type name.
+	QString m_typeName;
+	//! Value.
+	QString m_value;
+	//! Description.
+	QString m_desc;
+}; // struct SegmentRecord
+
+
+//
+// SegmentBlock
+//
+
+//! Entry of the index of the blocks of the segment.
+struct SegmentBlock {
+	SegmentBlock()
+		:	m_offset( 0 )
+		,	m_count( 0 )
+		,	m_first( 0 )
+		,	m_last( 0 )
+		,	m_size( 0 )
+	{
+	}
+
+	//! Offset of the block in the file.
+	qint64 m_offset;
+	//! Count of records.
+	quint32 m_count;
+	//! Min date and time in the block.
+	qint64 m_first;
+	//! Max date and time in the block.
+	qint64 m_last;
+	//! Size of the compressed payload.
+	quint32 m_size;
+}; // struct SegmentBlock
+
+
+//
+// Segment
+//
+
+//! Segment with records of one day.
+struct Segment {
+	Segment()
+		:	m_isIndexed( false )
+	{
+	}
+
+	//! File name.
+	QString m_fileName;
+	//! Is index of blocks built?
+	bool m_isIndexed;
+	//! Blocks.
+	QVector< SegmentBlock > m_blocks;
+}; // struct Segment
+
+
+//
+// Blocks encoding.
+//
+
+//! Encode records into the uncompressed payload of the block.
+static QByteArray encodeSegmentBlock( const QVector< SegmentRecord > & records,
+	int first, int count, qint64 firstMsecs )
+{
+	SourcesLogBlockEncoder encoder( firstMsecs );
+
+	for( int i = first; i < first + count; ++i )
+	{
+		const SegmentRecord & r = records.at( i );
+
+		encoder.add( r.m_msecs, r.m_type, r.m_channelName, r.m_sourceName,
+			r.m_typeName, r.m_value, r.m_desc );
+	}
+
+	return encoder.payload();
+}
+
+//! Decode uncompressed payload of the block.
+static bool decodeSegmentBlock( const QByteArray & data, quint32 count,
+	qint64 firstMsecs, QVector< SegmentRecord > & records )
+{
+	int pos = 0;
+	quint64 v = 0;
+
+	if( !readVarint( data, pos, v ) )
+		return false;
+
+	QStringList dictionary;
+
+	for( quint64 i = 0; i < v; ++i )
+	{
+		QString s;
+
+		if( !readString( data, pos, s ) )
+			return false;
+
+		dictionary.append( s );
+	}
+
+	records.resize( count );
+
+	qint64 prev = firstMsecs;
+
+	for( quint32 i = 0; i < count; ++i )
+	{
+		if( !readVarint( data, pos, v ) )
+			return false;
+
+		prev += unZigZag( v );
+		records[ i ].m_msecs = prev;
+	}
+
+	for( quint32 i = 0; i < count; ++i )
+	{
+		if( !readVarint( data, pos, v ) )
+			return false;
+
+		records[ i ].m_type = static_cast< Como::Source::Type > ( v );
+	}
+
+	QString SegmentRecord::* columns[] = { &SegmentRecord::m_channelName,
+		&SegmentRecord::m_sourceName, &SegmentRecord::m_typeName,
+		&SegmentRecord::m_desc };
+
+	for( auto column : columns )
+	{
+		for( quint32 i = 0; i < count; ++i )
+		{
+			if( !readVarint( data, pos, v ) ||
+				v >= quint64( dictionary.size() ) )
+					return false;
+
+			records[ i ].*column = dictionary.at( int( v ) );
+		}
+	}
+
+	for( quint32 i = 0; i < count; ++i )
+	{
+		if( !readString( data, pos, records[ i ].m_value ) )
+			return false;
+	}
+
+	return true;
+}
+
+
+//
+// SegmentsSourcesLogBackendPrivate
+//
+
+class SegmentsSourcesLogBackendPrivate {
+public:
+	explicit SegmentsSourcesLogBackendPrivate( const QString & dirPath )
+		:	m_dirPath( dirPath )
+	{
+	}
+
+	//! \return Segment for the given day.
+	Segment & segment( const QDate & day );
+	//! Build index of the blocks of the segment if not yet.
+	void indexSegment( Segment & s );
+	//! Append records as blocks to the file.
+	void appendBlocks( QFile & file, const QVector< SegmentRecord > & records,
+		Segment * s );
+	//! Read records of the block.
+	static bool readBlock( QFile & file, const SegmentBlock & b,
+		QVector< SegmentRecord > & records );
+	//! Keep in the segment only records not older than \a before.
+	void cutSegment( const QDate & day, qint64 before );
+
+	//! Directory with segments.
+	QString m_dirPath;
+	//! Segments.
+	QMap< QDate, Segment > m_segments;
+	//! Not yet written records.
+	QMap< QDate, QVector< SegmentRecord > > m_buffers;
+}; // class SegmentsSourcesLogBackendPrivate
+
+Segment &
+SegmentsSourcesLogBackendPrivate::segment( const QDate & day )
+{
+	QMap< QDate, Segment >::Iterator it = m_segments.find( day );
+
+	if( it == m_segments.end() )
+	{
+		it = m_segments.insert( day, Segment() );
+
+		it.value().m_fileName = m_dirPath + QLatin1Char( '/' ) +
+			day.toString( QLatin1String( "yyyyMMdd" ) ) + segmentFileSuffix;
+	}
+
+	return it.value();
+}
+
+void
+SegmentsSourcesLogBackendPrivate::indexSegment( Segment & s )
+{
+	if( s.m_isIndexed )
+		return;
+
+	s.m_blocks.clear();
+
+	QFile file( s.m_fileName );
+
+	if( file.open( QIODevice::ReadWrite ) )
+	{
+		QDataStream stream( &file );
+
+		const qint64 size = file.size();
+		qint64 offset = 0;
+
+		while( offset + segmentBlockHeaderSize <= size )
+		{
+			quint32 magic = 0;
+			quint16 version = 0;
+			SegmentBlock b;
+
+			file.seek( offset );
+
+			stream >> magic >> version >> b.m_count >> b.m_first >> b.m_last
+				>> b.m_size;
+
+			if( stream.status() != QDataStream::Ok ||
+				magic != segmentBlockMagic || version != segmentBlockVersion ||
+				offset + segmentBlockHeaderSize + b.m_size > size )
+					break;
+
+			b.m_offset = offset;
+
+			s.m_blocks.append( b );
+
+			offset += segmentBlockHeaderSize + b.m_size;
+		}
+
+		// Write of the last block was interrupted.
+		if( offset < size )
+			file.resize( offset );
+
+		file.close();
+	}
+
+	s.m_isIndexed = true;
+}
+
+void
+SegmentsSourcesLogBackendPrivate::appendBlocks( QFile & file,
+	const QVector< SegmentRecord > & records, Segment * s )
+{
+	QDataStream stream( &file );
+
+	for( int first = 0; first < records.size();
+		first += maxSegmentBlockRecords )
+	{
+		const int count = qMin( maxSegmentBlockRecords,
+			int( records.size() - first ) );
+
+		SegmentBlock b;
+		b.m_offset = file.size();
+		b.m_count = count;
+		b.m_first = records.at( first ).m_msecs;
+		b.m_last = b.m_first;
+
+		for( int i = first; i < first + count; ++i )
+		{
+			b.m_first = qMin( b.m_first, records.at( i ).m_msecs );
+			b.m_last = qMax( b.m_last, records.at( i ).m_msecs );
+		}
+
+		const QByteArray payload = qCompress( encodeSegmentBlock( records,
+			first, count, b.m_first ) );
+
+		b.m_size = payload.size();
+
+		file.seek( b.m_offset );
+
+		stream << segmentBlockMagic << segmentBlockVersion << b.m_count
+			<< b.m_first << b.m_last << b.m_size;
+		stream.writeRawData( payload.constData(), payload.size() );
+
+		if( s )
+			s->m_blocks.append( b );
+	}
+}
+
+bool
+SegmentsSourcesLogBackendPrivate::readBlock( QFile & file,
+	const SegmentBlock & b, QVector< SegmentRecord > & records )
+{
+	if( !file.seek( b.m_offset + segmentBlockHeaderSize ) )
+		return false;
+
+	const QByteArray data = qUncompress( file.read( b.m_size ) );
+
+	return decodeSegmentBlock( data, b.m_count, b.m_first, records );
+}
+
+void
+SegmentsSourcesLogBackendPrivate::cutSegment( const QDate & day,
+	qint64 before )
+{
+	if( !m_segments.contains( day ) )
+		return;
+
+	Segment & s = segment( day );
+
+	indexSegment( s );
+
+	QVector< SegmentRecord > kept;
+
+	QFile file( s.m_fileName );
+
+	if( !file.open( QIODevice::ReadOnly ) )
+		return;
+
+	for( const auto & b : std::as_const( s.m_blocks ) )
+	{
+		if( b.m_last < before )
+			continue;
+
+		QVector< SegmentRecord > records;
+
+		if( !readBlock( file, b, records ) )
+			continue;
+
+		for( const auto & r : std::as_const( records ) )
+			if( r.m_msecs >= before )
+				kept.append( r );
+	}
+
+	file.close();
+
+	QFile tmp( s.m_fileName + QLatin1String( ".tmp" ) );
+
+	if( !tmp.open( QIODevice::WriteOnly | QIODevice::Truncate ) )
+		return;
+
+	appendBlocks( tmp, kept, nullptr );
+
+	tmp.close();
+
+	QFile::remove( s.m_fileName );
+	tmp.rename( s.m_fileName );
+
+	s.m_isIndexed = false;
+}
+
+//
+// SegmentsCursorBlock
+//
+
+//! Block to read by the cursor.
+struct SegmentsCursorBlock {
+	//! File name of the segment.
+	QString m_fileName;
+	//! Block.
+	SegmentBlock m_block;
+}; // struct SegmentsCursorBlock
+
+
+//
+// SegmentsCursorSource
+//
+
+/*!
+	Records of the segments streamed block by block.
+
+	Blocks are read in order of their first date and time, only blocks
+	overlapping with not yet returned records are kept decoded, so
+	memory doesn't depend on the selected range. Segment file is opened
+	only while the block is read.
+*/
+class SegmentsCursorSource
+	:	public SourcesLogCursorSource
+{
+public:
+	SegmentsCursorSource( const QVector< SegmentsCursorBlock > & blocks,
+		qint64 from, qint64 to,
+		const QString & channelName,
+		const QString & sourceName,
+		const QString & typeName )
+		:	m_blocks( blocks )
+		,	m_nextBlock( 0 )
+		,	m_from( from )
+		,	m_to( to )
+		,	m_channelName( channelName )
+		,	m_sourceName( sourceName )
+		,	m_typeName( typeName )
+		,	m_seq( 0 )
+	{
+		std::stable_sort( m_blocks.begin(), m_blocks.end(),
+			[] ( const SegmentsCursorBlock & b1, const SegmentsCursorBlock & b2 )
+				{ return b1.m_block.m_first < b2.m_block.m_first; } );
+	}
+
+	bool next() override
+	{
+		// Block starting later than the earliest decoded record can't
+		// have records before it.
+		while( m_nextBlock < m_blocks.size() && ( m_heap.empty() ||
+			m_blocks.at( m_nextBlock ).m_block.m_first <=
+				m_heap.front().m_record.m_msecs ) )
+					readBlock( m_blocks.at( m_nextBlock++ ) );
+
+		if( m_heap.empty() )
+			return false;
+
+		std::pop_heap( m_heap.begin(), m_heap.end(), later );
+
+		m_current = std::move( m_heap.back().m_record );
+		m_heap.pop_back();
+
+		return true;
+	}
+
+	QVariant value( int column ) const override
+	{
+		switch( column )
+		{
+			case 0 :
+				return sourcesLogDateTimeToString(
+					QDateTime::fromMSecsSinceEpoch( m_current.m_msecs ) );
+			case 1 :
+				return m_current.m_channelName;
+			case 2 :
+				return (int) m_current.m_type;
+			case 3 :
+				return m_current.m_sourceName;
+			case 4 :
+				return m_current.m_typeName;
+			case 5 :
+				return m_current.m_value;
+			case 6 :
+				return m_current.m_desc;
+			default :
+				return QVariant();
+		}
+	}
+
+private:
+	//! Decoded record waiting to be returned.
+	struct Entry {
+		//! Record.
+		SegmentRecord m_record;
+		//! Sequence number, keeps order of the records with the same
+		//! date and time.
+		quint64 m_seq;
+	}; // struct Entry
+
+	//! \return Should \a e1 be returned after \a e2?
+	static bool later( const Entry & e1, const Entry & e2 )
+	{
+		if( e1.m_record.m_msecs != e2.m_record.m_msecs )
+			return ( e1.m_record.m_msecs > e2.m_record.m_msecs );
+		else
+			return ( e1.m_seq > e2.m_seq );
+	}
+
+	//! Decode matching records of the block.
+	void readBlock( const SegmentsCursorBlock & b )
+	{
+		QFile file( b.m_fileName );
+
+		if( !file.open( QIODevice::ReadOnly ) )
+			return;
+
+		QVector< SegmentRecord > records;
+
+		const bool ok = SegmentsSourcesLogBackendPrivate::readBlock( file,
+			b.m_block, records );
+
+		file.close();
+
+		if( !ok )
+			return;
+
+		for( auto & r : records )
+		{
+			if( r.m_msecs < m_from || r.m_msecs > m_to ||
+				( !m_channelName.isEmpty() && r.m_channelName != m_channelName ) ||
+				( !m_sourceName.isEmpty() && r.m_sourceName != m_sourceName ) ||
+				( !m_typeName.isEmpty() && r.m_typeName != m_typeName ) )
+					continue;
+
+			m_heap.push_back( { std::move( r ), m_seq++ } );
+			std::push_heap( m_heap.begin(), m_heap.end(), later );
+		}
+	}
+
+private:
+	//! Blocks ordered by the first date and time.
+	QVector< SegmentsCursorBlock > m_blocks;
+	//! Index of the next block to read.
+	int m_nextBlock;
+	//! Start of the range.
+	qint64 m_from;
+	//! End of the range.
+	qint64 m_to;
+	//! Channel name.
+	QString m_channelName;
+	//! Source name.
+	QString m_sourceName;
+	//! Type name.
+	QString m_typeName;
+	//! Decoded records, the earliest is on the top.
+	std::vector< Entry > m_heap;
+	//! Next sequence number.
+	quint64 m_seq;
+	//! Current record.
+	SegmentRecord m_current;
+}; // class SegmentsCursorSource
+
+
+//
+// SegmentsSourcesLogBackend
+//
+
+SegmentsSourcesLogBackend::SegmentsSourcesLogBackend( const QString & dirPath )
+	:	d( new SegmentsSourcesLogBackendPrivate( dirPath ) )
+{
+}
+
+SegmentsSourcesLogBackend::~SegmentsSourcesLogBackend()
+{
+	flush();
+}
+
+void
+SegmentsSourcesLogBackend::init()
+{
+	flush();
+
+	d->m_segments.clear();
+
+	checkPathAndCreateIfNotExists( d->m_dirPath );
+
+	const QStringList files = QDir( d->m_dirPath ).entryList(
+		QStringList() << QLatin1String( "*" ) + segmentFileSuffix,
+		QDir::Files );
+
+	for( const auto & f : files )
+	{
+		const QDate day = QDate::fromString(
+			f.left( f.size() - segmentFileSuffix.size() ),
+			QLatin1String( "yyyyMMdd" ) );
+
+		if( day.isValid() )
+			d->segment( day );
+	}
+}
+
+void
+SegmentsSourcesLogBackend::write( const QDateTime & dateTime,
+	const QString & channelName,
+	Como::Source::Type type,
+	const QString & sourceName,
+	const QString & typeName,
+	const QString & value,
+	const QString & desc )
+{
+	SegmentRecord r;
+	r.m_msecs = dateTime.toMSecsSinceEpoch();
+	r.m_type = type;
+	r.m_channelName = channelName;
+	r.m_sourceName = sourceName;
+	r.m_typeName = typeName;
+	r.m_value = value;
+	r.m_desc = desc;
+
+	QVector< SegmentRecord > & buffer = d->m_buffers[ dateTime.date() ];
+
+	buffer.append( r );
+
+	if( buffer.size() >= maxSegmentBlockRecords )
+		flush();
+}
+
+void
+SegmentsSourcesLogBackend::flush()
+{
+	for( auto it = d->m_buffers.cbegin(), last = d->m_buffers.cend();
+		it != last; ++it )
+	{
+		if( it.value().isEmpty() )
+			continue;
+
+		Segment & s = d->segment( it.key() );
+
+		d->indexSegment( s );
+
+		QFile file( s.m_fileName );
+
+		if( file.open( QIODevice::ReadWrite ) )
+		{
+			d->appendBlocks( file, it.value(), &s );
+
+			file.close();
+		}
+	}
+
+	d->m_buffers.clear();
+}
+
+SourcesLogCursor
+SegmentsSourcesLogBackend::select( const QDateTime & from,
+	const QDateTime & to,
+	const QString & channelName,
+	const QString & sourceName,
+	const QString & typeName )
+{
+	flush();
+
+	const qint64 fromMsecs = ( from.isValid() ? from.toMSecsSinceEpoch() :
+		std::numeric_limits< qint64 >::min() );
+	const qint64 toMsecs = ( to.isValid() ? to.toMSecsSinceEpoch() :
+		std::numeric_limits< qint64 >::max() );
+
+	QVector< SegmentsCursorBlock > blocks;
+
+	// Only the index is looked up here, blocks are read by the cursor.
+	for( auto it = d->m_segments.begin(), last = d->m_segments.end();
+		it != last; ++it )
+	{
+		if( from.isValid() && it.key() < from.date() )
+			continue;
+
+		if( to.isValid() && it.key() > to.date() )
+			break;
+
+		d->indexSegment( it.value() );
+
+		for( const auto & b : std::as_const( it.value().m_blocks ) )
+		{
+			if( b.m_last < fromMsecs || b.m_first > toMsecs )
+				continue;
+
+			SegmentsCursorBlock cb;
+			cb.m_fileName = it.value().m_fileName;
+			cb.m_block = b;
+
+			blocks.append( cb );
+		}
+	}
+
+	if( blocks.isEmpty() )
+		return SourcesLogCursor();
+
+	return SourcesLogCursor( new SegmentsCursorSource( blocks,
+		fromMsecs, toMsecs, channelName, sourceName, typeName ) );
+}
+
+bool
+SegmentsSourcesLogBackend::erase( const QDateTime & before, bool wholeDaysOnly )
+{
+	const QDate day = before.date();
+
+	bool done = true;
+
+	while( !d->m_buffers.isEmpty() && d->m_buffers.firstKey() < day )
+		d->m_buffers.erase( d->m_buffers.begin() );
+
+	for( auto it = d->m_segments.begin();
+		it != d->m_segments.end() && it.key() < day; )
+	{
+		// File opened by the reader can't be removed on some platforms.
+		if( QFile::remove( it.value().m_fileName ) ||
+			!QFile::exists( it.value().m_fileName ) )
+				it = d->m_segments.erase( it );
+		else
+		{
+			done = false;
+
+			++it;
+		}
+	}
+
+	if( !wholeDaysOnly )
+	{
+		flush();
+
+		d->cutSegment( day, before.toMSecsSinceEpoch() );
+	}
+
+	return done;
+}
+
+void
+SegmentsSourcesLogBackend::clear()
+{
+	d->m_buffers.clear();
+
+	for( const auto & s : std::as_const( d->m_segments ) )
+		QFile::remove( s.m_fileName );
+
+	d->m_segments.clear();
+}
+
+} /* namespace Globe */
@@ -0,0 +1,77 @@
+
+/*
+	SPDX-FileCopyrightText: 2012-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#ifndef GLOBE__SOURCES_LOG_SEGMENTS_BACKEND_HPP__INCLUDED
+#define GLOBE__SOURCES_LOG_SEGMENTS_BACKEND_HPP__INCLUDED
+
+// Qt include.
+#include <QScopedPointer>
+
+// Globe include.
+#include <Core/sources_log_backend.hpp>
+
+
+namespace Globe {
+
+//
+// SegmentsSourcesLogBackend
+//
+
+class SegmentsSourcesLogBackendPrivate;
+
+/*!
+	Source's log in the append-only segment files, one file per day.
+
+	Segment is a sequence of blocks. Each block has header with count of
+	records and time range of the block, and compressed columns of the
+	records: delta encoded timestamps, types and dictionary encoded
+	strings. Index of the blocks is built from headers on the first
+	access to the segment, partially written block at the end of the
+	segment is cut off.
+
+	Selected records are streamed by the cursor block by block, only the
+	index of the blocks is looked up on select.
+*/
+class SegmentsSourcesLogBackend
+	:	public SourcesLogBackend
+{
+public:
+	//! \a dirPath is the directory where segments are stored.
+	explicit SegmentsSourcesLogBackend( const QString & dirPath );
+
+	~SegmentsSourcesLogBackend();
+
+	void init() override;
+
+	void write( const QDateTime & dateTime,
+		const QString & channelName,
+		Como::Source::Type type,
+		const QString & sourceName,
+		const QString & typeName,
+		const QString & value,
+		const QString & desc ) override;
+
+	void flush() override;
+
+	SourcesLogCursor select( const QDateTime & from,
+		const QDateTime & to,
+		const QString & channelName,
+		const QString & sourceName,
+		const QString & typeName ) override;
+
+	bool erase( const QDateTime & before, bool wholeDaysOnly ) override;
+
+	void clear() override;
+
+private:
+	Q_DISABLE_COPY( SegmentsSourcesLogBackend )
+
+	QScopedPointer< SegmentsSourcesLogBackendPrivate > d;
+}; // class SegmentsSourcesLogBackend
+
+} /* namespace Globe */
+
+#endif // GLOBE__SOURCES_LOG_SEGMENTS_BACKEND_HPP__INCLUDED
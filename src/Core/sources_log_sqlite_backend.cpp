@@ -0,0 +1,402 @@
+
+/*
+	SPDX-FileCopyrightText: 2012-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// Globe include.
+#include <Core/sources_log_sqlite_backend.hpp>
+
+// Qt include.
+#include <QDate>
+#include <QDateTime>
+#include <QMap>
+#include <QStringList>
+#include <QVariant>
+
+
+namespace Globe {
+
+//
+// Source's log partitions.
+//
+
+//! Prefix of the name of the source's log partition table.
+static const QString sourcesLogPartitionPrefix =
+	QLatin1String( "sourcesLog_" );
+
+//! Name of the source's log table created before partitioning.
+static const QString sourcesLogLegacyTable =
+	QLatin1String( "sourcesLogLegacy" );
+
+//! Columns of the source's log.
+static const QString sourcesLogColumns = QLatin1String(
+	"dateTime, channelName, type, sourceName, typeName, value, desc" );
+
+//! Max number of arms in one compound SELECT.
+//! SQLite refuses compound SELECTs longer than 500 arms by default.
+static const int maxSourcesLogUnionArms = 250;
+
+static inline QString sourcesLogPartitionName( const QDate & day )
+{
+	return sourcesLogPartitionPrefix +
+		day.toString( QLatin1String( "yyyyMMdd" ) );
+}
+
+//! Join selects with UNION ALL, nesting them if they are too many.
+static inline QString unionAllSelects( const QStringList & selects )
+{
+	if( selects.size() <= maxSourcesLogUnionArms )
+		return selects.join( QLatin1String( " UNION ALL " ) );
+
+	QStringList chunks;
+
+	for( int i = 0; i < selects.size(); i += maxSourcesLogUnionArms )
+		chunks.append( QString( "SELECT * FROM ( %1 )" )
+			.arg( selects.mid( i, maxSourcesLogUnionArms )
+				.join( QLatin1String( " UNION ALL " ) ) ) );
+
+	return unionAllSelects( chunks );
+}
+
+
+//
+// SqliteSourcesLogBackendPrivate
+//
+
+class SqliteSourcesLogBackendPrivate {
+public:
+	SqliteSourcesLogBackendPrivate()
+		:	m_hasLegacySourcesLog( false )
+	{
+	}
+
+	//! Create partition of the source's log for the given day.
+	//! \return Name of the partition's table.
+	QString sourcesLogPartition( const QDate & day );
+	//! Recreate "sourcesLog" view over all partitions.
+	void recreateSourcesLogView();
+	//! Drop partitions of the source's log older than the given day.
+	//! \return false if some partitions were only emptied.
+	bool dropSourcesLogPartitions( const QDate & before );
+	//! Drop legacy table.
+	void dropLegacySourcesLog();
+
+	//! Partitions of the source's log, day -> table's name.
+	QMap< QDate, QString > m_sourcesLogPartitions;
+	//! Is there the old not partitioned source's log table?
+	bool m_hasLegacySourcesLog;
+}; // class SqliteSourcesLogBackendPrivate
+
+QString
+SqliteSourcesLogBackendPrivate::sourcesLogPartition( const QDate & day )
+{
+	QMap< QDate, QString >::ConstIterator it =
+		m_sourcesLogPartitions.constFind( day );
+
+	if( it != m_sourcesLogPartitions.cend() )
+		return it.value();
+
+	const QString name = sourcesLogPartitionName( day );
+
+	QSqlQuery create;
+
+	if( !create.exec( QString( "CREATE TABLE IF NOT EXISTS %1 ( "
+		"dateTime TEXT, channelName TEXT, type INTEGER, sourceName TEXT, "
+		"typeName TEXT, value TEXT, desc TEXT )" ).arg( name ) ) )
+			return QString();
+
+	create.exec( QString( "CREATE INDEX IF NOT EXISTS %1DateTimeIdx "
+		"ON %1 ( dateTime )" ).arg( name ) );
+
+	m_sourcesLogPartitions.insert( day, name );
+
+	recreateSourcesLogView();
+
+	return name;
+}
+
+void
+SqliteSourcesLogBackendPrivate::recreateSourcesLogView()
+{
+	QStringList selects;
+
+	if( m_hasLegacySourcesLog )
+		selects.append( QString( "SELECT %1 FROM %2" )
+			.arg( sourcesLogColumns, sourcesLogLegacyTable ) );
+
+	for( const auto & name : std::as_const( m_sourcesLogPartitions ) )
+		selects.append( QString( "SELECT %1 FROM %2" )
+			.arg( sourcesLogColumns, name ) );
+
+	if( selects.isEmpty() )
+		selects.append( QLatin1String( "SELECT '' AS dateTime, "
+			"'' AS channelName, 0 AS type, '' AS sourceName, "
+			"'' AS typeName, '' AS value, '' AS desc WHERE 0" ) );
+
+	QSqlQuery query;
+
+	query.exec( QLatin1String( "DROP VIEW IF EXISTS sourcesLog" ) );
+	query.exec( QString( "CREATE VIEW sourcesLog AS %1" )
+		.arg( unionAllSelects( selects ) ) );
+}
+
+bool
+SqliteSourcesLogBackendPrivate::dropSourcesLogPartitions( const QDate & before )
+{
+	bool changed = false;
+	bool done = true;
+
+	QMap< QDate, QString >::Iterator it = m_sourcesLogPartitions.begin();
+
+	while( it != m_sourcesLogPartitions.end() && it.key() < before )
+	{
+		QSqlQuery drop;
+
+		if( drop.exec( QString( "DROP TABLE IF EXISTS %1" )
+			.arg( it.value() ) ) )
+		{
+			it = m_sourcesLogPartitions.erase( it );
+
+			changed = true;
+		}
+		else
+		{
+			// Dropping fails with SQLITE_LOCKED while any statement is
+			// active on the connection, deleting doesn't. Records go
+			// away now, empty table is dropped by the retry.
+			QSqlQuery deleteQuery;
+			deleteQuery.exec( QString( "DELETE FROM %1" ).arg( it.value() ) );
+
+			done = false;
+
+			++it;
+		}
+	}
+
+	if( changed )
+		recreateSourcesLogView();
+
+	return done;
+}
+
+void
+SqliteSourcesLogBackendPrivate::dropLegacySourcesLog()
+{
+	QSqlQuery drop;
+
+	if( drop.exec( QString( "DROP TABLE IF EXISTS %1" )
+		.arg( sourcesLogLegacyTable ) ) )
+	{
+		m_hasLegacySourcesLog = false;
+
+		recreateSourcesLogView();
+	}
+}
+
+
+//
+// SqliteSourcesLogBackend
+//
+
+SqliteSourcesLogBackend::SqliteSourcesLogBackend()
+	:	d( new SqliteSourcesLogBackendPrivate )
+{
+}
+
+SqliteSourcesLogBackend::~SqliteSourcesLogBackend()
+{
+}
+
+void
+SqliteSourcesLogBackend::init()
+{
+	d->m_sourcesLogPartitions.clear();
+	d->m_hasLegacySourcesLog = false;
+
+	QSqlQuery master;
+	master.prepare( QLatin1String(
+		"SELECT name, type FROM sqlite_master "
+		"WHERE type IN ( 'table', 'view' ) AND name LIKE 'sourcesLog%'" ) );
+
+	bool legacyToMigrate = false;
+
+	if( master.exec() )
+	{
+		while( master.next() )
+		{
+			const QString name = master.value( 0 ).toString();
+			const QString type = master.value( 1 ).toString();
+
+			if( name == QLatin1String( "sourcesLog" ) )
+				legacyToMigrate = ( type == QLatin1String( "table" ) );
+			else if( name == sourcesLogLegacyTable )
+				d->m_hasLegacySourcesLog = true;
+			else if( name.startsWith( sourcesLogPartitionPrefix ) )
+			{
+				const QDate day = QDate::fromString(
+					name.mid( sourcesLogPartitionPrefix.size() ),
+					QLatin1String( "yyyyMMdd" ) );
+
+				if( day.isValid() )
+					d->m_sourcesLogPartitions.insert( day, name );
+			}
+		}
+	}
+
+	master.finish();
+
+	// The source's log of previous versions was one table with the
+	// name of the current view. Keep it as is, retention will erase it.
+	if( legacyToMigrate && !d->m_hasLegacySourcesLog )
+	{
+		QSqlQuery rename;
+
+		if( rename.exec( QString( "ALTER TABLE sourcesLog RENAME TO %1" )
+			.arg( sourcesLogLegacyTable ) ) )
+				d->m_hasLegacySourcesLog = true;
+	}
+
+	d->recreateSourcesLogView();
+}
+
+void
+SqliteSourcesLogBackend::write( const QDateTime & dateTime,
+	const QString & channelName,
+	Como::Source::Type type,
+	const QString & sourceName,
+	const QString & typeName,
+	const QString & value,
+	const QString & desc )
+{
+	const QString partition = d->sourcesLogPartition( dateTime.date() );
+
+	if( partition.isEmpty() )
+		return;
+
+	QSqlQuery insert;
+	insert.prepare( QString( "INSERT INTO %1 ( %2 ) "
+		"VALUES ( ?, ?, ?, ?, ?, ?, ? )" )
+			.arg( partition, sourcesLogColumns ) );
+
+	insert.addBindValue( sourcesLogDateTimeToString( dateTime ) );
+	insert.addBindValue( channelName );
+	insert.addBindValue( (int) type );
+	insert.addBindValue( sourceName );
+	insert.addBindValue( typeName );
+	insert.addBindValue( value );
+	insert.addBindValue( desc );
+
+	insert.exec();
+}
+
+void
+SqliteSourcesLogBackend::flush()
+{
+}
+
+SourcesLogCursor
+SqliteSourcesLogBackend::select( const QDateTime & from,
+	const QDateTime & to,
+	const QString & channelName,
+	const QString & sourceName,
+	const QString & typeName )
+{
+	QStringList tables;
+
+	if( d->m_hasLegacySourcesLog )
+		tables.append( sourcesLogLegacyTable );
+
+	// Prune partitions that can't contain records in the given range.
+	for( auto it = d->m_sourcesLogPartitions.cbegin(),
+		last = d->m_sourcesLogPartitions.cend(); it != last; ++it )
+	{
+		if( from.isValid() && it.key() < from.date() )
+			continue;
+
+		if( to.isValid() && it.key() > to.date() )
+			break;
+
+		tables.append( it.value() );
+	}
+
+	if( tables.isEmpty() )
+		return SourcesLogCursor();
+
+	QVariantList values;
+
+	const QString where = sourcesLogCondition( from, to,
+		channelName, sourceName, typeName, values );
+
+	QStringList selects;
+
+	for( const auto & t : std::as_const( tables ) )
+		selects.append( QString( "SELECT %1 FROM %2 WHERE %3" )
+			.arg( sourcesLogColumns, t, where ) );
+
+	QSqlQuery select;
+	select.setForwardOnly( true );
+
+	select.prepare( QString( "%1 ORDER BY dateTime" )
+		.arg( unionAllSelects( selects ) ) );
+
+	for( int i = 0; i < tables.size(); ++i )
+		for( const auto & v : std::as_const( values ) )
+			select.addBindValue( v );
+
+	select.exec();
+
+	return SourcesLogCursor( select );
+}
+
+bool
+SqliteSourcesLogBackend::erase( const QDateTime & before, bool wholeDaysOnly )
+{
+	const bool done = d->dropSourcesLogPartitions( before.date() );
+
+	if( !wholeDaysOnly &&
+		d->m_sourcesLogPartitions.contains( before.date() ) )
+	{
+		QSqlQuery eraseQuery;
+		eraseQuery.prepare( QString( "DELETE FROM %1 WHERE dateTime < ?" )
+			.arg( d->m_sourcesLogPartitions.value( before.date() ) ) );
+
+		eraseQuery.addBindValue( sourcesLogDateTimeToString( before ) );
+
+		eraseQuery.exec();
+	}
+
+	if( d->m_hasLegacySourcesLog )
+	{
+		QSqlQuery eraseQuery;
+		eraseQuery.prepare( QString( "DELETE FROM %1 WHERE dateTime < ?" )
+			.arg( sourcesLogLegacyTable ) );
+
+		eraseQuery.addBindValue( sourcesLogDateTimeToString( before ) );
+
+		eraseQuery.exec();
+
+		QSqlQuery countQuery;
+
+		if( countQuery.exec( QString( "SELECT 1 FROM %1 LIMIT 1" )
+			.arg( sourcesLogLegacyTable ) ) && !countQuery.next() )
+		{
+			countQuery.finish();
+
+			d->dropLegacySourcesLog();
+		}
+	}
+
+	return done;
+}
+
+void
+SqliteSourcesLogBackend::clear()
+{
+	d->dropSourcesLogPartitions( QDate( 9999, 12, 31 ) );
+
+	if( d->m_hasLegacySourcesLog )
+		d->dropLegacySourcesLog();
+}
+
+} /* namespace Globe */
@@ -0,0 +1,71 @@
+
+/*
+	SPDX-FileCopyrightText: 2012-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#ifndef GLOBE__SOURCES_LOG_SQLITE_BACKEND_HPP__INCLUDED
+#define GLOBE__SOURCES_LOG_SQLITE_BACKEND_HPP__INCLUDED
+
+// Qt include.
+#include <QScopedPointer>
+
+// Globe include.
+#include <Core/sources_log_backend.hpp>
+
+
+namespace Globe {
+
+//
+// SqliteSourcesLogBackend
+//
+
+class SqliteSourcesLogBackendPrivate;
+
+/*!
+	Source's log in the SQLite DB.
+
+	Records are stored in the tables partitioned by days, so erasing of
+	outdated records is dropping of the whole tables, and selects read
+	only partitions in the given period of time. View "sourcesLog"
+	unions all partitions for the external readers.
+*/
+class SqliteSourcesLogBackend
+	:	public SourcesLogBackend
+{
+public:
+	SqliteSourcesLogBackend();
+
+	~SqliteSourcesLogBackend();
+
+	void init() override;
+
+	void write( const QDateTime & dateTime,
+		const QString & channelName,
+		Como::Source::Type type,
+		const QString & sourceName,
+		const QString & typeName,
+		const QString & value,
+		const QString & desc ) override;
+
+	void flush() override;
+
+	SourcesLogCursor select( const QDateTime & from,
+		const QDateTime & to,
+		const QString & channelName,
+		const QString & sourceName,
+		const QString & typeName ) override;
+
+	bool erase( const QDateTime & before, bool wholeDaysOnly ) override;
+
+	void clear() override;
+
+private:
+	Q_DISABLE_COPY( SqliteSourcesLogBackend )
+
+	QScopedPointer< SqliteSourcesLogBackendPrivate > d;
+}; // class SqliteSourcesLogBackend
+
+} /* namespace Globe */
+
+#endif // GLOBE__SOURCES_LOG_SQLITE_BACKEND_HPP__INCLUDED
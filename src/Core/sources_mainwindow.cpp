@@ -13,6 +13,7 @@
 #include <Core/sources_mainwindow_cfg.hpp>
 #include <Core/log.hpp>
 #include <Core/globe_menu.hpp>
+#include <Core/hidden_window_watcher.hpp>
 
 // Qt include.
 #include <QCloseEvent>
@@ -125,6 +126,9 @@ SourcesMainWindow::init()
 	d->m_widget = new SourcesWidget( this );
 
 	setCentralWidget( d->m_widget );
+
+	connect( new HiddenWindowWatcher( this ), &HiddenWindowWatcher::hiddenChanged,
+		d->m_widget, &SourcesWidget::setPaused );
 }
 
 void
@@ -28,6 +28,8 @@ public:
 	SourcesWidgetPrivate()
 		:	m_model( 0 )
 		,	m_sortModel( 0 )
+		,	m_paused( false )
+		,	m_dirty( false )
 	{
 	}
 
@@ -37,6 +39,10 @@ public:
 	SourcesModel * m_model;
 	//! Sort model.
 	QSortFilterProxyModel * m_sortModel;
+	//! Are updates paused?
+	bool m_paused;
+	//! Did new sources appear while updates were paused?
+	bool m_dirty;
 }; // class SourcesWidgetPrivate
 
 
@@ -112,7 +118,29 @@ SourcesWidget::newSource( const Como::Source & source,
 	const QString & channelName )
 {
 	if( d->m_ui.m_channel->currentText() == channelName )
-		d->m_model->addItem( source );
+	{
+		if( d->m_paused )
+			d->m_dirty = true;
+		else
+			d->m_model->addItem( source );
+	}
+}
+
+void
+SourcesWidget::setPaused( bool on )
+{
+	d->m_paused = on;
+
+	if( !on && d->m_dirty )
+	{
+		d->m_dirty = false;
+
+		const auto channelName = d->m_ui.m_channel->currentText();
+
+		if( !channelName.isEmpty() )
+			d->m_model->initModel(
+				SourcesManager::instance().sources( channelName ) );
+	}
 }
 
 void
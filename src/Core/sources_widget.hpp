@@ -51,6 +51,10 @@ public:
 	//! Set channel name.
 	void setChannelName( const QString & channelName );
 
+	//! Pause updates while widget isn't visible, on resume sources of
+	//! the current channel are read again if new ones appeared.
+	void setPaused( bool on = true );
+
 private:
 	//! Init.
 	void init();
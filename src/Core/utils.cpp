@@ -52,6 +52,16 @@ void checkPathAndCreateIfNotExists( const QString & path )
 }
 
 
+//
+// isWindowHidden
+//
+
+bool isWindowHidden( const QWidget * window )
+{
+	return ( window->isMinimized() || !window->isVisible() );
+}
+
+
 //
 // comoSourceTypeToString
 //
@@ -10,6 +10,10 @@
 // Qt include.
 #include <QString>
 
+QT_BEGIN_NAMESPACE
+class QWidget;
+QT_END_NAMESPACE
+
 // Como include.
 #include <Como/Source>
 
@@ -45,6 +49,14 @@ void CORE_EXPORT checkDirAndCreateIfNotExists( const QString & path,
 void checkPathAndCreateIfNotExists( const QString & path );
 
 
+//
+// isWindowHidden
+//
+
+//! \return Is window hidden or minimized?
+bool CORE_EXPORT isWindowHidden( const QWidget * window );
+
+
 //
 // Como source type string representation constants.
 //
@@ -10,6 +10,7 @@
 #include <QSqlQuery>
 #include <QSqlDatabase>
 #include <QFileInfo>
+#include <QUrl>
 #include <QVariant>
 #include <QCoreApplication>
 
@@ -17,9 +18,18 @@
 #include <LogViewer/log.hpp>
 #include <LogViewer/configuration.hpp>
 
+// Globe include.
+#include <Core/log_event_search.hpp>
+
 
 namespace LogViewer {
 
+//! Size of the memory mapped part of the DB file, in bytes.
+static const qint64 logMmapSize = Q_INT64_C( 1024 ) * 1024 * 1024;
+
+//! Time to wait for locked DB, in msecs.
+static const int logBusyTimeout = 5000;
+
 
 //
 // LogPrivate
@@ -28,6 +38,7 @@ namespace LogViewer {
 class LogPrivate {
 public:
 	LogPrivate()
+		:	m_hasSearchIndex( false )
 	{
 	}
 
@@ -37,6 +48,8 @@ public:
 
 	//! Connection.
 	QSqlDatabase m_connection;
+	//! Is there full-text index of the event's log?
+	bool m_hasSearchIndex;
 }; // class LogPrivate
 
 
@@ -69,8 +82,26 @@ Log::init()
 		return;
 	}
 
+	// Log viewer never writes, so the DB is opened read-only and
+	// never takes write locks. Globe keeps its DB in WAL mode, so
+	// readers and the writer don't block each other. DB that can't be
+	// written by anybody, an archived copy for example, is opened as
+	// immutable, so SQLite doesn't lock it at all.
+	QString options = QString( "QSQLITE_OPEN_READONLY;QSQLITE_BUSY_TIMEOUT=%1" )
+		.arg( logBusyTimeout );
+
+	QString dbName = info.absoluteFilePath();
+
+	if( !info.isWritable() )
+	{
+		options.append( QLatin1String( ";QSQLITE_OPEN_URI" ) );
+		dbName = QUrl::fromLocalFile( dbName ).toString( QUrl::FullyEncoded ) +
+			QLatin1String( "?immutable=1" );
+	}
+
 	d->m_connection = QSqlDatabase::addDatabase( "QSQLITE" );
-	d->m_connection.setDatabaseName( Configuration::instance().dbFileName() );
+	d->m_connection.setConnectOptions( options );
+	d->m_connection.setDatabaseName( dbName );
 
 	if( !d->m_connection.open() )
 	{
@@ -79,7 +110,16 @@ Log::init()
 		emit error();
 	}
 	else
+	{
+		QSqlQuery pragma( d->m_connection );
+		pragma.exec( QString( "PRAGMA mmap_size = %1" ).arg( logMmapSize ) );
+		pragma.exec( QLatin1String( "PRAGMA query_only = 1" ) );
+
+		// Index is created by Globe, log viewer doesn't write.
+		d->m_hasSearchIndex = Globe::hasEventLogSearchIndex();
+
 		emit ready();
+	}
 }
 
 static Log * logInstancePointer = 0;
@@ -114,7 +154,9 @@ Log::dateTimeToString( const QDateTime & dt )
 QSqlQuery
 Log::readAllEventLog()
 {
-	QSqlQuery select( QLatin1String(
+	QSqlQuery select;
+	select.setForwardOnly( true );
+	select.prepare( QLatin1String(
 		"SELECT * FROM eventLog ORDER BY dateTime" ) );
 
 	select.exec();
@@ -126,7 +168,9 @@ QSqlQuery
 Log::readEventLog( const QDateTime & from,
 	const QDateTime & to )
 {
-	QSqlQuery select( QLatin1String(
+	QSqlQuery select;
+	select.setForwardOnly( true );
+	select.prepare( QLatin1String(
 		"SELECT * FROM eventLog WHERE dateTime BETWEEN "
 		"? AND ? ORDER BY dateTime" ) );
 
@@ -138,4 +182,14 @@ Log::readEventLog( const QDateTime & from,
 	return select;
 }
 
+QSqlQuery
+Log::searchEventLog( const QDateTime & from,
+	const QDateTime & to,
+	const QString & text,
+	Globe::LogLevel minLevel )
+{
+	return Globe::searchEventLog( from, to, text, minLevel,
+		d->m_hasSearchIndex );
+}
+
 } /* namespace LogViewer */
@@ -12,6 +12,9 @@
 #include <QScopedPointer>
 #include <QSqlQuery>
 
+// Globe include.
+#include <Core/log.hpp>
+
 
 QT_BEGIN_NAMESPACE
 class QDateTime;
@@ -50,6 +53,12 @@ public:
 	//! Read event's log for the given period of time.
 	QSqlQuery readEventLog( const QDateTime & from,
 		const QDateTime & to );
+	//! Search in the event's log for the given period of time.
+	//! Records with the \a text are ordered by relevance.
+	QSqlQuery searchEventLog( const QDateTime & from,
+		const QDateTime & to,
+		const QString & text,
+		Globe::LogLevel minLevel = Globe::LogLevelInfo );
 
 	//! Initialize.
 	void init();
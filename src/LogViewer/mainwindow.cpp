@@ -21,6 +21,7 @@
 #include <QHBoxLayout>
 #include <QWidget>
 #include <QSqlQuery>
+#include <QScrollBar>
 #include <QApplication>
 
 // cfgfile include.
@@ -38,10 +39,6 @@ public:
 	MainWindowPrivate()
 		:	m_selector( 0 )
 		,	m_view( 0 )
-		,	m_logPageSize( 30 )
-		,	m_havePrevLogPage( false )
-		,	m_haveNextLogPage( false )
-		,	m_pos( 0 )
 	{
 	}
 
@@ -49,16 +46,6 @@ public:
 	Globe::LogEventSelector * m_selector;
 	//! View.
 	Globe::LogEventView * m_view;
-	//! Query.
-	QSqlQuery m_query;
-	//! Size of the log page.
-	int m_logPageSize;
-	//! Have previous log page.
-	bool m_havePrevLogPage;
-	//! Have next log page.
-	bool m_haveNextLogPage;
-	//! Position in query.
-	int m_pos;
 }; // class MainWindowPrivate
 
 
@@ -111,10 +98,10 @@ MainWindow::init()
 
 	d->m_selector = new Globe::LogEventSelector( centralWidget );
 
-	setNavigationButtons();
-
 	d->m_view = new Globe::LogEventView( centralWidget );
 
+	setNavigationButtons();
+
 	layout->addWidget( d->m_selector );
 	layout->addWidget( d->m_view );
 
@@ -147,67 +134,10 @@ MainWindow::init()
 void
 MainWindow::setNavigationButtons()
 {
-	if( d->m_havePrevLogPage )
-		d->m_selector->navigationWidget()->enablePreviousButtons( true );
-	else
-		d->m_selector->navigationWidget()->enablePreviousButtons( false );
-
-	if( d->m_haveNextLogPage )
-		d->m_selector->navigationWidget()->enableNextButtons( true );
-	else
-		d->m_selector->navigationWidget()->enableNextButtons( false );
-}
-
-QList< Globe::LogEventRecord >
-MainWindow::readLog()
-{
-	QList< Globe::LogEventRecord > records;
-
-	int size = 0;
+	const bool hasRows = ( d->m_view->model()->rowCount() > 0 );
 
-	do
-	{
-		Globe::LogEventRecord record(
-			(Globe::LogLevel) d->m_query.value( 0 ).toInt(),
-			d->m_query.value( 1 ).toString(),
-			d->m_query.value( 2 ).toString() );
-
-		records.append( record );
-
-		++size;
-		++d->m_pos;
-
-		if( size == d->m_logPageSize )
-			break;
-	} while( d->m_query.next() );
-
-	return records;
-}
-
-QList< Globe::LogEventRecord >
-MainWindow::readLogFirstTime()
-{
-	QList< Globe::LogEventRecord > records;
-
-	int size = 0;
-
-	while( d->m_query.next() )
-	{
-		Globe::LogEventRecord record(
-			(Globe::LogLevel) d->m_query.value( 0 ).toInt(),
-			d->m_query.value( 1 ).toString(),
-			d->m_query.value( 2 ).toString() );
-
-		records.append( record );
-
-		++size;
-		++d->m_pos;
-
-		if( size == d->m_logPageSize )
-			break;
-	}
-
-	return records;
+	d->m_selector->navigationWidget()->enablePreviousButtons( hasRows );
+	d->m_selector->navigationWidget()->enableNextButtons( hasRows );
 }
 
 void
@@ -246,124 +176,58 @@ MainWindow::logReady()
 void
 MainWindow::selectFromLog()
 {
-	d->m_pos = 0;
-	d->m_haveNextLogPage = false;
-	d->m_havePrevLogPage = false;
-
-	d->m_query = Log::instance().readEventLog( d->m_selector->startDateTime(),
-		d->m_selector->endDateTime() );
-
-	QList< Globe::LogEventRecord > records = readLogFirstTime();
-
-	if( d->m_query.next() )
-		d->m_haveNextLogPage = true;
-	else
-		d->m_haveNextLogPage = false;
+	const QDateTime start = d->m_selector->startDateTime();
+	const QDateTime to = d->m_selector->endDateTime();
+	const QString text = d->m_selector->searchText();
+	const Globe::LogLevel minLevel = d->m_selector->minLevel();
+
+	// Found records are ranked, so blocks of them are read again
+	// from the start.
+	d->m_view->model()->initModel( start,
+		[=]( const QDateTime & from )
+			{
+				return Log::instance().searchEventLog(
+					( from.isValid() ? from : start ), to, text, minLevel );
+			},
+		!text.isEmpty() );
 
 	setNavigationButtons();
 
-	d->m_view->model()->initModel( records );
-
 	d->m_view->resizeColumnToContents( 0 );
 }
 
 void
 MainWindow::nextLogPage()
 {
-	d->m_havePrevLogPage = true;
-
-	QList< Globe::LogEventRecord > records;
-
-	if( d->m_query.seek( d->m_pos ) )
-	{
-		records = readLog();
-
-		if( d->m_query.next() )
-			d->m_haveNextLogPage = true;
-		else
-		{
-			d->m_haveNextLogPage = false;
-			d->m_pos += ( d->m_logPageSize - ( d->m_pos % d->m_logPageSize ) );
-		}
-	}
-	else
-		d->m_haveNextLogPage = false;
-
-	setNavigationButtons();
-
-	d->m_view->model()->initModel( records );
+	d->m_view->verticalScrollBar()->triggerAction(
+		QAbstractSlider::SliderPageStepAdd );
 }
 
 void
 MainWindow::prevLogPage()
 {
-	d->m_haveNextLogPage = true;
-
-	QList< Globe::LogEventRecord > records;
-
-	d->m_pos -= ( d->m_logPageSize * 2 );
-
-	if( !d->m_pos )
-		d->m_havePrevLogPage = false;
-
-	if( d->m_query.seek( d->m_pos ) )
-	{
-		if( d->m_query.previous() )
-			d->m_havePrevLogPage = true;
-		else
-			d->m_havePrevLogPage = false;
-
-		d->m_query.next();
-
-		records = readLog();
-	}
-	else
-		d->m_haveNextLogPage = false;
-
-	setNavigationButtons();
-
-	d->m_view->model()->initModel( records );
+	d->m_view->verticalScrollBar()->triggerAction(
+		QAbstractSlider::SliderPageStepSub );
 }
 
 void
 MainWindow::goToFirstLogPage()
 {
-	d->m_pos = 0;
-	d->m_haveNextLogPage = true;
-	d->m_havePrevLogPage = false;
-
-	QList< Globe::LogEventRecord > records;
-
-	d->m_query.seek( d->m_pos );
-
-	records = readLog();
-
-	setNavigationButtons();
-
-	d->m_view->model()->initModel( records );
+	d->m_view->scrollToTop();
 }
 
 void
 MainWindow::goToLastLogPage()
 {
-	d->m_haveNextLogPage = false;
-	d->m_havePrevLogPage = true;
-
-	do {
-		d->m_pos += d->m_logPageSize;
-	} while( d->m_query.seek( d->m_pos ) );
-
-	d->m_pos -= d->m_logPageSize;
+	QApplication::setOverrideCursor( Qt::WaitCursor );
 
-	d->m_query.seek( d->m_pos );
+	// Only the last blocks stay in memory.
+	while( d->m_view->model()->canFetchMore( QModelIndex() ) )
+		d->m_view->model()->fetchMore( QModelIndex() );
 
-	QList< Globe::LogEventRecord > records = readLog();
-
-	d->m_pos += ( d->m_logPageSize - ( d->m_pos % d->m_logPageSize ) );
-
-	setNavigationButtons();
+	QApplication::restoreOverrideCursor();
 
-	d->m_view->model()->initModel( records );
+	d->m_view->scrollToBottom();
 }
 
 } /* namespace LogViewer */
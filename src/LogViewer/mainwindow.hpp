@@ -45,10 +45,6 @@ private:
 	void init();
 	//! Set navigation buttons.
 	void setNavigationButtons();
-	//! \return List with log records.
-	QList< Globe::LogEventRecord > readLog();
-	//! \return List with log records.
-	QList< Globe::LogEventRecord > readLogFirstTime();
 
 public slots:
 	//! Start application.
@@ -24,6 +24,9 @@
 #include <QIcon>
 #include <QGraphicsSceneContextMenuEvent>
 #include <QMap>
+#include <QHash>
+#include <QSet>
+#include <QVector>
 #include <QGraphicsSceneMouseEvent>
 #include <QGraphicsView>
 
@@ -41,8 +44,10 @@ namespace /* anonymous */ {
 //! Key of the source.
 class Key {
 public:
-	Key( const QString & name, const QString & type )
-		:	m_key( type + QLatin1String( "::" ) + name )
+	Key( const Como::Source & source, const QString & channel )
+		:	m_channel( channel )
+		,	m_type( source.typeName() )
+		,	m_name( source.name() )
 	{
 	}
 
@@ -50,14 +55,25 @@ public:
 	{
 	}
 
-	friend bool operator < ( const Key & k1, const Key & k2 )
+	friend bool operator == ( const Key & k1, const Key & k2 )
 	{
-		return ( k1.m_key < k2.m_key );
+		return ( k1.m_channel == k2.m_channel &&
+			k1.m_type == k2.m_type &&
+			k1.m_name == k2.m_name );
+	}
+
+	friend size_t qHash( const Key & key, size_t seed = 0 )
+	{
+		return qHashMulti( seed, key.m_channel, key.m_type, key.m_name );
 	}
 
 private:
-	//! Key.
-	QString m_key;
+	//! Channel.
+	QString m_channel;
+	//! Type name.
+	QString m_type;
+	//! Name.
+	QString m_name;
 }; // class Key
 
 
@@ -82,6 +98,82 @@ struct SourceProps {
 	bool m_connected;
 }; // struct SourceProps
 
+
+//
+// Member
+//
+
+//! Source in the aggregate. Each source is kept once, even if it's
+//! in several nested aggregates.
+struct Member {
+	//! Channel.
+	QString m_channel;
+	//! Source.
+	Como::Source m_source;
+	//! Properties.
+	SourceProps m_props;
+	//! Nodes with this source.
+	QList< int > m_nodes;
+}; // struct Member
+
+
+//
+// Node
+//
+
+/*!
+	Node of the tree of nested aggregates.
+
+	Entries of the node are its own sources and child nodes. Entry of
+	the source is the index of the member, entry of the child node is
+	-( index of the node + 1 ). Child nodes propagate to the parent only
+	their computed level and count of disconnected sources.
+*/
+struct Node {
+	Node()
+		:	m_parent( -1 )
+		,	m_count( 0 )
+		,	m_disconnected( 0 )
+	{
+	}
+
+	//! \return Level of the node, -1 if there is no registered and
+	//! connected sources.
+	int level() const
+	{
+		return ( m_levels.isEmpty() ? -1 : m_levels.firstKey() );
+	}
+
+	//! Parent node.
+	int m_parent;
+	//! Entries by level, the first level is the worst one.
+	QMap< int, QSet< int > > m_levels;
+	//! Count of sources in the subtree.
+	int m_count;
+	//! Count of disconnected sources in the subtree.
+	int m_disconnected;
+}; // struct Node
+
+//! \return Entry of the child node.
+static inline int nodeEntry( int node )
+{
+	return -( node + 1 );
+}
+
+//! \return Node of the entry.
+static inline int entryNode( int entry )
+{
+	return -entry - 1;
+}
+
+//! \return Level of the source in the node, -1 if source doesn't
+//! take part in the level.
+static inline int levelOf( const SourceProps & props )
+{
+	return ( props.m_registered && props.m_connected &&
+		props.m_level < Uninitialized ? props.m_level : -1 );
+}
+
 } /* namespace anonymous */
 
 
@@ -98,6 +190,9 @@ public:
 		:	SelectablePrivate( selection, scene )
 		,	m_fillColor( ColorForLevel::instance().disconnectedColor() )
 		,	m_level( Uninitialized )
+		,	m_status( ItemDisconnected )
+		,	m_currentIndex( -1 )
+		,	m_hasToolTip( false )
 		,	q( parent )
 	{
 	}
@@ -106,21 +201,43 @@ public:
 	{
 	}
 
+	//! Clear sources.
+	void clearSources();
+	//! Add node for the given configuration with nested aggregates.
+	int addNode( const SchemeCfg & cfg, int parent );
+	//! Add source to the node.
+	void addSource( const Como::Source & source, const QString & channel,
+		int node );
+	//! Set state of the source with the given index.
+	void setState( int index, bool registered, bool connected, Level level );
+	//! Entry of the node changed, propagate it up to the root.
+	void entryChanged( int node, int entry, int oldLevel, int newLevel,
+		int disconnectedDelta );
+	//! \return Member with the worst level in the node.
+	int worstMember( int node ) const;
 	//! Calculate current value.
 	void calcCurrentValue();
 
 	//! Sources.
-	QMap< QString, QMap< Key, QPair< Como::Source, SourceProps > > > m_sources;
+	QVector< Member > m_members;
+	//! Indexes of the sources.
+	QHash< Key, int > m_index;
+	//! Indexes of the sources by channel.
+	QHash< QString, QList< int > > m_channelMembers;
+	//! Tree of nested aggregates, the first node is the root.
+	QVector< Node > m_nodes;
+	//! Index of the current source.
+	int m_currentIndex;
+	//! Should tool tip with the current source be shown?
+	bool m_hasToolTip;
 	//! Configuration.
 	SchemeCfg m_cfg;
 	//! Current color.
 	QColor m_fillColor;
 	//! Level.
 	Level m_level;
-	//! Current source.
-	Como::Source m_current;
-	//! Current channel.
-	QString m_channel;
+	//! Status.
+	ItemStatus m_status;
 	//! Channels.
 	QStringList m_channels;
 	//! Parent.
@@ -128,68 +245,208 @@ public:
 }; // class AggregatePrivate;
 
 void
-AggregatePrivate::calcCurrentValue()
+AggregatePrivate::clearSources()
+{
+	m_members.clear();
+	m_index.clear();
+	m_channelMembers.clear();
+	m_nodes.clear();
+	m_currentIndex = -1;
+	m_level = Uninitialized;
+}
+
+int
+AggregatePrivate::addNode( const SchemeCfg & cfg, int parent )
 {
-	Level level = Uninitialized;
+	const int node = m_nodes.size();
 
-	bool found = false;
+	m_nodes.append( Node() );
+	m_nodes[ node ].m_parent = parent;
 
-	m_fillColor = ColorForLevel::instance().color( None );
+	for( const auto & s : std::as_const( cfg.sources() ) )
+		addSource( Como::Source( s.type(), s.sourceName(), s.typeName(),
+			QVariant(), QString() ), s.channelName(), node );
 
-	QMapIterator< QString,
-		QMap< Key, QPair< Como::Source, SourceProps > > >
-			it( m_sources );
+	for( const auto & a : std::as_const( cfg.aggregates() ) )
+	{
+		const int child = addNode( a, node );
 
-	bool connected = false;
-	bool disconnected = false;
+		m_nodes[ node ].m_count += m_nodes.at( child ).m_count;
+		m_nodes[ node ].m_disconnected += m_nodes.at( child ).m_disconnected;
+	}
 
-	while( it.hasNext() )
+	return node;
+}
+
+void
+AggregatePrivate::addSource( const Como::Source & source,
+	const QString & channel, int node )
+{
+	const Key key( source, channel );
+
+	auto it = m_index.constFind( key );
+
+	int index = -1;
+
+	if( it == m_index.cend() )
 	{
-		it.next();
+		index = m_members.size();
 
-		for( const auto & s : std::as_const( it.value() ) )
-		{
-			if( s.second.m_connected )
-				connected = true;
-			else
-				disconnected = true;
-
-			if( s.second.m_registered &&
-				s.second.m_connected &&
-				s.second.m_level < level )
-			{
-				level = s.second.m_level;
+		m_members.append( { channel, source, SourceProps(), {} } );
+		m_index.insert( key, index );
+		m_channelMembers[ channel ].append( index );
+	}
+	else
+		index = it.value();
+
+	if( m_members.at( index ).m_nodes.contains( node ) )
+		return;
 
-				m_channel = it.key();
+	m_members[ index ].m_nodes.append( node );
 
-				m_current = s.first;
+	// New source is disconnected till synchronized.
+	++m_nodes[ node ].m_count;
+	++m_nodes[ node ].m_disconnected;
+}
+
+void
+AggregatePrivate::setState( int index, bool registered, bool connected,
+	Level level )
+{
+	SourceProps & props = m_members[ index ].m_props;
+
+	const int oldLevel = levelOf( props );
 
-				m_fillColor =
-					ColorForLevel::instance().color( level );
+	int disconnectedDelta = 0;
 
-				m_level = level;
+	if( props.m_connected != connected )
+		disconnectedDelta = ( connected ? -1 : 1 );
 
-				found = true;
+	props.m_registered = registered;
+	props.m_connected = connected;
+	props.m_level = level;
+
+	const int newLevel = levelOf( props );
+
+	if( oldLevel == newLevel && disconnectedDelta == 0 )
+		return;
+
+	for( const int node : std::as_const( m_members.at( index ).m_nodes ) )
+		entryChanged( node, index, oldLevel, newLevel, disconnectedDelta );
+}
+
+void
+AggregatePrivate::entryChanged( int node, int entry, int oldLevel,
+	int newLevel, int disconnectedDelta )
+{
+	// Only the path from the node to the root is touched.
+	while( node != -1 )
+	{
+		Node & n = m_nodes[ node ];
+
+		const int oldNodeLevel = n.level();
+
+		if( oldLevel != newLevel )
+		{
+			if( oldLevel != -1 )
+			{
+				auto it = n.m_levels.find( oldLevel );
+
+				it.value().remove( entry );
+
+				if( it.value().isEmpty() )
+					n.m_levels.erase( it );
 			}
+
+			if( newLevel != -1 )
+				n.m_levels[ newLevel ].insert( entry );
 		}
+
+		n.m_disconnected += disconnectedDelta;
+
+		const int newNodeLevel = n.level();
+
+		if( oldNodeLevel == newNodeLevel && disconnectedDelta == 0 )
+			break;
+
+		entry = nodeEntry( node );
+		oldLevel = oldNodeLevel;
+		newLevel = newNodeLevel;
+		node = n.m_parent;
+	}
+}
+
+int
+AggregatePrivate::worstMember( int node ) const
+{
+	for( ; ; )
+	{
+		const Node & n = m_nodes.at( node );
+
+		if( n.m_levels.isEmpty() )
+			return -1;
+
+		const int entry = *n.m_levels.first().cbegin();
+
+		if( entry >= 0 )
+			return entry;
+
+		node = entryNode( entry );
+	}
+}
+
+void
+AggregatePrivate::calcCurrentValue()
+{
+	static const Node empty;
+
+	const Node & root = ( m_nodes.isEmpty() ? empty : m_nodes.constFirst() );
+	const bool found = !root.m_levels.isEmpty();
+	const bool disconnected = ( root.m_disconnected > 0 );
+	const bool connected = ( root.m_count > root.m_disconnected );
+	const QColor oldColor = m_fillColor;
+
+	m_fillColor = ColorForLevel::instance().color( None );
+
+	if( found )
+	{
+		m_level = static_cast< Level > ( root.level() );
+
+		// Current source stays current while it's one of the worst.
+		if( m_currentIndex == -1 ||
+			levelOf( m_members.at( m_currentIndex ).m_props ) != m_level )
+				m_currentIndex = worstMember( 0 );
+
+		m_fillColor = ColorForLevel::instance().color( m_level );
+	}
+	else
+	{
+		m_currentIndex = -1;
+		m_level = Uninitialized;
 	}
 
+	m_status = ItemRegistered;
+
 	if( !disconnected && found )
-		q->setToolTip( createToolTip( m_channel, m_current ) );
+		m_hasToolTip = true;
 	else if( disconnected )
 	{
 		m_fillColor = ColorForLevel::instance().disconnectedColor();
+		m_status = ItemDisconnected;
 
-		q->setToolTip( QString() );
+		m_hasToolTip = false;
 	}
 	else if( connected )
 	{
 		m_fillColor = ColorForLevel::instance().deregisteredColor();
+		m_status = ItemDeregistered;
 
-		q->setToolTip( QString() );
+		m_hasToolTip = false;
 	}
 
-	q->update();
+	// Aggregate shows only color.
+	if( m_fillColor != oldColor )
+		m_scene->scheduleUpdate( q );
 }
 
 
@@ -237,20 +494,14 @@ Aggregate::setCfg( const SchemeCfg & cfg )
 
 	dd->m_channels.clear();
 
-	dd->m_sources.clear();
+	dd->clearSources();
 
-	const auto s = sources();
+	dd->addNode( cfg, -1 );
 
-	for( const auto & p : s )
+	for( const auto & m : std::as_const( dd->m_members ) )
 	{
-		if( !dd->m_channels.contains( p.second ) )
-			dd->m_channels.append( p.second );
-
-		const Key key( p.first.name(), p.first.typeName() );
-
-		if( !dd->m_sources[ p.second ].contains( key ) )
-			dd->m_sources[ p.second ].insert( key,
-				qMakePair( p.first, SourceProps() ) );
+		if( !dd->m_channels.contains( m.m_channel ) )
+			dd->m_channels.append( m.m_channel );
 	}
 
 	setPos( cfg.pos() );
@@ -279,16 +530,13 @@ Aggregate::syncSource( const Como::Source & source,
 {
 	auto * dd = d_ptr();
 
-	const Key key( source.name(), source.typeName() );
+	const auto it = dd->m_index.constFind( Key( source, channel ) );
 
-	if( dd->m_sources.contains( channel ) &&
-		dd->m_sources[ channel ].contains( key ) )
+	if( it != dd->m_index.cend() )
 	{
-		dd->m_sources[ channel ][ key ].first = source;
-
-		dd->m_sources[ channel ][ key ].second.m_registered = isRegistered;
+		const int index = it.value();
 
-		dd->m_sources[ channel ][ key ].second.m_connected = true;
+		dd->m_members[ index ].m_source = source;
 
 		const Properties * props = PropertiesManager::instance()
 			.findProperties( source, channel, 0 );
@@ -301,34 +549,28 @@ Aggregate::syncSource( const Como::Source & source,
 				source.type() ).level();
 		}
 
-		dd->m_sources[ channel ][ key ].second.m_level = level;
-
-		if( isRegistered && level < dd->m_level )
-		{
-			dd->m_current = source;
-
-			dd->m_channel = channel;
+		dd->setState( index, isRegistered, true, level );
 
-			dd->m_level = level;
-
-			dd->m_fillColor = ColorForLevel::instance().color( level );
+		dd->calcCurrentValue();
+	}
+}
 
-			setToolTip( createToolTip( dd->m_channel, dd->m_current ) );
+QString
+Aggregate::toolTipText() const
+{
+	auto * dd = d_ptr();
 
-			update();
-		}
-		else if( source == dd->m_current )
-			dd->calcCurrentValue();
-		else if( dd->m_level == Uninitialized )
-			dd->calcCurrentValue();
-	}
+	if( dd->m_hasToolTip && dd->m_currentIndex != -1 )
+		return createToolTip( dd->m_members.at( dd->m_currentIndex ).m_channel,
+			dd->m_members.at( dd->m_currentIndex ).m_source );
+	else
+		return QString();
 }
 
 void
 Aggregate::paint( QPainter * painter, const QStyleOptionGraphicsItem * option,
 	QWidget * widget )
 {
-	Q_UNUSED( option )
 	Q_UNUSED( widget )
 
 	auto * dd = d_ptr();
@@ -342,7 +584,7 @@ Aggregate::paint( QPainter * painter, const QStyleOptionGraphicsItem * option,
 
 	painter->drawRect( boundingRect() );
 
-	if( dd->m_state == ItemSelected )
+	if( dd->m_state == ItemSelected && isDetailVisible( option, painter ) )
 	{
 		painter->setBrush( Qt::blue );
 		painter->drawRect( 0, 0, 3, 3 );
@@ -364,18 +606,13 @@ Aggregate::channelDisconnected( const QString & name )
 {
 	auto * dd = d_ptr();
 
-	if( dd->m_sources.contains( name ) )
-	{
-		QMutableMapIterator< Key, QPair< Como::Source, SourceProps > > it(
-			dd->m_sources[ name ] );
-
-		while( it.hasNext() )
-		{
-			it.next();
+	const auto it = dd->m_channelMembers.constFind( name );
 
-			it.value().second.m_connected = false;
-			it.value().second.m_registered = false;
-		}
+	if( it != dd->m_channelMembers.cend() )
+	{
+		for( const int index : it.value() )
+			dd->setState( index, false, false,
+				dd->m_members.at( index ).m_props.m_level );
 	}
 
 	dd->calcCurrentValue();
@@ -387,6 +624,18 @@ Aggregate::channelDeregistered( const QString & name )
 	channelDisconnected( name );
 }
 
+Level
+Aggregate::level() const
+{
+	return d_ptr()->m_level;
+}
+
+ItemStatus
+Aggregate::status() const
+{
+	return d_ptr()->m_status;
+}
+
 void
 Aggregate::contextMenuEvent( QGraphicsSceneContextMenuEvent * event )
 {
@@ -460,40 +709,39 @@ Aggregate::schemeChanged()
 
 	auto * dd = d_ptr();
 
+	dd->m_scene->aggregateChanged( this );
+
 	for( const auto & ch : std::as_const( listOfChannels() ) )
 		dd->m_scene->addChannel( ch );
 
-	QMutableMapIterator< QString,
-		QMap< Key, QPair< Como::Source, SourceProps > > >
-			it( dd->m_sources );
+	const SourcesSnapshot snapshot = SourcesManager::instance().snapshot(
+		listOfChannels() );
 
-	while( it.hasNext() )
+	for( int i = 0; i < dd->m_members.size(); ++i )
 	{
-		it.next();
+		Member & m = dd->m_members[ i ];
 
-		QMutableMapIterator< Key, QPair< Como::Source, SourceProps > > sit( it.value() );
+		bool registered = m.m_props.m_registered;
+		Level level = m.m_props.m_level;
+		bool connected = m.m_props.m_connected;
 
-		while( sit.hasNext() )
-		{
-			sit.next();
+		snapshot.syncSource( m.m_channel, m.m_source, registered );
 
-			SourcesManager::instance().syncSource( it.key(), sit.value().first,
-				sit.value().second.m_registered );
+		const Properties * props = PropertiesManager::instance()
+			.findProperties( m.m_source, m.m_channel, 0 );
 
-			const Properties * props = PropertiesManager::instance()
-				.findProperties( sit.value().first, it.key(), 0 );
+		if( props )
+		{
+			level = props->checkConditions( m.m_source.value(),
+				m.m_source.type() ).level();
+		}
 
-			if( props )
-			{
-				sit.value().second.m_level = props->checkConditions( sit.value().first.value(),
-					sit.value().first.type() ).level();
-			}
+		auto * ch = ChannelsManager::instance().channelByName( m.m_channel );
 
-			auto * ch = ChannelsManager::instance().channelByName( it.key() );
+		if( ch )
+			connected = ch->isConnected();
 
-			if( ch )
-				sit.value().second.m_connected = ch->isConnected();
-		}
+		dd->setState( i, registered, connected, level );
 	}
 
 	dd->calcCurrentValue();
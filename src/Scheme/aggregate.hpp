@@ -10,6 +10,7 @@
 // Globe include.
 #include <Scheme/base_item.hpp>
 #include <Scheme/scheme_cfg.hpp>
+#include <Core/condition.hpp>
 
 // Como include.
 #include <Como/Source>
@@ -62,6 +63,9 @@ public:
 	void syncSource( const Como::Source & source,
 		const QString & channel, bool isRegistered );
 
+	//! \return Tool tip.
+	QString toolTipText() const Q_DECL_OVERRIDE;
+
 	//! Paint item.
 	void paint( QPainter * painter, const QStyleOptionGraphicsItem * option,
 		QWidget * widget ) Q_DECL_OVERRIDE;
@@ -75,6 +79,11 @@ public:
 	//! Channel has been deregistered.
 	void channelDeregistered( const QString & name );
 
+	//! \return Worst level of the sources.
+	Level level() const;
+	//! \return Status of the aggregate.
+	ItemStatus status() const;
+
 protected:
 	void contextMenuEvent( QGraphicsSceneContextMenuEvent * event )
 		Q_DECL_OVERRIDE;
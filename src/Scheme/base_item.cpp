@@ -70,6 +70,12 @@ BaseItem::setItemState( ItemState st )
 	update();
 }
 
+QString
+BaseItem::toolTipText() const
+{
+	return toolTip();
+}
+
 void
 BaseItem::moveUp( int delta )
 {
@@ -66,6 +66,9 @@ public:
 	//! \return Bounding rectangle.
 	QRectF boundingRect() const Q_DECL_OVERRIDE;
 
+	//! \return Tool tip. Tool tips are built only when shown.
+	virtual QString toolTipText() const;
+
 protected:
 	void mouseMoveEvent( QGraphicsSceneMouseEvent * event ) Q_DECL_OVERRIDE;
 	void mousePressEvent( QGraphicsSceneMouseEvent * event ) Q_DECL_OVERRIDE;
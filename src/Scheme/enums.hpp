@@ -55,6 +55,21 @@ enum ItemState {
 }; // enum ItemState
 
 
+//
+// ItemStatus
+//
+
+//! Status of the source or aggregate on the scheme.
+enum ItemStatus {
+	//! Source is registered and channel is connected.
+	ItemRegistered = 0x00,
+	//! Source is deregistered.
+	ItemDeregistered = 0x01,
+	//! Channel is disconnected.
+	ItemDisconnected = 0x02
+}; // enum ItemStatus
+
+
 //
 // ResizeMode
 //
@@ -19,6 +19,7 @@
 #include <Core/channels.hpp>
 #include <Core/sources.hpp>
 #include <Core/properties_manager.hpp>
+#include <Core/sources_bus.hpp>
 
 // Qt include.
 #include <QWidget>
@@ -30,6 +31,18 @@
 #include <QKeyEvent>
 #include <QMap>
 #include <QList>
+#include <QHash>
+#include <QSet>
+#include <QTimer>
+#include <QToolTip>
+#include <QGraphicsSceneHelpEvent>
+#include <QThread>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTextStream>
+
+// C++ include.
+#include <memory>
 
 // cfgfile include.
 #include <cfgfile/all.hpp>
@@ -39,6 +52,37 @@ namespace Globe {
 
 namespace Scheme {
 
+//! Max count of repaints of the changed items per second.
+static const int maxRepaintsPerSecond = 25;
+
+//! Duration of one step of creation of the items of the loaded
+//! scheme in msecs.
+static const qint64 loadStepDuration = 8;
+
+
+//
+// SchemeLoadResult
+//
+
+//! Result of reading of the scheme on the worker thread.
+struct SchemeLoadResult {
+	SchemeLoadResult()
+		:	m_opened( false )
+		,	m_ok( false )
+	{
+	}
+
+	//! Configuration.
+	SchemeCfg m_cfg;
+	//! Was file opened?
+	bool m_opened;
+	//! Was scheme read?
+	bool m_ok;
+	//! Error.
+	QString m_error;
+}; // struct SchemeLoadResult
+
+
 //
 // DummyItem
 //
@@ -68,20 +112,14 @@ public:
 // Key
 //
 
-//! Key for sources map.
+//! Key for sources map and subscriptions.
 class Key {
 public:
 	Key( const Como::Source & source, const QString & channelName )
-		:	m_source( source )
-		,	m_channelName( channelName )
-		,	m_key( m_channelName + m_source.typeName() + m_source.name() )
-	{
-	}
-
-	//! \return Source.
-	const Como::Source & source() const
+		:	m_channelName( channelName )
+		,	m_typeName( source.typeName() )
+		,	m_name( source.name() )
 	{
-		return m_source;
 	}
 
 	//! \return Channel name.
@@ -90,38 +128,159 @@ public:
 		return m_channelName;
 	}
 
-	//! \return String key.
-	const QString & key() const
+	//! \return Type name.
+	const QString & typeName() const
 	{
-		return m_key;
+		return m_typeName;
+	}
+
+	//! \return Source name.
+	const QString & name() const
+	{
+		return m_name;
 	}
 
 	friend bool operator < ( const Key & k1, const Key & k2 )
 	{
-		return k1.key() < k2.key();
+		if( k1.m_channelName != k2.m_channelName )
+			return k1.m_channelName < k2.m_channelName;
+		else if( k1.m_typeName != k2.m_typeName )
+			return k1.m_typeName < k2.m_typeName;
+		else
+			return k1.m_name < k2.m_name;
+	}
+
+	friend bool operator == ( const Key & k1, const Key & k2 )
+	{
+		return ( k1.m_channelName == k2.m_channelName &&
+			k1.m_typeName == k2.m_typeName &&
+			k1.m_name == k2.m_name );
+	}
+
+	friend size_t qHash( const Key & key, size_t seed = 0 )
+	{
+		return qHashMulti( seed, key.m_channelName, key.m_typeName,
+			key.m_name );
 	}
 
 private:
-	//! Source.
-	Como::Source m_source;
 	//! Channel name.
 	QString m_channelName;
-	//! String key.
-	QString m_key;
+	//! Type name.
+	QString m_typeName;
+	//! Source name.
+	QString m_name;
 }; // class Key
 
 
+//
+// Subscribers
+//
+
+//! Items that show the source.
+struct Subscribers {
+	Subscribers()
+		:	m_source( 0 )
+	{
+	}
+
+	//! \return Is there no subscribers?
+	bool isEmpty() const
+	{
+		return ( !m_source && m_aggregates.isEmpty() );
+	}
+
+	//! Source item.
+	Source * m_source;
+	//! Aggregates with the source.
+	QList< Aggregate* > m_aggregates;
+}; // struct Subscribers
+
+
 //
 // ScenePrivate
 //
 
-class ScenePrivate {
+class ScenePrivate
+	:	public SourcesSubscriber
+{
 public:
 	ScenePrivate()
 		:	m_mode( ViewScene )
 		,	m_editMode( EditSceneSelect )
 		,	m_parentWidget( 0 )
+		,	m_repaintTimer( 0 )
+		,	m_loadTimer( 0 )
+		,	m_loadThread( 0 )
+		,	m_isLoading( false )
+		,	m_nextSource( 0 )
+		,	m_nextText( 0 )
+		,	m_nextAggregate( 0 )
+		,	m_headless( false )
+	{
+	}
+
+	~ScenePrivate()
+	{
+		SourcesBus::instance().unsubscribe( this );
+	}
+
+	//! Wait for the parsing thread and delete it.
+	void joinLoadThread()
+	{
+		if( m_loadThread )
+		{
+			m_loadThread->wait();
+
+			delete m_loadThread;
+
+			m_loadThread = 0;
+		}
+	}
+
+	//! Subscribed sources changed.
+	void sourcesChanged( const QString & channelName,
+		const QList< SourceChange > & changes ) override
 	{
+		if( m_mode != ViewScene )
+			return;
+
+		for( const auto & c : changes )
+		{
+			if( c.m_registered )
+				updateSource( c.m_source, channelName );
+			else
+				sourceDeregistered( c.m_source, channelName );
+		}
+	}
+
+	//! \return Subscribers of the source, subscribe to the source
+	//! on the bus if there were no subscribers.
+	Subscribers & subscribers( const Key & key )
+	{
+		auto it = m_subscriptions.find( key );
+
+		if( it == m_subscriptions.end() )
+		{
+			it = m_subscriptions.insert( key, Subscribers() );
+
+			SourcesBus::instance().subscribe( this, key.channelName(),
+				key.typeName(), key.name() );
+		}
+
+		return it.value();
+	}
+
+	//! Remove subscribers of the source if there is no one.
+	void removeIfEmpty( QHash< Key, Subscribers >::iterator it )
+	{
+		if( it.value().isEmpty() )
+		{
+			SourcesBus::instance().unsubscribe( this, it.key().channelName(),
+				it.key().typeName(), it.key().name() );
+
+			m_subscriptions.erase( it );
+		}
 	}
 
 	//! Notify all items about scene mode changes.
@@ -150,17 +309,77 @@ public:
 			a->setEditMode( mode );
 	}
 
+	//! Subscribe source item.
+	void subscribe( const Key & key, Source * item )
+	{
+		subscribers( key ).m_source = item;
+	}
+
+	//! Unsubscribe source item.
+	void unsubscribe( const Key & key )
+	{
+		auto it = m_subscriptions.find( key );
+
+		if( it != m_subscriptions.end() )
+		{
+			it.value().m_source = 0;
+
+			removeIfEmpty( it );
+		}
+	}
+
+	//! Subscribe aggregate to its sources.
+	void subscribe( Aggregate * agg )
+	{
+		unsubscribe( agg );
+
+		QList< Key > & keys = m_aggregateKeys[ agg ];
+
+		const auto sources = agg->sources();
+
+		for( const auto & p : sources )
+		{
+			const Key key( p.first, p.second );
+
+			if( !keys.contains( key ) )
+			{
+				keys.append( key );
+
+				subscribers( key ).m_aggregates.append( agg );
+			}
+		}
+	}
+
+	//! Unsubscribe aggregate.
+	void unsubscribe( Aggregate * agg )
+	{
+		const QList< Key > keys = m_aggregateKeys.take( agg );
+
+		for( const auto & key : keys )
+		{
+			auto it = m_subscriptions.find( key );
+
+			if( it != m_subscriptions.end() )
+			{
+				it.value().m_aggregates.removeOne( agg );
+
+				removeIfEmpty( it );
+			}
+		}
+	}
+
 	//! Source deregistered.
 	void sourceDeregistered( const Como::Source & s, const QString & channel )
 	{
-		const Key key( s, channel );
+		const auto it = m_subscriptions.constFind( Key( s, channel ) );
 
-		QMap< Key, Source* >::Iterator it = m_sources.find( key );
+		if( it == m_subscriptions.cend() )
+			return;
 
-		if( it != m_sources.end() )
-			it.value()->deregistered();
+		if( it.value().m_source )
+			it.value().m_source->deregistered();
 
-		for( Aggregate * a : std::as_const( m_agg ) )
+		for( Aggregate * a : it.value().m_aggregates )
 			a->syncSource( s, channel, false );
 	}
 
@@ -201,14 +420,15 @@ public:
 	//! Update source.
 	void updateSource( const Como::Source & s, const QString & channel )
 	{
-		const Key key( s, channel );
+		const auto it = m_subscriptions.constFind( Key( s, channel ) );
 
-		QMap< Key, Source* >::Iterator it = m_sources.find( key );
+		if( it == m_subscriptions.cend() )
+			return;
 
-		if( it != m_sources.end() )
-			it.value()->setSource( s );
+		if( it.value().m_source )
+			it.value().m_source->setSource( s );
 
-		for( Aggregate * a : std::as_const( m_agg ) )
+		for( Aggregate * a : it.value().m_aggregates )
 			a->syncSource( s, channel, true );
 	}
 
@@ -226,10 +446,40 @@ public:
 	QList< Text* > m_texts;
 	//! Aggregates.
 	QList< Aggregate* > m_agg;
+	//! Items subscribed to the sources. Updated when items added,
+	//! removed or aggregates changed, so updates of the sources touch
+	//! only items that show them.
+	QHash< Key, Subscribers > m_subscriptions;
+	//! Keys of the sources of the aggregates.
+	QHash< Aggregate*, QList< Key > > m_aggregateKeys;
+	//! Items to repaint.
+	QSet< QGraphicsItem* > m_dirtyItems;
+	//! Repaint timer.
+	QTimer * m_repaintTimer;
+	//! Timer of the steps of creation of the items.
+	QTimer * m_loadTimer;
+	//! Thread parsing the scheme's file.
+	QThread * m_loadThread;
+	//! Result of the parsing.
+	std::shared_ptr< SchemeLoadResult > m_loadResult;
+	//! File name of the loading scheme.
+	QString m_loadFileName;
+	//! Is scheme loading?
+	bool m_isLoading;
+	//! Configuration of the scheme with items to create.
+	SchemeCfg m_pendingCfg;
+	//! Next source to create.
+	int m_nextSource;
+	//! Next text to create.
+	int m_nextText;
+	//! Next aggregate to create.
+	int m_nextAggregate;
 	//! Configuration file.
 	QString m_cfgFile;
 	//! Name of the scheme.
 	QString m_name;
+	//! Is scene used without windows?
+	bool m_headless;
 }; // class ScenePrivate
 
 
@@ -246,6 +496,7 @@ Scene::Scene( QObject * parent )
 
 Scene::~Scene()
 {
+	d->joinLoadThread();
 }
 
 const QString &
@@ -332,6 +583,52 @@ Scene::setParentWidget( QWidget * parent )
 	d->m_parentWidget = parent;
 }
 
+void
+Scene::setHeadless( bool on )
+{
+	d->m_headless = on;
+}
+
+void
+Scene::setPaused( bool on )
+{
+	SourcesBus::instance().setPaused( d.data(), on );
+}
+
+QList< Source* >
+Scene::sources() const
+{
+	return d->m_sources.values();
+}
+
+const QList< Aggregate* > &
+Scene::aggregates() const
+{
+	return d->m_agg;
+}
+
+void
+Scene::scheduleUpdate( QGraphicsItem * item )
+{
+	d->m_dirtyItems.insert( item );
+
+	if( !d->m_repaintTimer->isActive() )
+		d->m_repaintTimer->start();
+}
+
+void
+Scene::repaintItems()
+{
+	const QSet< QGraphicsItem* > items = std::move( d->m_dirtyItems );
+
+	d->m_dirtyItems.clear();
+
+	for( auto * item : items )
+		item->update();
+
+	emit itemsUpdated( items );
+}
+
 void
 Scene::removeSource( Source * source )
 {
@@ -341,8 +638,12 @@ Scene::removeSource( Source * source )
 
 	d->m_selection.removeItem( source );
 
+	d->m_dirtyItems.remove( source );
+
 	d->m_sources.remove( key );
 
+	d->unsubscribe( key );
+
 	if( !isChannelInUse( source->channelName() ) )
 		removeChannel( source->channelName() );
 }
@@ -354,6 +655,8 @@ Scene::removeText( Text * text )
 
 	d->m_selection.removeItem( text );
 
+	d->m_dirtyItems.remove( text );
+
 	d->m_texts.removeOne( text );
 }
 
@@ -364,8 +667,12 @@ Scene::removeAggregate( Aggregate * agg )
 
 	d->m_selection.removeItem( agg );
 
+	d->m_dirtyItems.remove( agg );
+
 	d->m_agg.removeOne( agg );
 
+	d->unsubscribe( agg );
+
 	for( const auto & ch : std::as_const( agg->listOfChannels() ) )
 	{
 		if( !isChannelInUse( ch ) )
@@ -373,68 +680,166 @@ Scene::removeAggregate( Aggregate * agg )
 	}
 }
 
+bool
+Scene::isLoading() const
+{
+	return d->m_isLoading;
+}
+
 void
 Scene::loadScheme( const QString & fileName )
 {
-	SchemeCfgTag tag;
+	d->joinLoadThread();
 
-	QFile file( fileName );
+	d->m_isLoading = true;
 
-	if( file.open( QIODevice::ReadOnly ) )
-	{
-		try {
-			QTextStream stream( &file );
+	auto result = std::make_shared< SchemeLoadResult > ();
 
-			cfgfile::read_cfgfile( tag, stream, fileName );
+	d->m_loadResult = result;
+	d->m_loadFileName = fileName;
 
-			file.close();
+	// Parsing of the file doesn't touch any object of the application.
+	QThread * thread = QThread::create( [fileName, result] ()
+		{
+			SchemeCfgTag tag;
 
-			SchemeCfg cfg = tag.cfg();
+			QFile file( fileName );
 
-			d->m_cfgFile = fileName;
+			if( file.open( QIODevice::ReadOnly ) )
+			{
+				result->m_opened = true;
 
-			initScheme( cfg );
+				try {
+					QTextStream stream( &file );
 
-			Log::instance().writeMsgToEventLog( LogLevelInfo,
-				QString( "Scheme successfully loaded from file \"%1\"." )
-					.arg( fileName ) );
-		}
-		catch( const cfgfile::exception_t< cfgfile::qstring_trait_t > & x )
+					cfgfile::read_cfgfile( tag, stream, fileName );
+
+					file.close();
+
+					result->m_cfg = tag.cfg();
+					result->m_ok = true;
+				}
+				catch( const cfgfile::exception_t< cfgfile::qstring_trait_t > & x )
+				{
+					file.close();
+
+					result->m_error = x.desc();
+				}
+			}
+		} );
+
+	d->m_loadThread = thread;
+
+	// Result could be already applied by finishLoading().
+	connect( thread, &QThread::finished, this,
+		[this, thread] ()
 		{
-			file.close();
+			if( d->m_loadThread == thread )
+				applyLoadedScheme();
+		} );
 
-			Log::instance().writeMsgToEventLog( LogLevelError,
-				QString( "Unable to load scheme configuration "
-					"from file \"%1\".\n"
-					"%2" )
-						.arg( fileName, x.desc() ) );
+	thread->start();
+}
+
+void
+Scene::applyLoadedScheme()
+{
+	d->joinLoadThread();
+
+	const auto result = d->m_loadResult;
+	d->m_loadResult.reset();
+
+	if( result )
+		schemeRead( d->m_loadFileName, *result );
+}
+
+void
+Scene::schemeRead( const QString & fileName, const SchemeLoadResult & result )
+{
+	if( result.m_ok )
+	{
+		d->m_cfgFile = fileName;
+
+		beginScheme( result.m_cfg );
+
+		d->m_loadTimer->start();
+	}
+	else if( result.m_opened )
+	{
+		d->m_isLoading = false;
+
+		Log::instance().writeMsgToEventLog( LogLevelError,
+			QString( "Unable to load scheme configuration "
+				"from file \"%1\".\n"
+				"%2" )
+					.arg( fileName, result.m_error ) );
 
+		emit schemeLoadFailed( result.m_error );
+
+		if( !d->m_headless )
 			QMessageBox::critical( 0,
 				tr( "Unable to read scheme configuration..." ),
 				tr( "Unable to read scheme configuration from file \"%1\"\n\n"
 					"%2" )
-					.arg( fileName, x.desc() ) );
-		}
+					.arg( fileName, result.m_error ) );
 	}
 	else
 	{
+		d->m_isLoading = false;
+
 		Log::instance().writeMsgToEventLog( LogLevelError,
 			QString( "Unable to load scheme configuration "
 				"from file \"%1\".\n"
 				"Unable to open file." )
 					.arg( fileName ) );
 
-		QMessageBox::critical( 0,
-			tr( "Unable to read scheme configuration..." ),
-			tr( "Unable to read scheme configuration from file \"%1\"\n\n"
-				"Unable to open file." )
-				.arg( fileName ) );
+		emit schemeLoadFailed( tr( "Unable to open file." ) );
+
+		if( !d->m_headless )
+			QMessageBox::critical( 0,
+				tr( "Unable to read scheme configuration..." ),
+				tr( "Unable to read scheme configuration from file \"%1\"\n\n"
+					"Unable to open file." )
+					.arg( fileName ) );
+	}
+}
+
+void
+Scene::loadStep()
+{
+	if( createItems( loadStepDuration ) )
+	{
+		finishScheme();
+
+		Log::instance().writeMsgToEventLog( LogLevelInfo,
+			QString( "Scheme successfully loaded from file \"%1\"." )
+				.arg( d->m_cfgFile ) );
+	}
+	else
+		d->m_loadTimer->start();
+}
+
+void
+Scene::finishLoading()
+{
+	if( d->m_loadThread )
+		applyLoadedScheme();
+
+	if( d->m_loadTimer->isActive() )
+	{
+		d->m_loadTimer->stop();
+
+		createItems( -1 );
+
+		finishScheme();
 	}
 }
 
 void
 Scene::saveScheme( const QString & fileName )
 {
+	finishLoading();
+
 	QFile file( fileName );
 
 	if( file.open( QIODevice::WriteOnly ) )
@@ -485,11 +890,42 @@ Scene::saveScheme( const QString & fileName )
 
 void
 Scene::initScheme( const SchemeCfg & cfg )
+{
+	beginScheme( cfg );
+
+	createItems( -1 );
+
+	finishScheme();
+}
+
+void
+Scene::beginScheme( const SchemeCfg & cfg )
 {
 	d->m_name = cfg.name();
+	d->m_pendingCfg = cfg;
+	d->m_nextSource = 0;
+	d->m_nextText = 0;
+	d->m_nextAggregate = 0;
+}
+
+bool
+Scene::createItems( qint64 duration )
+{
+	QElapsedTimer timer;
+	timer.start();
 
-	foreach( const SourceCfg & s, cfg.sources() )
+	const auto isTimeOut = [&] ()
+		{ return ( duration >= 0 && timer.elapsed() >= duration ); };
+
+	const auto & sources = d->m_pendingCfg.sources();
+
+	for( ; d->m_nextSource < sources.size(); ++d->m_nextSource )
 	{
+		if( isTimeOut() )
+			return false;
+
+		const SourceCfg & s = sources.at( d->m_nextSource );
+
 		Como::Source source( s.type(), s.sourceName(), s.typeName(),
 			QVariant(), QString() );
 
@@ -507,11 +943,20 @@ Scene::initScheme( const SchemeCfg & cfg )
 			addItem( item );
 
 			d->m_sources.insert( key, item );
+
+			d->subscribe( key, item );
 		}
 	}
 
-	foreach( const TextCfg & t, cfg.texts() )
+	const auto & texts = d->m_pendingCfg.texts();
+
+	for( ; d->m_nextText < texts.size(); ++d->m_nextText )
 	{
+		if( isTimeOut() )
+			return false;
+
+		const TextCfg & t = texts.at( d->m_nextText );
+
 		Text * text = new Text( t.text(), &d->m_selection, this );
 		text->setMode( d->m_mode );
 		text->setEditMode( d->m_editMode );
@@ -522,8 +967,15 @@ Scene::initScheme( const SchemeCfg & cfg )
 		d->m_texts.append( text );
 	}
 
-	for( const auto & a : std::as_const( cfg.aggregates() ) )
+	const auto & aggregates = d->m_pendingCfg.aggregates();
+
+	for( ; d->m_nextAggregate < aggregates.size(); ++d->m_nextAggregate )
 	{
+		if( isTimeOut() )
+			return false;
+
+		const SchemeCfg & a = aggregates.at( d->m_nextAggregate );
+
 		Aggregate * agg = new Aggregate( &d->m_selection, this );
 		agg->setMode( d->m_mode );
 		agg->setEditMode( d->m_editMode );
@@ -532,11 +984,24 @@ Scene::initScheme( const SchemeCfg & cfg )
 		addItem( agg );
 
 		d->m_agg.append( agg );
+
+		d->subscribe( agg );
 	}
 
+	return true;
+}
+
+void
+Scene::finishScheme()
+{
+	d->m_pendingCfg = SchemeCfg();
+	d->m_isLoading = false;
+
 	populateChannels();
 
 	syncSources();
+
+	emit schemeLoaded();
 }
 
 void
@@ -554,7 +1019,11 @@ Scene::addSource( const QString & channelName, const Como::Source & source,
 	if( !isChannelInUse( channelName ) )
 		addChannel( channelName );
 
-	d->m_sources.insert( Key( source, channelName ), item );
+	const Key key( source, channelName );
+
+	d->m_sources.insert( key, item );
+
+	d->subscribe( key, item );
 }
 
 void
@@ -698,35 +1167,42 @@ Scene::keyPressEvent( QKeyEvent * keyEvent )
 }
 
 void
-Scene::channelRemoved( Globe::Channel * channel )
+Scene::helpEvent( QGraphicsSceneHelpEvent * helpEvent )
 {
-	if( d->m_mode == ViewScene )
-	{
-		d->channelDisconnected( channel->name() );
-	}
-}
+	const QList< QGraphicsItem* > list = items( helpEvent->scenePos(),
+		Qt::IntersectsItemShape, Qt::DescendingOrder,
+		views().isEmpty() ? QTransform() :
+			views().constFirst()->transform() );
 
-void
-Scene::sourceUpdated( const Como::Source & source )
-{
-	if( d->m_mode == ViewScene )
+	QString text;
+
+	for( auto * item : list )
 	{
-		Channel * channel = static_cast< Channel* > ( sender() );
+		BaseItem * base = qobject_cast< BaseItem* > ( item->toGraphicsObject() );
 
-		if( channel )
-			d->updateSource( source, channel->name() );
+		if( base )
+		{
+			text = base->toolTipText();
+
+			break;
+		}
 	}
+
+	if( !text.isEmpty() )
+		QToolTip::showText( helpEvent->screenPos(), text,
+			helpEvent->widget() );
+	else
+		QToolTip::hideText();
+
+	helpEvent->setAccepted( !text.isEmpty() );
 }
 
 void
-Scene::sourceDeregistered( const Como::Source & source )
+Scene::channelRemoved( Globe::Channel * channel )
 {
 	if( d->m_mode == ViewScene )
 	{
-		Channel * channel = static_cast< Channel* > ( sender() );
-
-		if( channel )
-			d->sourceDeregistered( source, channel->name() );
+		d->channelDisconnected( channel->name() );
 	}
 }
 
@@ -752,12 +1228,6 @@ Scene::disconnected()
 	}
 }
 
-void
-Scene::newSource( const Como::Source & s, const QString & channel )
-{
-	d->updateSource( s, channel );
-}
-
 void
 Scene::propertiesChanged()
 {
@@ -781,12 +1251,23 @@ Scene::init()
 
 	addItem( item );
 
+	d->m_repaintTimer = new QTimer( this );
+	d->m_repaintTimer->setSingleShot( true );
+	d->m_repaintTimer->setInterval( 1000 / maxRepaintsPerSecond );
+
+	connect( d->m_repaintTimer, &QTimer::timeout,
+		this, &Scene::repaintItems );
+
+	d->m_loadTimer = new QTimer( this );
+	d->m_loadTimer->setSingleShot( true );
+	d->m_loadTimer->setInterval( 0 );
+
+	connect( d->m_loadTimer, &QTimer::timeout,
+		this, &Scene::loadStep );
+
 	connect( &ChannelsManager::instance(), &ChannelsManager::channelRemoved,
 		this, &Scene::channelRemoved );
 
-	connect( &SourcesManager::instance(), &SourcesManager::newSource,
-		this, &Scene::newSource );
-
 	connect( &PropertiesManager::instance(),
 		&PropertiesManager::propertiesChanged,
 		this, &Scene::propertiesChanged );
@@ -794,6 +1275,13 @@ Scene::init()
 
 void
 Scene::populateChannels()
+{
+	foreach( const QString & name, listOfChannels() )
+		addChannel( name );
+}
+
+QStringList
+Scene::listOfChannels() const
 {
 	QStringList channels;
 
@@ -816,8 +1304,7 @@ Scene::populateChannels()
 		}
 	}
 
-	foreach( const QString & name, channels )
-		addChannel( name );
+	return channels;
 }
 
 void
@@ -827,12 +1314,6 @@ Scene::addChannel( const QString & name )
 
 	if( channel )
 	{
-		connect( channel, &Channel::sourceUpdated,
-			this, &Scene::sourceUpdated );
-
-		connect( channel, &Channel::sourceDeregistered,
-			this, &Scene::sourceDeregistered );
-
 		connect( channel, &Channel::connected,
 			this, &Scene::connected );
 
@@ -846,20 +1327,27 @@ Scene::addChannel( const QString & name )
 					 "scheme \"%2\"." )
 				.arg( name, d->m_cfgFile ) );
 
-		QMessageBox::critical( 0, tr( "Channel is unavailable..." ),
-			tr( "Channel \"%1\" is unavailable for the\n"
-				"scheme \"%2\"." )
-				.arg( name, d->m_cfgFile ) );
+		if( !d->m_headless )
+			QMessageBox::critical( 0, tr( "Channel is unavailable..." ),
+				tr( "Channel \"%1\" is unavailable for the\n"
+					"scheme \"%2\"." )
+					.arg( name, d->m_cfgFile ) );
 	}
 }
 
+void
+Scene::aggregateChanged( Aggregate * agg )
+{
+	d->subscribe( agg );
+}
+
 void
 Scene::removeChannel( const QString & name )
 {
 	Channel * channel = ChannelsManager::instance().channelByName( name );
 
 	if( channel )
-		disconnect( channel, 0, 0, 0 );
+		disconnect( channel, 0, this, 0 );
 }
 
 bool
@@ -889,6 +1377,9 @@ Scene::syncSources()
 {
 	QList< QString > channels;
 
+	const SourcesSnapshot snapshot = SourcesManager::instance().snapshot(
+		listOfChannels() );
+
 	{
 		QMapIterator< Key, Source* > it( d->m_sources );
 
@@ -902,7 +1393,7 @@ Scene::syncSources()
 			Como::Source s = it.value()->source();
 			bool isRegistered = false;
 
-			if( SourcesManager::instance().syncSource( it.key().channelName(),
+			if( snapshot.syncSource( it.key().channelName(),
 				s, isRegistered ) )
 					it.value()->setSource( s );
 
@@ -926,8 +1417,7 @@ Scene::syncSources()
 			Como::Source tmp = p.first;
 			bool isRegistered = false;
 
-			SourcesManager::instance().syncSource( p.second,
-				tmp, isRegistered );
+			snapshot.syncSource( p.second, tmp, isRegistered );
 
 			agg->syncSource( tmp, p.second, isRegistered );
 		}
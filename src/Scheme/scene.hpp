@@ -16,9 +16,13 @@
 // Qt include.
 #include <QGraphicsScene>
 #include <QScopedPointer>
+#include <QStringList>
+#include <QList>
+#include <QSet>
 
 QT_BEGIN_NAMESPACE
 class QWidget;
+class QGraphicsItem;
 QT_END_NAMESPACE
 
 
@@ -33,6 +37,7 @@ class Source;
 class Text;
 class Aggregate;
 class SchemeCfg;
+struct SchemeLoadResult;
 
 
 //
@@ -47,6 +52,14 @@ class Scene
 {
 	Q_OBJECT
 
+signals:
+	//! Scheme loaded and all items created.
+	void schemeLoaded();
+	//! Unable to load scheme.
+	void schemeLoadFailed( const QString & reason );
+	//! Scheduled items were repainted.
+	void itemsUpdated( const QSet< QGraphicsItem* > & items );
+
 public:
 	Scene( QObject * parent = 0 );
 
@@ -58,6 +71,10 @@ public:
 	//! \return Scheme name.
 	const QString & schemeName() const;
 
+	//! Schedule repaint of the item. Items are repainted by timer not
+	//! more often than 25 times per second.
+	void scheduleUpdate( QGraphicsItem * item );
+
 	//! \return Scheme configuration.
 	SchemeCfg schemeCfg() const;
 
@@ -74,6 +91,19 @@ public:
 	//! Set parent widget.
 	void setParentWidget( QWidget * parent );
 
+	//! Set scene to be used without windows, errors will be only
+	//! logged without message boxes.
+	void setHeadless( bool on = true );
+
+	//! Pause updates of the sources while scene isn't visible, on
+	//! resume scene catches up with changed sources in one batch.
+	void setPaused( bool on = true );
+
+	//! \return Source items.
+	QList< Source* > sources() const;
+	//! \return Aggregates.
+	const QList< Aggregate* > & aggregates() const;
+
 	//! Remove source from the scene.
 	void removeSource( Source * source );
 	//! Remove text item from the scene.
@@ -81,8 +111,11 @@ public:
 	//! Remove aggregate from the scene.
 	void removeAggregate( Aggregate * agg );
 
-	//! Load scheme.
+	//! Load scheme. File is read on the worker thread and items are
+	//! created in short steps on the event loop.
 	void loadScheme( const QString & fileName );
+	//! \return Is scheme loading?
+	bool isLoading() const;
 	//! Save scheme.
 	void saveScheme( const QString & fileName );
 
@@ -96,28 +129,29 @@ public:
 protected:
 	void mouseReleaseEvent( QGraphicsSceneMouseEvent * mouseEvent );
 	void keyPressEvent( QKeyEvent * keyEvent );
+	void helpEvent( QGraphicsSceneHelpEvent * helpEvent );
 
 protected:
 	friend class Aggregate;
 
 	//! Add channel.
 	void addChannel( const QString & name );
+	//! Sources of the aggregate changed.
+	void aggregateChanged( Aggregate * agg );
 
 private slots:
 	//! Channel was removed.
 	void channelRemoved( Globe::Channel * channel );
-	//! New source or update.
-	void sourceUpdated( const Como::Source & source );
-	//! Source deregistered.
-	void sourceDeregistered( const Como::Source & source );
 	//! Connected to host.
 	void connected();
 	//! Disconnected from host.
 	void disconnected();
-	//! New source available.
-	void newSource( const Como::Source & s, const QString & channel );
 	//! Properties changed.
 	void propertiesChanged();
+	//! Repaint scheduled items.
+	void repaintItems();
+	//! Create next portion of the items of the loaded scheme.
+	void loadStep();
 
 private:
 	//! Init.
@@ -128,8 +162,24 @@ private:
 	void removeChannel( const QString & name );
 	//! \return Is channel in use?
 	bool isChannelInUse( const QString & name );
+	//! \return Channels of the sources and aggregates.
+	QStringList listOfChannels() const;
 	//! Sync sources.
 	void syncSources();
+	//! Scheme was read.
+	void schemeRead( const QString & fileName,
+		const SchemeLoadResult & result );
+	//! Wait for the parsing thread and apply its result.
+	void applyLoadedScheme();
+	//! Start creation of the items of the scheme.
+	void beginScheme( const SchemeCfg & cfg );
+	//! Create items not longer than \a duration msecs, -1 means
+	//! create all. \return Were all items created?
+	bool createItems( qint64 duration );
+	//! All items created, connect channels and sync sources.
+	void finishScheme();
+	//! Create all remaining items of the loading scheme right now.
+	void finishLoading();
 
 private:
 	Q_DISABLE_COPY( Scene )
@@ -7,6 +7,10 @@
 // Globe include.
 #include <Scheme/scheme_utils.hpp>
 
+// Qt include.
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+
 
 namespace Globe {
 
@@ -39,6 +43,21 @@ QString createToolTip( const QString & channelName,
 	return res;
 }
 
+
+//
+// isDetailVisible
+//
+
+//! Details are not painted if the scheme is zoomed out more than this.
+static const qreal minLevelOfDetail = 0.5;
+
+bool isDetailVisible( const QStyleOptionGraphicsItem * option,
+	const QPainter * painter )
+{
+	return ( option->levelOfDetailFromTransform( painter->worldTransform() ) >=
+		minLevelOfDetail );
+}
+
 } /* namespace Scheme */
 
 } /* namespace Globe */
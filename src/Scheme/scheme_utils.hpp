@@ -13,6 +13,11 @@
 // Como include.
 #include <Como/Source>
 
+QT_BEGIN_NAMESPACE
+class QPainter;
+class QStyleOptionGraphicsItem;
+QT_END_NAMESPACE
+
 
 namespace Globe {
 
@@ -26,6 +31,16 @@ namespace Scheme {
 QString createToolTip( const QString & channelName,
 	const Como::Source & s );
 
+
+//
+// isDetailVisible
+//
+
+//! \return Should text and small details of the item be painted at
+//! the current scale of the view?
+bool isDetailVisible( const QStyleOptionGraphicsItem * option,
+	const QPainter * painter );
+
 } /* namespace Scheme */
 
 } /* namespace Globe */
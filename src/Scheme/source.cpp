@@ -37,6 +37,8 @@ public:
 		:	SelectablePrivate( selection, scene )
 		,	m_source( source )
 		,	m_channelName( channelName )
+		,	m_level( Uninitialized )
+		,	m_status( ItemRegistered )
 	{
 	}
 
@@ -52,6 +54,10 @@ public:
 	QColor m_fillColor;
 	//! Current properties key.
 	PropertiesKey m_currentKey;
+	//! Level.
+	Level m_level;
+	//! Status.
+	ItemStatus m_status;
 }; // class SourcePrivate
 
 
@@ -96,6 +102,8 @@ Source::setSource( const Como::Source & source )
 {
 	auto * dd = d_ptr();
 
+	const bool valueChanged = ( dd->m_source.value() != source.value() );
+
 	dd->m_source = source;
 
 	const Properties * props = PropertiesManager::instance().findProperties(
@@ -109,11 +117,34 @@ Source::setSource( const Como::Source & source )
 			dd->m_source.type() ).level();
 	}
 
-	dd->m_fillColor = ColorForLevel::instance().color( level );
+	dd->m_level = level;
+	dd->m_status = ItemRegistered;
+
+	setFillColor( ColorForLevel::instance().color( level ), valueChanged );
+}
+
+void
+Source::setFillColor( const QColor & c, bool valueChanged )
+{
+	auto * dd = d_ptr();
 
-	setToolTip( createToolTip( dd->m_channelName, source ) );
+	if( dd->m_fillColor != c || valueChanged )
+	{
+		dd->m_fillColor = c;
 
-	update();
+		if( dd->m_scene )
+			dd->m_scene->scheduleUpdate( this );
+		else
+			update();
+	}
+}
+
+QString
+Source::toolTipText() const
+{
+	auto * dd = d_ptr();
+
+	return createToolTip( dd->m_channelName, dd->m_source );
 }
 
 SourceCfg
@@ -153,17 +184,17 @@ Source::setCfg( const SourceCfg & cfg )
 void
 Source::disconnected()
 {
-	d_ptr()->m_fillColor = ColorForLevel::instance().disconnectedColor();
+	d_ptr()->m_status = ItemDisconnected;
 
-	update();
+	setFillColor( ColorForLevel::instance().disconnectedColor() );
 }
 
 void
 Source::deregistered()
 {
-	d_ptr()->m_fillColor = ColorForLevel::instance().deregisteredColor();
+	d_ptr()->m_status = ItemDeregistered;
 
-	update();
+	setFillColor( ColorForLevel::instance().deregisteredColor() );
 }
 
 void
@@ -182,21 +213,27 @@ Source::propertiesChanged()
 			dd->m_source.type() ).level();
 	}
 
-	const QColor newColor = ColorForLevel::instance().color( level );
+	dd->m_level = level;
 
-	if( dd->m_fillColor != newColor )
-	{
-		dd->m_fillColor = newColor;
+	setFillColor( ColorForLevel::instance().color( level ) );
+}
 
-		update();
-	}
+Level
+Source::level() const
+{
+	return d_ptr()->m_level;
+}
+
+ItemStatus
+Source::status() const
+{
+	return d_ptr()->m_status;
 }
 
 void
 Source::paint( QPainter * painter, const QStyleOptionGraphicsItem * option,
 	QWidget * widget )
 {
-	Q_UNUSED( option )
 	Q_UNUSED( widget )
 
 	auto * dd = d_ptr();
@@ -210,6 +247,10 @@ Source::paint( QPainter * painter, const QStyleOptionGraphicsItem * option,
 
 	painter->drawRect( boundingRect() );
 
+	// Zoomed out scheme shows only colors.
+	if( !isDetailVisible( option, painter ) )
+		return;
+
 	if( dd->m_state == ItemSelected )
 	{
 		painter->setBrush( Qt::blue );
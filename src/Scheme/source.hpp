@@ -13,6 +13,7 @@
 // Globe include.
 #include <Scheme/source_cfg.hpp>
 #include <Scheme/base_item.hpp>
+#include <Core/condition.hpp>
 
 
 namespace Globe {
@@ -65,6 +66,14 @@ public:
 	//! Notify about changes in properties.
 	void propertiesChanged();
 
+	//! \return Level of the source.
+	Level level() const;
+	//! \return Status of the source.
+	ItemStatus status() const;
+
+	//! \return Tool tip.
+	QString toolTipText() const Q_DECL_OVERRIDE;
+
 	//! Paint item.
 	void paint( QPainter * painter, const QStyleOptionGraphicsItem * option,
 		QWidget * widget ) Q_DECL_OVERRIDE;
@@ -84,6 +93,9 @@ private slots:
 	void promoteProperties();
 
 private:
+	//! Set fill color and schedule repaint if needed.
+	void setFillColor( const QColor & c, bool valueChanged = false );
+
 	SourcePrivate * d_ptr();
 	const SourcePrivate * d_ptr() const;
 
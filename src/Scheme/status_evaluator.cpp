@@ -0,0 +1,432 @@
+
+/*
+	SPDX-FileCopyrightText: 2012-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// Globe include.
+#include <Scheme/status_evaluator.hpp>
+#include <Scheme/scene.hpp>
+#include <Scheme/source.hpp>
+#include <Scheme/aggregate.hpp>
+
+#include <Core/condition_cfg.hpp>
+#include <Core/log.hpp>
+#include <Core/configuration.hpp>
+
+// Qt include.
+#include <QTimer>
+#include <QList>
+#include <QHash>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QImage>
+#include <QPainter>
+#include <QDateTime>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QGraphicsItem>
+
+
+namespace Globe {
+
+namespace Scheme {
+
+//! Name of the status file.
+static const QString statusFileName = QLatin1String( "status.json" );
+
+//! \return String with the status of the item.
+static inline QString statusToString( ItemStatus status )
+{
+	switch( status )
+	{
+		case ItemDeregistered : return QLatin1String( "deregistered" );
+		case ItemDisconnected : return QLatin1String( "disconnected" );
+		default : return QLatin1String( "registered" );
+	}
+}
+
+
+//
+// ItemStatusData
+//
+
+//! Evaluated status of the item.
+struct ItemStatusData {
+	ItemStatusData()
+		:	m_level( Uninitialized )
+	{
+	}
+
+	//! Status in JSON.
+	QJsonObject m_json;
+	//! Level, Uninitialized if item doesn't take part in the level.
+	Level m_level;
+}; // struct ItemStatusData
+
+
+//
+// SchemeStatus
+//
+
+//! Status of the scheme.
+struct SchemeStatus {
+	SchemeStatus()
+		:	m_scene( 0 )
+		,	m_loaded( false )
+		,	m_dirty( false )
+	{
+	}
+
+	//! Scene.
+	Scene * m_scene;
+	//! File name of the scheme.
+	QString m_fileName;
+	//! File name of the snapshot.
+	QString m_imageFileName;
+	//! Error.
+	QString m_error;
+	//! Statuses of the sources and aggregates.
+	QHash< QGraphicsItem*, ItemStatusData > m_items;
+	//! Status of the scheme in JSON.
+	QJsonObject m_json;
+	//! Is scheme loaded?
+	bool m_loaded;
+	//! Was scheme changed since the last snapshot?
+	bool m_dirty;
+}; // struct SchemeStatus
+
+
+//
+// StatusEvaluatorPrivate
+//
+
+class StatusEvaluatorPrivate {
+public:
+	StatusEvaluatorPrivate( const QString & outputDir )
+		:	m_outputDir( outputDir )
+		,	m_timer( 0 )
+		,	m_statusChanged( false )
+	{
+	}
+
+	//! \return Scheme of the scene.
+	SchemeStatus * scheme( QObject * scene );
+	//! Evaluate status of the item.
+	static void evaluate( QGraphicsItem * item, ItemStatusData & data );
+	//! Evaluate status of all items of the scheme.
+	void evaluateAll( SchemeStatus & s );
+	//! Update status of the scheme in JSON.
+	void updateJson( SchemeStatus & s );
+	//! Render snapshot of the scheme.
+	void render( SchemeStatus & s );
+	//! Write status file.
+	void writeStatus();
+
+	//! Output directory.
+	QDir m_outputDir;
+	//! Schemes.
+	QList< SchemeStatus > m_schemes;
+	//! Indexes of the schemes by scenes.
+	QHash< QObject*, int > m_index;
+	//! Snapshot timer.
+	QTimer * m_timer;
+	//! Should status file be written?
+	bool m_statusChanged;
+}; // class StatusEvaluatorPrivate
+
+SchemeStatus *
+StatusEvaluatorPrivate::scheme( QObject * scene )
+{
+	const auto it = m_index.constFind( scene );
+
+	return ( it != m_index.cend() ? &m_schemes[ it.value() ] : 0 );
+}
+
+void
+StatusEvaluatorPrivate::evaluate( QGraphicsItem * item,
+	ItemStatusData & data )
+{
+	QGraphicsObject * obj = item->toGraphicsObject();
+
+	if( !obj )
+		return;
+
+	Level level = Uninitialized;
+	ItemStatus status = ItemRegistered;
+
+	data.m_json = QJsonObject();
+
+	if( Source * s = qobject_cast< Source* > ( obj ) )
+	{
+		level = s->level();
+		status = s->status();
+
+		data.m_json.insert( QLatin1String( "channel" ), s->channelName() );
+		data.m_json.insert( QLatin1String( "type" ), s->source().typeName() );
+		data.m_json.insert( QLatin1String( "name" ), s->source().name() );
+		data.m_json.insert( QLatin1String( "value" ),
+			s->source().value().toString() );
+	}
+	else if( Aggregate * a = qobject_cast< Aggregate* > ( obj ) )
+	{
+		level = a->level();
+		status = a->status();
+
+		data.m_json.insert( QLatin1String( "aggregate" ), a->cfg().name() );
+	}
+	else
+		return;
+
+	data.m_level = ( status == ItemRegistered ? level : Uninitialized );
+
+	data.m_json.insert( QLatin1String( "status" ), statusToString( status ) );
+
+	if( data.m_level != Uninitialized )
+		data.m_json.insert( QLatin1String( "level" ),
+			levelToString( data.m_level ) );
+}
+
+void
+StatusEvaluatorPrivate::evaluateAll( SchemeStatus & s )
+{
+	s.m_items.clear();
+
+	foreach( Source * source, s.m_scene->sources() )
+		evaluate( source, s.m_items[ source ] );
+
+	foreach( Aggregate * agg, s.m_scene->aggregates() )
+		evaluate( agg, s.m_items[ agg ] );
+}
+
+void
+StatusEvaluatorPrivate::updateJson( SchemeStatus & s )
+{
+	s.m_json = QJsonObject();
+
+	s.m_json.insert( QLatin1String( "file" ), s.m_fileName );
+
+	if( !s.m_error.isEmpty() )
+	{
+		s.m_json.insert( QLatin1String( "error" ), s.m_error );
+
+		return;
+	}
+
+	s.m_json.insert( QLatin1String( "name" ), s.m_scene->schemeName() );
+	s.m_json.insert( QLatin1String( "snapshot" ), s.m_imageFileName );
+
+	Level worst = Uninitialized;
+	QJsonArray items;
+
+	for( auto it = s.m_items.cbegin(), last = s.m_items.cend();
+		it != last; ++it )
+	{
+		if( it.value().m_level < worst )
+			worst = it.value().m_level;
+
+		items.append( it.value().m_json );
+	}
+
+	if( worst != Uninitialized )
+		s.m_json.insert( QLatin1String( "level" ), levelToString( worst ) );
+
+	s.m_json.insert( QLatin1String( "items" ), items );
+}
+
+void
+StatusEvaluatorPrivate::render( SchemeStatus & s )
+{
+	const QRectF rect = s.m_scene->itemsBoundingRect();
+
+	if( rect.isEmpty() )
+		return;
+
+	QImage image( rect.size().toSize(), QImage::Format_ARGB32_Premultiplied );
+	image.fill( Qt::white );
+
+	{
+		QPainter painter( &image );
+		painter.setRenderHint( QPainter::Antialiasing );
+
+		s.m_scene->render( &painter, QRectF(), rect );
+	}
+
+	const QString fileName = m_outputDir.filePath( s.m_imageFileName );
+
+	if( !image.save( fileName, "PNG" ) )
+		Log::instance().writeMsgToEventLog( LogLevelError,
+			QString( "Unable to save snapshot of the scheme "
+				"to file \"%1\"." )
+					.arg( fileName ) );
+}
+
+void
+StatusEvaluatorPrivate::writeStatus()
+{
+	QJsonArray schemes;
+
+	foreach( const SchemeStatus & s, m_schemes )
+		schemes.append( s.m_json );
+
+	QJsonObject status;
+	status.insert( QLatin1String( "time" ),
+		QDateTime::currentDateTimeUtc().toString( Qt::ISODate ) );
+	status.insert( QLatin1String( "schemes" ), schemes );
+
+	const QStringList & errors = Configuration::instance().errors();
+
+	if( !errors.isEmpty() )
+		status.insert( QLatin1String( "configurationErrors" ),
+			QJsonArray::fromStringList( errors ) );
+
+	const QString fileName = m_outputDir.filePath( statusFileName );
+
+	QSaveFile file( fileName );
+
+	if( file.open( QIODevice::WriteOnly ) )
+	{
+		file.write( QJsonDocument( status ).toJson( QJsonDocument::Compact ) );
+
+		if( file.commit() )
+			return;
+	}
+
+	Log::instance().writeMsgToEventLog( LogLevelError,
+		QString( "Unable to write status of the schemes "
+			"to file \"%1\"." )
+				.arg( fileName ) );
+}
+
+
+//
+// StatusEvaluator
+//
+
+StatusEvaluator::StatusEvaluator( const QString & outputDir, int interval,
+	QObject * parent )
+	:	QObject( parent )
+	,	d( new StatusEvaluatorPrivate( outputDir ) )
+{
+	d->m_outputDir.mkpath( QLatin1String( "." ) );
+
+	d->m_timer = new QTimer( this );
+	d->m_timer->setInterval( interval );
+
+	connect( d->m_timer, &QTimer::timeout,
+		this, &StatusEvaluator::snapshot );
+
+	d->m_timer->start();
+}
+
+StatusEvaluator::~StatusEvaluator()
+{
+}
+
+void
+StatusEvaluator::addScheme( const QString & fileName )
+{
+	SchemeStatus s;
+	s.m_scene = new Scene( this );
+	s.m_scene->setHeadless();
+	s.m_fileName = fileName;
+	s.m_imageFileName = QFileInfo( fileName ).completeBaseName() +
+		QLatin1String( ".png" );
+
+	d->m_index.insert( s.m_scene, d->m_schemes.size() );
+	d->m_schemes.append( s );
+
+	connect( s.m_scene, &Scene::schemeLoaded,
+		this, &StatusEvaluator::schemeLoaded );
+	connect( s.m_scene, &Scene::schemeLoadFailed,
+		this, &StatusEvaluator::schemeLoadFailed );
+	connect( s.m_scene, &Scene::itemsUpdated,
+		this, &StatusEvaluator::itemsUpdated );
+
+	s.m_scene->loadScheme( fileName );
+}
+
+int
+StatusEvaluator::schemesCount() const
+{
+	return d->m_schemes.size();
+}
+
+void
+StatusEvaluator::snapshot()
+{
+	for( auto & s : d->m_schemes )
+	{
+		if( s.m_dirty )
+		{
+			s.m_dirty = false;
+
+			d->updateJson( s );
+
+			if( s.m_loaded )
+				d->render( s );
+
+			d->m_statusChanged = true;
+		}
+	}
+
+	if( d->m_statusChanged )
+	{
+		d->m_statusChanged = false;
+
+		d->writeStatus();
+	}
+}
+
+void
+StatusEvaluator::schemeLoaded()
+{
+	SchemeStatus * s = d->scheme( sender() );
+
+	if( s )
+	{
+		s->m_loaded = true;
+		s->m_dirty = true;
+
+		d->evaluateAll( *s );
+	}
+}
+
+void
+StatusEvaluator::schemeLoadFailed( const QString & reason )
+{
+	SchemeStatus * s = d->scheme( sender() );
+
+	if( s )
+	{
+		s->m_error = reason;
+		s->m_dirty = true;
+	}
+}
+
+void
+StatusEvaluator::itemsUpdated( const QSet< QGraphicsItem* > & items )
+{
+	SchemeStatus * s = d->scheme( sender() );
+
+	if( s && s->m_loaded )
+	{
+		for( auto * item : items )
+		{
+			auto it = s->m_items.find( item );
+
+			if( it != s->m_items.end() )
+			{
+				StatusEvaluatorPrivate::evaluate( item, it.value() );
+
+				s->m_dirty = true;
+			}
+		}
+	}
+}
+
+} /* namespace Scheme */
+
+} /* namespace Globe */
@@ -0,0 +1,82 @@
+
+/*
+	SPDX-FileCopyrightText: 2012-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#ifndef GLOBE__SCHEME__STATUS_EVALUATOR_HPP__INCLUDED
+#define GLOBE__SCHEME__STATUS_EVALUATOR_HPP__INCLUDED
+
+// Qt include.
+#include <QObject>
+#include <QScopedPointer>
+#include <QSet>
+
+// Globe include.
+#include <Core/export.hpp>
+
+QT_BEGIN_NAMESPACE
+class QGraphicsItem;
+QT_END_NAMESPACE
+
+
+namespace Globe {
+
+namespace Scheme {
+
+//
+// StatusEvaluator
+//
+
+class StatusEvaluatorPrivate;
+
+/*!
+	Headless evaluator of the schemes.
+
+	Schemes are loaded into scenes without views, levels of sources and
+	aggregates are evaluated from the live channels. By timer PNG
+	snapshots of the changed schemes are rendered into the output
+	directory and compact JSON status of all schemes is written into
+	"status.json" there. Only schemes and items repainted since the
+	last snapshot are evaluated again, unchanged schemes cost nothing.
+*/
+class CORE_EXPORT StatusEvaluator
+	:	public QObject
+{
+	Q_OBJECT
+
+public:
+	StatusEvaluator( const QString & outputDir, int interval,
+		QObject * parent = 0 );
+
+	~StatusEvaluator();
+
+	//! Add scheme from the given file.
+	void addScheme( const QString & fileName );
+
+	//! \return Count of the schemes.
+	int schemesCount() const;
+
+public slots:
+	//! Render snapshots of the changed schemes and write status.
+	void snapshot();
+
+private slots:
+	//! Scheme loaded.
+	void schemeLoaded();
+	//! Unable to load scheme.
+	void schemeLoadFailed( const QString & reason );
+	//! Items of the scheme repainted.
+	void itemsUpdated( const QSet< QGraphicsItem* > & items );
+
+private:
+	Q_DISABLE_COPY( StatusEvaluator )
+
+	QScopedPointer< StatusEvaluatorPrivate > d;
+}; // class StatusEvaluator
+
+} /* namespace Scheme */
+
+} /* namespace Globe */
+
+#endif // GLOBE__SCHEME__STATUS_EVALUATOR_HPP__INCLUDED
@@ -8,6 +8,7 @@
 #include <Scheme/text.hpp>
 #include <Scheme/scene.hpp>
 #include <Scheme/text_dialog.hpp>
+#include <Scheme/scheme_utils.hpp>
 
 // Qt include.
 #include <QPainter>
@@ -101,11 +102,12 @@ void
 Text::paint( QPainter * painter, const QStyleOptionGraphicsItem * option,
 	QWidget * widget )
 {
-	Q_UNUSED( option )
 	Q_UNUSED( widget )
 
 	auto * dd = d_ptr();
 
+	const bool detailVisible = isDetailVisible( option, painter );
+
 	if( dd->m_state == ItemSelected )
 	{
 		painter->setPen( Qt::blue );
@@ -119,6 +121,9 @@ Text::paint( QPainter * painter, const QStyleOptionGraphicsItem * option,
 			boundingRect().height() - 3, 3, 3 );
 	}
 
+	if( !detailVisible )
+		return;
+
 	painter->setPen( Qt::black );
 
 	painter->setFont( dd->m_font );
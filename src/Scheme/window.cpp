@@ -14,6 +14,7 @@
 #include <Core/globe_menu.hpp>
 #include <Core/tool_window_object.hpp>
 #include <Core/configuration.hpp>
+#include <Core/hidden_window_watcher.hpp>
 
 // Qt include.
 #include <QCloseEvent>
@@ -256,6 +257,9 @@ Window::init()
 
 	setCentralWidget( d->m_view );
 
+	connect( new HiddenWindowWatcher( this ), &HiddenWindowWatcher::hiddenChanged,
+		d->m_view->scene(), &Scene::setPaused );
+
 	d->m_editModeToolBar = new QToolBar( tr( "Edit Mode" ), this );
 
 	QAction * selectEditModeAction = d->m_editModeToolBar->addAction(
@@ -0,0 +1,497 @@
+
+/*
+	SPDX-FileCopyrightText: 2012-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// Qt include.
+#include <QTest>
+#include <QObject>
+#include <QVector>
+#include <QRandomGenerator>
+#include <QCoreApplication>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QDir>
+#include <QFile>
+
+// Globe include.
+#include <Core/channel_view_sort_model.hpp>
+#include <Core/channel_view_window_model.hpp>
+#include <Core/configuration.hpp>
+#include <Core/properties_manager.hpp>
+
+// C++ include.
+#include <algorithm>
+
+
+using namespace Globe;
+
+//! Count of the sources in the model.
+static const int sourcesCount = 300;
+
+//! Type name of the sources with levels.
+static const QString levelTypeName = QLatin1String( "level" );
+
+//! Configuration of the properties manager with properties of the
+//! sources with levels.
+static const QString propertiesManagerCfg = QLatin1String(
+	"{propertiesManager\n"
+	"	{confDirectory dataclasses/}\n"
+	"	{record\n"
+	"		{sourceTypeName level}\n"
+	"		{valueType int}\n"
+	"		{confFileName level.cfg}\n"
+	"	}\n"
+	"	{windowState\n"
+	"		{position {x 0} {y 0}}\n"
+	"		{size {width 0.5} {height 0.5}}\n"
+	"		{state hiddenWindow}\n"
+	"	}\n"
+	"}\n" );
+
+//! Properties of the sources with levels, level depends on the value.
+static const QString levelPropertiesCfg = QLatin1String(
+	"{properties\n"
+	"	{if {< 20} {level critical}}\n"
+	"	{if {< 40} {level error}}\n"
+	"	{if {< 60} {level warning}}\n"
+	"	{if {< 80} {level debug}}\n"
+	"	{otherwise {level info}}\n"
+	"}\n" );
+
+
+//
+// Reference.
+//
+
+//! \return Source rows in the order the proxy should show them.
+static QVector< int > referenceOrder( const ChannelViewWindowModel & model,
+	const ChannelViewSortModel & proxy )
+{
+	QVector< int > rows;
+
+	for( int row = 0; row < model.rowCount(); ++row )
+	{
+		const Como::Source & s = model.source( model.index( row, 0 ) );
+
+		if( proxy.levelFilter() != None &&
+			model.level( model.index( row, 0 ) ) > proxy.levelFilter() )
+				continue;
+
+		if( s.name().contains( proxy.filterText(), Qt::CaseInsensitive ) ||
+			s.typeName().contains( proxy.filterText(), Qt::CaseInsensitive ) )
+				rows.append( row );
+	}
+
+	const int column = proxy.sortColumn();
+	const bool ascending = ( proxy.sortOrder() == Qt::AscendingOrder );
+
+	auto compare = [&]( int r1, int r2 ) -> int
+	{
+		const Como::Source & s1 = model.source( model.index( r1, 0 ) );
+		const Como::Source & s2 = model.source( model.index( r2, 0 ) );
+
+		if( column == sourceNameColumn )
+			return QString::compare( s1.name(), s2.name() );
+		else if( column == valueColumn )
+		{
+			const int v1 = s1.value().toInt();
+			const int v2 = s2.value().toInt();
+
+			return ( v1 < v2 ? -1 : ( v2 < v1 ? 1 : 0 ) );
+		}
+		else
+			return 0;
+	};
+
+	std::sort( rows.begin(), rows.end(),
+		[&]( int r1, int r2 )
+		{
+			const int c = compare( r1, r2 );
+
+			if( c != 0 )
+				return ( ascending ? c < 0 : c > 0 );
+			else
+				return ( r1 < r2 );
+		} );
+
+	return rows;
+}
+
+//! \return Source rows in the order the proxy shows them.
+static QVector< int > proxyOrder( const ChannelViewSortModel & proxy )
+{
+	QVector< int > rows;
+	rows.reserve( proxy.rowCount() );
+
+	for( int row = 0; row < proxy.rowCount(); ++row )
+		rows.append( proxy.mapToSource( proxy.index( row, 0 ) ).row() );
+
+	return rows;
+}
+
+//! Check that the proxy shows rows in the order of the reference sort.
+static void checkOrder( const ChannelViewWindowModel & model,
+	const ChannelViewSortModel & proxy )
+{
+	QCOMPARE( proxyOrder( proxy ), referenceOrder( model, proxy ) );
+
+	for( int row = 0; row < proxy.rowCount(); ++row )
+	{
+		const QModelIndex index = proxy.index( row, 0 );
+
+		QCOMPARE( proxy.mapFromSource( proxy.mapToSource( index ) ), index );
+	}
+}
+
+//! Write text to the file.
+static bool writeFile( const QString & fileName, const QString & text )
+{
+	QFile file( fileName );
+
+	if( !file.open( QIODevice::WriteOnly ) )
+		return false;
+
+	file.write( text.toUtf8() );
+
+	return true;
+}
+
+//! Let queued changes reach the proxy.
+static void processChanges()
+{
+	QCoreApplication::processEvents();
+}
+
+
+//
+// TestChannelViewSortModel
+//
+
+class TestChannelViewSortModel
+	:	public QObject
+{
+	Q_OBJECT
+
+private slots:
+	//! Load properties of the sources with levels.
+	void initTestCase();
+	//! Rows appended one by one are placed at once.
+	void insert();
+	//! Changed rows are moved to their new places.
+	void move();
+	//! Filter is narrowed and widened.
+	void filter();
+	//! Filter is changed while changes of the rows are pending.
+	void filterWithPendingChanges();
+	//! Rows are changed by updates of the sources flushed by the model.
+	void sourcesUpdates();
+	//! Rows move into and out of the level filter.
+	void levelFilter();
+
+private:
+	//! Fill model with sources.
+	void fill( ChannelViewWindowModel & model );
+	//! \return Update of the source in the given row with new value.
+	SourceChange update( const ChannelViewWindowModel & model, int row );
+	//! \return Update of the source in the given row with the given value.
+	SourceChange update( const ChannelViewWindowModel & model, int row,
+		int value );
+
+private:
+	//! Generator of the values.
+	QRandomGenerator m_random = QRandomGenerator( 42 );
+	//! Directory with configuration.
+	QTemporaryDir m_dir;
+}; // class TestChannelViewSortModel
+
+void
+TestChannelViewSortModel::initTestCase()
+{
+	QVERIFY( m_dir.isValid() );
+
+	Configuration::instance().setHeadless();
+	Configuration::instance().setCfgFile(
+		m_dir.filePath( QLatin1String( "Globe.cfg" ) ) );
+
+	QVERIFY( QDir( m_dir.path() ).mkpath( defaultPropsConfigurationDirectory ) );
+	QVERIFY( writeFile( m_dir.filePath( defaultPropsConfigurationDirectory +
+		QLatin1String( "level.cfg" ) ), levelPropertiesCfg ) );
+
+	const QString fileName = m_dir.filePath( QLatin1String( "Properties.cfg" ) );
+
+	QVERIFY( writeFile( fileName, propertiesManagerCfg ) );
+
+	PropertiesManager::instance().readConfiguration( fileName );
+
+	QCOMPARE( Configuration::instance().errors(), QStringList() );
+}
+
+void
+TestChannelViewSortModel::fill( ChannelViewWindowModel & model )
+{
+	for( int i = 0; i < sourcesCount; ++i )
+		model.addItem( Como::Source( Como::Source::Int,
+			QString( "source_%1" ).arg( i ),
+			QString( "type_%1" ).arg( i % 7 ),
+			m_random.bounded( 100 ), QString() ), true );
+}
+
+SourceChange
+TestChannelViewSortModel::update( const ChannelViewWindowModel & model,
+	int row )
+{
+	return update( model, row, m_random.bounded( 100 ) );
+}
+
+SourceChange
+TestChannelViewSortModel::update( const ChannelViewWindowModel & model,
+	int row, int value )
+{
+	Como::Source s = model.source( model.index( row, 0 ) );
+	s.setValue( value );
+
+	return { s, true };
+}
+
+void
+TestChannelViewSortModel::insert()
+{
+	ChannelViewWindowModel model;
+	ChannelViewSortModel proxy( &model );
+
+	proxy.sort( valueColumn, Qt::AscendingOrder );
+
+	for( int i = 0; i < sourcesCount; ++i )
+	{
+		model.addItem( Como::Source( Como::Source::Int,
+			QString( "source_%1" ).arg( i ), QLatin1String( "type" ),
+			m_random.bounded( 100 ), QString() ), true );
+
+		checkOrder( model, proxy );
+	}
+
+	proxy.sort( valueColumn, Qt::DescendingOrder );
+
+	checkOrder( model, proxy );
+
+	proxy.sort( sourceNameColumn, Qt::AscendingOrder );
+
+	checkOrder( model, proxy );
+}
+
+void
+TestChannelViewSortModel::move()
+{
+	ChannelViewWindowModel model;
+	ChannelViewSortModel proxy( &model );
+
+	fill( model );
+
+	proxy.sort( valueColumn, Qt::DescendingOrder );
+
+	checkOrder( model, proxy );
+
+	// One changed row at a time.
+	for( int i = 0; i < 100; ++i )
+	{
+		model.setData( model.index( m_random.bounded( sourcesCount ),
+			valueColumn ), m_random.bounded( 100 ), Qt::DisplayRole );
+
+		processChanges();
+
+		checkOrder( model, proxy );
+	}
+
+	// Many changed rows at once.
+	for( int i = 0; i < 10; ++i )
+	{
+		for( int j = 0; j < 30; ++j )
+			model.setData( model.index( m_random.bounded( sourcesCount ),
+				valueColumn ), m_random.bounded( 100 ), Qt::DisplayRole );
+
+		processChanges();
+
+		checkOrder( model, proxy );
+	}
+}
+
+void
+TestChannelViewSortModel::filter()
+{
+	ChannelViewWindowModel model;
+	ChannelViewSortModel proxy( &model );
+
+	fill( model );
+
+	proxy.sort( valueColumn, Qt::AscendingOrder );
+
+	proxy.setFilterText( QLatin1String( "1" ) );
+	checkOrder( model, proxy );
+
+	proxy.setFilterText( QLatin1String( "12" ) );
+	checkOrder( model, proxy );
+
+	proxy.setFilterText( QLatin1String( "2" ) );
+	checkOrder( model, proxy );
+
+	proxy.setFilterText( QLatin1String( "TYPE_3" ) );
+	checkOrder( model, proxy );
+
+	proxy.setFilterText( QString() );
+	checkOrder( model, proxy );
+	QCOMPARE( proxy.rowCount(), sourcesCount );
+}
+
+void
+TestChannelViewSortModel::filterWithPendingChanges()
+{
+	ChannelViewWindowModel model;
+	ChannelViewSortModel proxy( &model );
+
+	fill( model );
+
+	proxy.sort( valueColumn, Qt::AscendingOrder );
+
+	proxy.setFilterText( QLatin1String( "source_1" ) );
+	checkOrder( model, proxy );
+
+	for( int i = 0; i < 20; ++i )
+	{
+		// Rows in the proxy and out of it change, filter is widened
+		// before the changes are applied.
+		for( int j = 0; j < 20; ++j )
+			model.setData( model.index( m_random.bounded( sourcesCount ),
+				valueColumn ), m_random.bounded( 100 ), Qt::DisplayRole );
+
+		proxy.setFilterText( QLatin1String( "source_" ) );
+		checkOrder( model, proxy );
+
+		processChanges();
+		checkOrder( model, proxy );
+
+		for( int j = 0; j < 20; ++j )
+			model.setData( model.index( m_random.bounded( sourcesCount ),
+				valueColumn ), m_random.bounded( 100 ), Qt::DisplayRole );
+
+		proxy.setFilterText( QLatin1String( "source_1" ) );
+		checkOrder( model, proxy );
+
+		processChanges();
+		checkOrder( model, proxy );
+	}
+}
+
+void
+TestChannelViewSortModel::sourcesUpdates()
+{
+	ChannelViewWindowModel model;
+	ChannelViewSortModel proxy( &model );
+
+	fill( model );
+
+	proxy.sort( valueColumn, Qt::AscendingOrder );
+
+	QSignalSpy flushed( &model, &ChannelViewWindowModel::changesFlushed );
+
+	// One updated source per flush.
+	for( int i = 0; i < 20; ++i )
+	{
+		model.sourcesChanged( model.channelName(),
+			{ update( model, m_random.bounded( sourcesCount ) ) } );
+
+		QVERIFY( flushed.wait() );
+
+		checkOrder( model, proxy );
+	}
+
+	// Contiguous rows are flushed as one range, scattered ones as
+	// separate ranges.
+	for( int i = 0; i < 20; ++i )
+	{
+		QList< SourceChange > changes;
+
+		const int first = m_random.bounded( sourcesCount - 20 );
+
+		for( int row = first; row < first + 20; ++row )
+			changes.append( update( model, row ) );
+
+		for( int j = 0; j < 5; ++j )
+			changes.append( update( model, m_random.bounded( sourcesCount ) ) );
+
+		model.sourcesChanged( model.channelName(), changes );
+
+		QVERIFY( flushed.wait() );
+
+		checkOrder( model, proxy );
+	}
+}
+
+void
+TestChannelViewSortModel::levelFilter()
+{
+	ChannelViewWindowModel model;
+	ChannelViewSortModel proxy( &model );
+
+	// Every fifth source has no properties and so None level.
+	for( int i = 0; i < sourcesCount; ++i )
+		model.addItem( Como::Source( Como::Source::Int,
+			QString( "source_%1" ).arg( i ),
+			( i % 5 ? levelTypeName : QString( "type" ) ),
+			m_random.bounded( 100 ), QString() ), true );
+
+	proxy.sort( valueColumn, Qt::DescendingOrder );
+
+	QSignalSpy flushed( &model, &ChannelViewWindowModel::changesFlushed );
+
+	static const Level filters[] = { None, Debug, Warning, Error, Critical };
+
+	for( const Level filter : filters )
+	{
+		proxy.setLevelFilter( filter );
+		QCOMPARE( proxy.levelFilter(), filter );
+		checkOrder( model, proxy );
+
+		for( int i = 0; i < 10; ++i )
+		{
+			QList< SourceChange > changes;
+
+			for( int j = 0; j < 20; ++j )
+				changes.append( update( model, m_random.bounded( sourcesCount ) ) );
+
+			model.sourcesChanged( model.channelName(), changes );
+
+			QVERIFY( flushed.wait() );
+
+			checkOrder( model, proxy );
+		}
+	}
+
+	// Info rows become warnings and come into the filter, warnings become
+	// info and go out.
+	proxy.setLevelFilter( Warning );
+	checkOrder( model, proxy );
+
+	for( int i = 0; i < 20; ++i )
+	{
+		const int row = m_random.bounded( sourcesCount / 5 ) * 5 + 1;
+		const QModelIndex index = model.index( row, 0 );
+		const bool wasInfo = ( model.level( index ) == Info );
+
+		model.sourcesChanged( model.channelName(),
+			{ update( model, row, ( wasInfo ? 50 : 90 ) ) } );
+
+		QVERIFY( flushed.wait() );
+
+		QCOMPARE( model.level( index ), ( wasInfo ? Warning : Info ) );
+		QCOMPARE( proxy.mapFromSource( index ).isValid(), wasInfo );
+
+		checkOrder( model, proxy );
+	}
+}
+
+
+QTEST_MAIN( TestChannelViewSortModel )
+
+#include "main.moc"